@@ -0,0 +1,520 @@
+/*******************************************************************************************
+*
+*   raylib-physfs-bench - Measures the throughput and latency of raylib-physfs load paths
+*
+*   Generates synthetic trees of many tiny files, a few huge files, images and waves, packs them
+*   into stored and deflated ZIP archives and a .rpak pack, and loads them back through directory,
+*   archive and MountPhysFSFromMemory() mounts. Lookups are also measured among many archives
+*   mounted at once, with and without SetPhysFSIndexing(), and through GetPhysFSPathId(). Packs
+*   of 10k, 100k and 1M entries are mounted to measure the time it takes and the memory their
+*   tables take per entry. raylib's own loaders are measured on the same files as a baseline.
+*   Results are printed as one JSON object per line, to compare across builds.
+*
+*   Usage: raylib-physfs-bench [--quick] [--iterations <count>]
+*
+*   This benchmark has been created using raylib-physfs 0.0.2 (https://github.com/RobLoach/raylib-physfs)
+*   raylib-physfs is licensed under an unmodified zlib/libpng license (View raylib-physfs.h for details)
+*
+*   Copyright (c) 2021 Rob Loach (@RobLoach)
+*
+********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "raylib.h"
+
+#define RAYLIB_PHYSFS_IMPLEMENTATION
+#include "raylib-physfs.h"
+
+#define BENCH_DIR "raylib-physfs-bench-data"
+#define BENCH_MOUNT "bench"
+#define MOD_COUNT 32
+
+static int tinyCount = 1000;
+static int tinySize = 1024;
+static int hugeCount = 4;
+static int hugeSize = 16 * 1024 * 1024;
+static int imageCount = 8;
+static int waveCount = 8;
+static int iterations = 3;
+static int packEntryCounts[] = { 10000, 100000, 1000000 };
+static int packEntryCountCount = 3;
+
+static double* samples = 0;
+static int sampleCount = 0;
+static int sampleCapacity = 0;
+
+/**
+ * Records the latency of one operation, in milliseconds.
+ */
+static void AddSample(double milliseconds) {
+    if (sampleCount == sampleCapacity) {
+        sampleCapacity = sampleCapacity == 0 ? 1024 : sampleCapacity * 2;
+        samples = (double*)MemRealloc(samples, sizeof(double) * sampleCapacity);
+    }
+    samples[sampleCount++] = milliseconds;
+}
+
+static int CompareSamples(const void* a, const void* b) {
+    double difference = *(const double*)a - *(const double*)b;
+    return difference < 0 ? -1 : (difference > 0 ? 1 : 0);
+}
+
+/**
+ * Gets the given percentile of the recorded latencies, in microseconds. Requires sorted samples.
+ */
+static double GetPercentile(double percentile) {
+    int index = (int)(percentile / 100.0 * (sampleCount - 1) + 0.5);
+    return samples[index] * 1000.0;
+}
+
+/**
+ * Prints the recorded latencies of an operation as a JSON object, and clears them.
+ */
+static void Report(const char* operation, const char* mount, const char* set, long long bytes) {
+    if (sampleCount == 0) {
+        return;
+    }
+
+    double total = 0.0;
+    for (int i = 0; i < sampleCount; i++) {
+        total += samples[i];
+    }
+    double seconds = total / 1000.0;
+    qsort(samples, sampleCount, sizeof(double), CompareSamples);
+
+    printf("{\"operation\":\"%s\",\"mount\":\"%s\",\"set\":\"%s\",\"ops\":%i,\"bytes\":%lld,\"seconds\":%.6f,"
+        "\"ops_per_second\":%.1f,\"mb_per_second\":%.2f,\"p50_us\":%.2f,\"p90_us\":%.2f,\"p99_us\":%.2f,\"max_us\":%.2f}\n",
+        operation, mount, set, sampleCount, bytes, seconds,
+        seconds > 0.0 ? sampleCount / seconds : 0.0,
+        seconds > 0.0 ? (double)bytes / (1024.0 * 1024.0) / seconds : 0.0,
+        GetPercentile(50.0), GetPercentile(90.0), GetPercentile(99.0), samples[sampleCount - 1] * 1000.0);
+    fflush(stdout);
+    sampleCount = 0;
+}
+
+static void WriteUInt(unsigned char* data, unsigned int value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        data[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+/**
+ * Fills a buffer with data that compresses about as well as typical game data.
+ */
+static void FillData(unsigned char* data, int size, unsigned int seed) {
+    for (int i = 0; i < size; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        data[i] = (i % 64 < 48) ? (unsigned char)(i / 64) : (unsigned char)(seed >> 24);
+    }
+}
+
+/**
+ * Writes the synthetic files to the given directory in the write directory.
+ */
+static bool GenerateTree(const char* dirPath) {
+    PHYSFS_mkdir(TextFormat("%s/tiny", dirPath));
+    PHYSFS_mkdir(TextFormat("%s/huge", dirPath));
+    PHYSFS_mkdir(TextFormat("%s/images", dirPath));
+    PHYSFS_mkdir(TextFormat("%s/waves", dirPath));
+
+    unsigned char* data = (unsigned char*)MemAlloc(hugeSize > tinySize ? hugeSize : tinySize);
+    bool success = data != 0;
+    for (int i = 0; success && i < tinyCount; i++) {
+        FillData(data, tinySize, (unsigned int)i);
+        success = SaveFileDataToPhysFS(TextFormat("%s/tiny/%05i.bin", dirPath, i), data, tinySize);
+    }
+    for (int i = 0; success && i < hugeCount; i++) {
+        FillData(data, hugeSize, (unsigned int)i);
+        success = SaveFileDataToPhysFS(TextFormat("%s/huge/%02i.bin", dirPath, i), data, hugeSize);
+    }
+    MemFree(data);
+
+    for (int i = 0; success && i < imageCount; i++) {
+        Image image = GenImageChecked(512, 512, 8 + i, 8 + i, RED, DARKBLUE);
+        success = ExportImageToPhysFS(image, TextFormat("%s/images/%02i.png", dirPath, i));
+        UnloadImage(image);
+    }
+
+    // One second of 16-bit stereo audio.
+    int frameCount = 44100;
+    int waveSize = 44 + frameCount * 4;
+    unsigned char* wave = (unsigned char*)MemAlloc(waveSize);
+    success = success && wave != 0;
+    if (success) {
+        const char* header = "RIFF____WAVEfmt ";
+        for (int i = 0; i < 16; i++) {
+            wave[i] = (unsigned char)header[i];
+        }
+        WriteUInt(wave + 4, waveSize - 8, 4);
+        WriteUInt(wave + 16, 16, 4);
+        WriteUInt(wave + 20, 1, 2);
+        WriteUInt(wave + 22, 2, 2);
+        WriteUInt(wave + 24, 44100, 4);
+        WriteUInt(wave + 28, 44100 * 4, 4);
+        WriteUInt(wave + 32, 4, 2);
+        WriteUInt(wave + 34, 16, 2);
+        wave[36] = 'd';
+        wave[37] = 'a';
+        wave[38] = 't';
+        wave[39] = 'a';
+        WriteUInt(wave + 40, frameCount * 4, 4);
+        FillData(wave + 44, frameCount * 4, 1);
+    }
+    for (int i = 0; success && i < waveCount; i++) {
+        success = SaveFileDataToPhysFS(TextFormat("%s/waves/%02i.wav", dirPath, i), wave, waveSize);
+    }
+    MemFree(wave);
+    return success;
+}
+
+/**
+ * Measures raylib's own loaders on the generated files, as a baseline.
+ */
+static void BenchNative(const char* dirPath) {
+    long long bytes = 0;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (int i = 0; i < tinyCount; i++) {
+            int size = 0;
+            double start = GetPhysFSTime();
+            unsigned char* data = LoadFileData(TextFormat("%s/tiny/%05i.bin", dirPath, i), &size);
+            AddSample(GetPhysFSTime() - start);
+            UnloadFileData(data);
+            bytes += size;
+        }
+    }
+    Report("LoadFileData", "native", "tiny", bytes);
+
+    bytes = 0;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (int i = 0; i < hugeCount; i++) {
+            int size = 0;
+            double start = GetPhysFSTime();
+            unsigned char* data = LoadFileData(TextFormat("%s/huge/%02i.bin", dirPath, i), &size);
+            AddSample(GetPhysFSTime() - start);
+            UnloadFileData(data);
+            bytes += size;
+        }
+    }
+    Report("LoadFileData", "native", "huge", bytes);
+
+    bytes = 0;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (int i = 0; i < imageCount; i++) {
+            const char* fileName = TextFormat("%s/images/%02i.png", dirPath, i);
+            double start = GetPhysFSTime();
+            Image image = LoadImage(fileName);
+            AddSample(GetPhysFSTime() - start);
+            UnloadImage(image);
+            bytes += GetFileLength(fileName);
+        }
+    }
+    Report("LoadImage", "native", "images", bytes);
+
+    bytes = 0;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (int i = 0; i < waveCount; i++) {
+            const char* fileName = TextFormat("%s/waves/%02i.wav", dirPath, i);
+            double start = GetPhysFSTime();
+            Wave wave = LoadWave(fileName);
+            AddSample(GetPhysFSTime() - start);
+            UnloadWave(wave);
+            bytes += GetFileLength(fileName);
+        }
+    }
+    Report("LoadWave", "native", "waves", bytes);
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (int i = 0; i < tinyCount; i++) {
+            double start = GetPhysFSTime();
+            FileExists(TextFormat("%s/tiny/%05i.%s", dirPath, i, i % 2 == 0 ? "bin" : "missing"));
+            AddSample(GetPhysFSTime() - start);
+        }
+    }
+    Report("FileExists", "native", "tiny", 0);
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        double start = GetPhysFSTime();
+        FilePathList files = LoadDirectoryFiles(TextFormat("%s/tiny", dirPath));
+        AddSample(GetPhysFSTime() - start);
+        UnloadDirectoryFiles(files);
+    }
+    Report("LoadDirectoryFiles", "native", "tiny", 0);
+}
+
+/**
+ * Measures looking up files on whatever is mounted at BENCH_MOUNT.
+ */
+static void BenchLookups(const char* mount) {
+    // Half of the lookups are for files that don't exist.
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (int i = 0; i < tinyCount; i++) {
+            const char* fileName = TextFormat(BENCH_MOUNT "/tiny/%05i.%s", i, i % 2 == 0 ? "bin" : "missing");
+            double start = GetPhysFSTime();
+            FileExistsInPhysFS(fileName);
+            AddSample(GetPhysFSTime() - start);
+        }
+    }
+    Report("FileExistsInPhysFS", mount, "tiny", 0);
+
+    // The same lookups through interned paths, as a streaming system issues them each frame.
+    int* pathIds = (int*)MemAlloc(sizeof(int) * tinyCount);
+    if (pathIds == 0) {
+        return;
+    }
+    for (int i = 0; i < tinyCount; i++) {
+        pathIds[i] = GetPhysFSPathId(TextFormat(BENCH_MOUNT "/tiny/%05i.%s", i, i % 2 == 0 ? "bin" : "missing"));
+    }
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (int i = 0; i < tinyCount; i++) {
+            double start = GetPhysFSTime();
+            FileExistsInPhysFSById(pathIds[i]);
+            AddSample(GetPhysFSTime() - start);
+        }
+    }
+    Report("FileExistsInPhysFSById", mount, "tiny", 0);
+    MemFree(pathIds);
+}
+
+/**
+ * Measures the PhysFS loaders on whatever is mounted at BENCH_MOUNT.
+ */
+static void BenchMount(const char* mount) {
+    long long bytes = 0;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (int i = 0; i < tinyCount; i++) {
+            int size = 0;
+            double start = GetPhysFSTime();
+            unsigned char* data = LoadFileDataFromPhysFS(TextFormat(BENCH_MOUNT "/tiny/%05i.bin", i), &size);
+            AddSample(GetPhysFSTime() - start);
+            UnloadFileDataFromPhysFS(data);
+            bytes += size;
+        }
+    }
+    Report("LoadFileDataFromPhysFS", mount, "tiny", bytes);
+
+    bytes = 0;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (int i = 0; i < hugeCount; i++) {
+            int size = 0;
+            double start = GetPhysFSTime();
+            unsigned char* data = LoadFileDataFromPhysFS(TextFormat(BENCH_MOUNT "/huge/%02i.bin", i), &size);
+            AddSample(GetPhysFSTime() - start);
+            UnloadFileDataFromPhysFS(data);
+            bytes += size;
+        }
+    }
+    Report("LoadFileDataFromPhysFS", mount, "huge", bytes);
+
+    bytes = 0;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (int i = 0; i < imageCount; i++) {
+            const char* fileName = TextFormat(BENCH_MOUNT "/images/%02i.png", i);
+            double start = GetPhysFSTime();
+            Image image = LoadImageFromPhysFS(fileName);
+            AddSample(GetPhysFSTime() - start);
+            UnloadImage(image);
+            bytes += GetPhysFSFileLength(fileName);
+        }
+    }
+    Report("LoadImageFromPhysFS", mount, "images", bytes);
+
+    bytes = 0;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (int i = 0; i < waveCount; i++) {
+            const char* fileName = TextFormat(BENCH_MOUNT "/waves/%02i.wav", i);
+            double start = GetPhysFSTime();
+            Wave wave = LoadWaveFromPhysFS(fileName);
+            AddSample(GetPhysFSTime() - start);
+            UnloadWave(wave);
+            bytes += GetPhysFSFileLength(fileName);
+        }
+    }
+    Report("LoadWaveFromPhysFS", mount, "waves", bytes);
+
+    BenchLookups(mount);
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        double start = GetPhysFSTime();
+        FilePathList files = LoadDirectoryFilesFromPhysFS(BENCH_MOUNT "/tiny");
+        AddSample(GetPhysFSTime() - start);
+        UnloadDirectoryFilesFromPhysFS(files);
+    }
+    Report("LoadDirectoryFilesFromPhysFS", mount, "tiny", 0);
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        double start = GetPhysFSTime();
+        PhysFSFileInfoList files = LoadDirectoryFilesFromPhysFSEx(BENCH_MOUNT, 0, true);
+        AddSample(GetPhysFSTime() - start);
+        UnloadDirectoryFilesFromPhysFSEx(files);
+    }
+    Report("LoadDirectoryFilesFromPhysFSEx", mount, "all", 0);
+}
+
+/**
+ * Writes a pack of the given amount of empty entries, a hundred to a directory, straight through the pack writer.
+ */
+static bool GeneratePack(const char* fileName, int count) {
+    PhysFSPackEntry* entries = (PhysFSPackEntry*)MemAlloc(sizeof(PhysFSPackEntry) * count);
+    const char** paths = (const char**)MemAlloc(sizeof(const char*) * count);
+    char* names = (char*)MemAlloc(32 * count);
+    bool success = entries != 0 && paths != 0 && names != 0;
+    unsigned int stringsSize = 0;
+    for (int i = 0; success && i < count; i++) {
+        char* name = names + 32 * i;
+        snprintf(name, 32, "%03i/%03i/%07i.bin", i / 10000, i / 100 % 100, i);
+        paths[i] = name;
+        entries[i].offset = PHYSFS_PACK_HEADER_SIZE;
+        entries[i].nameOffset = stringsSize;
+        entries[i].codec = PHYSFS_PACK_CODEC_STORED;
+        stringsSize += TextLength(name) + 1;
+    }
+
+    PHYSFS_File* file = success ? PHYSFS_openWrite(fileName) : 0;
+    success = file != 0 && WritePhysFSPadding(file, PHYSFS_PACK_HEADER_SIZE) &&
+        WritePhysFSPackIndex(file, paths, entries, count, PHYSFS_PACK_HEADER_SIZE);
+    if (file != 0) {
+        success = PHYSFS_close(file) != 0 && success;
+    }
+    MemFree(entries);
+    MemFree(paths);
+    MemFree(names);
+    return success;
+}
+
+/**
+ * Measures mounting packs of many entries, and the memory their tables take.
+ */
+static void BenchPackEntries(void) {
+    for (int i = 0; i < packEntryCountCount; i++) {
+        int count = packEntryCounts[i];
+        char set[32];
+        char fileName[64];
+        snprintf(set, sizeof(set), "entries-%i", count);
+        snprintf(fileName, sizeof(fileName), BENCH_DIR "/entries-%i.rpak", count);
+        if (!GeneratePack(fileName, count)) {
+            TraceLog(LOG_ERROR, "BENCH: Failed to generate '%s'", fileName);
+            continue;
+        }
+
+        long long tableSize = 0;
+        for (int iteration = 0; iteration < iterations; iteration++) {
+            double start = GetPhysFSTime();
+            bool mounted = MountPhysFS(fileName, BENCH_MOUNT);
+            AddSample(GetPhysFSTime() - start);
+            if (!mounted) {
+                break;
+            }
+
+            // The last pack mounted is the first one tracked.
+            tableSize = GetPhysFSPackTableSize(physfsPacks);
+            UnmountPhysFS(fileName);
+        }
+        Report("MountPhysFS", "rpak", set, 0);
+
+        if (MountPhysFS(fileName, BENCH_MOUNT)) {
+            for (int iteration = 0; iteration < iterations; iteration++) {
+                // Directories spread across the pack, a hundred entries each.
+                for (int j = 0; j < 100; j++) {
+                    int entry = j * (count / 100);
+                    const char* dirPath = TextFormat(BENCH_MOUNT "/%03i/%03i", entry / 10000, entry / 100 % 100);
+                    double start = GetPhysFSTime();
+                    FilePathList files = LoadDirectoryFilesFromPhysFS(dirPath);
+                    AddSample(GetPhysFSTime() - start);
+                    UnloadDirectoryFilesFromPhysFS(files);
+                }
+            }
+            Report("LoadDirectoryFilesFromPhysFS", "rpak", set, 0);
+            UnmountPhysFS(fileName);
+        }
+        printf("{\"operation\":\"PackTables\",\"mount\":\"rpak\",\"set\":\"%s\",\"entries\":%i,\"bytes\":%lld,\"bytes_per_entry\":%.1f}\n",
+            set, count, tableSize, (double)tableSize / count);
+        fflush(stdout);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (TextIsEqual(argv[i], "--quick")) {
+            tinyCount = 200;
+            hugeCount = 2;
+            hugeSize = 1024 * 1024;
+            imageCount = 2;
+            waveCount = 2;
+            iterations = 1;
+            packEntryCountCount = 2;
+        } else if (TextIsEqual(argv[i], "--iterations") && i + 1 < argc) {
+            iterations = TextToInteger(argv[++i]);
+        } else {
+            printf("Usage: raylib-physfs-bench [--quick] [--iterations <count>]\n");
+            return 1;
+        }
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    if (!InitPhysFS()) {
+        return 1;
+    }
+
+    // Generate the files, and pack them up.
+    if (!GenerateTree(BENCH_DIR "/tree") ||
+        !MountPhysFS(BENCH_DIR "/tree", "generated") ||
+        !ExportPhysFSPackEx("generated", BENCH_DIR "/stored.zip", ".bin;.png;.wav") ||
+        !ExportPhysFSPackEx("generated", BENCH_DIR "/deflated.zip", 0) ||
+        !ExportPhysFSPackEx("generated", BENCH_DIR "/deflated.rpak", 0) ||
+        !UnmountPhysFS(BENCH_DIR "/tree")) {
+        TraceLog(LOG_ERROR, "BENCH: Failed to generate the files in '%s'", BENCH_DIR);
+        ClosePhysFS();
+        return 1;
+    }
+
+    BenchNative(BENCH_DIR "/tree");
+
+    const char* archives[][2] = {
+        { BENCH_DIR "/tree", "directory" },
+        { BENCH_DIR "/stored.zip", "zip-stored" },
+        { BENCH_DIR "/deflated.zip", "zip-deflated" },
+        { BENCH_DIR "/deflated.rpak", "rpak-deflated" },
+    };
+    for (int i = 0; i < (int)(sizeof(archives) / sizeof(archives[0])); i++) {
+        if (MountPhysFS(archives[i][0], BENCH_MOUNT)) {
+            BenchMount(archives[i][1]);
+            UnmountPhysFS(archives[i][0]);
+        }
+    }
+
+    // Memory mounts keep the archive in memory until unmounted.
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(BENCH_DIR "/deflated.zip", &dataSize);
+    if (data != 0 && MountPhysFSFromMemory(data, dataSize, "deflated.zip", BENCH_MOUNT)) {
+        BenchMount("memory-deflated");
+        UnmountPhysFS("deflated.zip");
+    }
+
+    // Many archives at the same mount point, like a game with mods, are each probed by lookups without the index.
+    if (data != 0) {
+        for (int i = 0; i < MOD_COUNT; i++) {
+            MountPhysFSFromMemory(data, dataSize, TextFormat("mod-%02i.zip", i), BENCH_MOUNT);
+        }
+        BenchLookups("mods");
+
+        double start = GetPhysFSTime();
+        SetPhysFSIndexing(true);
+        AddSample(GetPhysFSTime() - start);
+        Report("SetPhysFSIndexing", "mods", "all", 0);
+        BenchLookups("mods-indexed");
+        SetPhysFSIndexing(false);
+
+        for (int i = 0; i < MOD_COUNT; i++) {
+            UnmountPhysFS(TextFormat("mod-%02i.zip", i));
+        }
+    }
+    UnloadFileData(data);
+
+    BenchPackEntries();
+
+    MemFree(samples);
+    ClosePhysFS();
+    return 0;
+}
@@ -31,6 +31,9 @@ int main(void)
 
     Music music = LoadMusicStreamFromPhysFS("res/country.mp3");
 
+    // Decode the music on a background thread, rather than in the game loop.
+    SetPhysFSMusicThread(true);
+
     PlayMusicStream(music);
 
     float timePlayed = 0.0f;
@@ -44,12 +47,12 @@ int main(void)
     {
         // Update
         //----------------------------------------------------------------------------------
-        UpdateMusicStream(music);   // Update music buffer with new stream data
+        UpdateMusicStreamFromPhysFS(music);   // Update music buffer with new stream data (done by the music thread)
 
         // Restart music playing (stop and play)
         if (IsKeyPressed(KEY_SPACE))
         {
-            StopMusicStream(music);
+            StopMusicStreamFromPhysFS(music);
             PlayMusicStream(music);
         }
 
@@ -65,7 +68,7 @@ int main(void)
         // Get timePlayed scaled to bar dimensions (400 pixels)
         timePlayed = GetMusicTimePlayed(music)/GetMusicTimeLength(music)*400;
 
-        if (timePlayed > 400) StopMusicStream(music);
+        if (timePlayed > 400) StopMusicStreamFromPhysFS(music);
         //----------------------------------------------------------------------------------
 
         // Draw
@@ -89,7 +92,7 @@ int main(void)
 
     // De-Initialization
     //--------------------------------------------------------------------------------------
-    UnloadMusicStream(music);   // Unload music stream buffers from RAM
+    UnloadMusicStreamFromPhysFS(music);   // Unload music stream buffers, and its file data
 
     CloseAudioDevice();         // Close audio device (music streaming is automatically stopped)
 
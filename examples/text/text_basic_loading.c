@@ -55,7 +55,7 @@ int main(void)
 
     // De-Initialization
     //--------------------------------------------------------------------------------------
-    UnloadFileText(text);
+    UnloadFileTextFromPhysFS(text);
 
     ClosePhysFS();
     CloseWindow();                // Close window and OpenGL context
@@ -45,28 +45,287 @@ extern "C" {
 #endif
 #endif
 
+/**
+ * A read-only view of a file's contents, from MapFileViewFromPhysFS().
+ *
+ * @see MapFileViewFromPhysFS()
+ * @see UnmapFileView()
+ */
+typedef struct FileView {
+    const unsigned char* data;          // Read-only file contents
+    int size;                           // Size of the file contents in bytes
+    void* mapping;                      // Base address of the memory mapping, 0 when the contents were copied
+    unsigned long long mappingSize;     // Size of the memory mapping in bytes
+    int cacheEntry;                     // The cache entry the view reads from (index + 1), 0 when not from the cache
+} FileView;
+
+/**
+ * Counters for the file data cache, from GetPhysFSCacheStats().
+ *
+ * @see SetPhysFSCacheSize()
+ */
+typedef struct PhysFSCacheStats {
+    unsigned int hits;                  // Loads served from the cache
+    unsigned int misses;                // Loads that had to read the file
+    unsigned int evictions;             // Files evicted to stay within the cache size
+    int count;                          // Files in the cache
+    long long size;                     // Bytes in the cache
+    long long capacity;                 // Maximum bytes in the cache, 0 when disabled
+} PhysFSCacheStats;
+
+/**
+ * Progress of the assets loading through UpdatePhysFSLoader(), from GetPhysFSLoaderProgress().
+ *
+ * @see UpdatePhysFSLoader()
+ */
+typedef struct PhysFSLoaderProgress {
+    int assetCount;                     // Assets in all asset groups
+    int loadedCount;                    // Assets that have loaded
+    int failedCount;                    // Assets that failed to load
+    long long bytesLoaded;              // File bytes read for the loaded assets
+} PhysFSLoaderProgress;
+
+#ifndef RAYLIB_PHYSFS_STATS_MOUNTS
+/**
+ * The most mounts that GetPhysFSStats() keeps separate counters for.
+ */
+#define RAYLIB_PHYSFS_STATS_MOUNTS 16
+#endif
+
+#ifndef RAYLIB_PHYSFS_STATS_SLOWEST
+/**
+ * How many of the slowest loads GetPhysFSStats() keeps.
+ */
+#define RAYLIB_PHYSFS_STATS_SLOWEST 8
+#endif
+
+/**
+ * The amount of buckets in the latency histograms. Bucket 0 counts calls under a microsecond, bucket
+ * i counts calls under 2^i microseconds, and the last bucket counts everything slower.
+ */
+#define PHYSFS_STATS_HISTOGRAM_SIZE 20
+
+/**
+ * The APIs that GetPhysFSStats() counts calls to.
+ */
+typedef enum {
+    PHYSFS_STATS_LOAD_FILE_DATA = 0,    // LoadFileDataFromPhysFS()
+    PHYSFS_STATS_MAP_FILE_VIEW,         // MapFileViewFromPhysFS()
+    PHYSFS_STATS_SAVE_FILE_DATA,        // SaveFileDataToPhysFS()
+    PHYSFS_STATS_LOAD_IMAGE,            // LoadImageFromPhysFS()
+    PHYSFS_STATS_LOAD_WAVE,             // LoadWaveFromPhysFS()
+    PHYSFS_STATS_LOAD_MUSIC,            // LoadMusicStreamFromPhysFS()
+    PHYSFS_STATS_LOAD_FONT,             // LoadFontFromPhysFS()
+    PHYSFS_STATS_LOAD_SHADER,           // LoadShaderFromPhysFS()
+    PHYSFS_STATS_FILE_EXISTS,           // FileExistsInPhysFS()
+    PHYSFS_STATS_LOAD_FILE_TEXT,        // LoadFileTextFromPhysFS()
+    PHYSFS_STATS_LOAD_DIRECTORY_FILES,  // LoadDirectoryFilesFromPhysFS()
+    PHYSFS_STATS_API_COUNT
+} PhysFSStatsApi;
+
+/**
+ * The phases that GetPhysFSStats() splits the time of each call into.
+ */
+typedef enum {
+    PHYSFS_STATS_OPEN = 0,              // Finding and opening the file
+    PHYSFS_STATS_READ,                  // Reading or writing the file
+    PHYSFS_STATS_DECODE,                // Decoding the file into an image, wave, font, shader or music
+    PHYSFS_STATS_PHASE_COUNT
+} PhysFSStatsPhase;
+
+/**
+ * Counters of calls, from GetPhysFSStats().
+ */
+typedef struct PhysFSStatsCounters {
+    unsigned long long calls;           // Calls made
+    unsigned long long failures;        // Calls that failed
+    unsigned long long bytesRead;       // Bytes read from files
+    unsigned long long bytesWritten;    // Bytes written to files
+    double milliseconds[PHYSFS_STATS_PHASE_COUNT];  // Cumulative time spent in each phase
+    unsigned int histogram[PHYSFS_STATS_PHASE_COUNT][PHYSFS_STATS_HISTOGRAM_SIZE];  // Calls by the time spent in each phase
+} PhysFSStatsCounters;
+
+/**
+ * Counters of the file reads and writes through a mounted directory or archive, from GetPhysFSStats().
+ */
+typedef struct PhysFSMountStats {
+    char mount[256];                    // The directory or archive, as it was mounted
+    PhysFSStatsCounters counters;
+} PhysFSMountStats;
+
+/**
+ * One of the slowest calls, from GetPhysFSStats().
+ */
+typedef struct PhysFSSlowCall {
+    char fileName[256];                 // The file that was loaded
+    PhysFSStatsApi api;                 // The API it was loaded with
+    double milliseconds;                // The time the call took
+} PhysFSSlowCall;
+
+/**
+ * Statistics of the I/O through raylib-physfs, from GetPhysFSStats(). Requires RAYLIB_PHYSFS_STATS.
+ *
+ * @see GetPhysFSStats()
+ */
+typedef struct PhysFSStats {
+    PhysFSStatsCounters apis[PHYSFS_STATS_API_COUNT];       // Counters for each API
+    PhysFSMountStats mounts[RAYLIB_PHYSFS_STATS_MOUNTS];    // Counters for each mount that files were written to, or read from while indexing
+    int mountCount;
+    PhysFSSlowCall slowest[RAYLIB_PHYSFS_STATS_SLOWEST];    // The slowest calls, slowest first
+    int slowestCount;
+} PhysFSStats;
+
+#ifndef RAYLIB_PHYSFS_TRACE_EVENTS
+/**
+ * How many calls each thread keeps for ExportPhysFSTrace(), overwriting the oldest first.
+ */
+#define RAYLIB_PHYSFS_TRACE_EVENTS 4096
+#endif
+
+/**
+ * A read request, recorded with SetPhysFSIORecording().
+ */
+typedef struct PhysFSIORequest {
+    double time;                        // When the request was made, in milliseconds since recording started
+    double milliseconds;                // How long the request took
+    long long offset;                   // Where the read started in the file
+    long long size;                     // The bytes read
+    int path;                           // The file, as an index into the recording's paths
+    PhysFSStatsApi api;                 // Either PHYSFS_STATS_LOAD_FILE_DATA or PHYSFS_STATS_MAP_FILE_VIEW
+    bool failed;                        // Whether the request failed
+} PhysFSIORequest;
+
+/**
+ * The read requests recorded with SetPhysFSIORecording(), from LoadPhysFSIORecording().
+ *
+ * @see LoadPhysFSIORecording()
+ */
+typedef struct PhysFSIORecording {
+    char** paths;                       // The files that were read
+    int pathCount;
+    PhysFSIORequest* requests;          // The requests, in the order they finished
+    int requestCount;
+} PhysFSIORecording;
+
+/**
+ * Memory held by file data, text and directory lists loaded from PhysFS, from GetPhysFSMemoryStats(). Requires RAYLIB_PHYSFS_TRACK_MEMORY.
+ *
+ * @see GetPhysFSMemoryStats()
+ */
+typedef struct PhysFSMemoryStats {
+    long long bytes;                    // Bytes currently loaded
+    long long peakBytes;                // The most bytes that were loaded at once
+    int buffers;                        // Buffers currently loaded
+    unsigned long long totalBuffers;    // Buffers loaded in total
+} PhysFSMemoryStats;
+
+/**
+ * A file or directory in PhysFS, listed with LoadDirectoryFilesFromPhysFSEx().
+ */
+typedef struct PhysFSFileInfo {
+    char* path;                         // The full path in PhysFS
+    long long size;                     // Size in bytes, 0 for directories
+    long modTime;                       // Last modification time, -1 if it isn't known
+    bool isDirectory;                   // Whether it's a directory
+} PhysFSFileInfo;
+
+/**
+ * Files and directories listed with LoadDirectoryFilesFromPhysFSEx().
+ *
+ * @see LoadDirectoryFilesFromPhysFSEx()
+ */
+typedef struct PhysFSFileInfoList {
+    unsigned int capacity;              // Files the list has room for
+    unsigned int count;                 // Files in the list
+    PhysFSFileInfo* files;              // The files, sorted by path
+} PhysFSFileInfoList;
+
 RAYLIB_PHYSFS_DEF bool InitPhysFS();                                              // Initialize the PhysFS file system
 RAYLIB_PHYSFS_DEF bool InitPhysFSEx(const char* newDir, const char* mountPoint);  // Initialize the PhysFS file system with a mount point.
 RAYLIB_PHYSFS_DEF bool ClosePhysFS();                                             // Close the PhysFS file system
 RAYLIB_PHYSFS_DEF bool IsPhysFSReady();                                           // Check if PhysFS has been initialized successfully
 RAYLIB_PHYSFS_DEF bool MountPhysFS(const char* newDir, const char* mountPoint);   // Mount the given directory or archive as a mount point
 RAYLIB_PHYSFS_DEF bool MountPhysFSFromMemory(const unsigned char *fileData, int dataSize, const char* newDir, const char* mountPoint);  // Mount the given file data as a mount point
+RAYLIB_PHYSFS_DEF bool MountPhysFSMapped(const char* newDir, const char* mountPoint, bool prefault);  // Memory map the given archive, and mount it as a mount point
+RAYLIB_PHYSFS_DEF bool MountPhysFSLazy(const char* newDir, const char* mountPoint);  // Register the given directory or archive, to be mounted once a path within its mount point is looked up
+RAYLIB_PHYSFS_DEF bool ExportPhysFSPack(const char* dirPath, const char* fileName);  // Pack the files in a directory into a pack or ZIP archive in the write directory, which mounts like any other archive
+RAYLIB_PHYSFS_DEF bool ExportPhysFSPackEx(const char* dirPath, const char* fileName, const char* storedExtensions);  // Pack the files in a directory, storing the given extensions (like ".ogg;.png") uncompressed
+RAYLIB_PHYSFS_DEF bool ExportPhysFSPackPro(const char* dirPath, const char* fileName, const char* storedExtensions, const char* accessOrder);  // Pack the files in a directory, storing the given extensions uncompressed, and laying files out in a recorded access order
 RAYLIB_PHYSFS_DEF bool UnmountPhysFS(const char* oldDir);                         // Unmounts the given directory
+RAYLIB_PHYSFS_DEF void SetPhysFSIndexing(bool enabled);                          // Set whether to index every mounted path, so that looking one up takes a single hash lookup (disabled by default)
+RAYLIB_PHYSFS_DEF void SetPhysFSIndexSnapshotDirectory(const char* dirPath);      // Set a directory to keep index snapshots of mounted archives in, like GetPerfDirectory(), so that remounting them skips walking them
 RAYLIB_PHYSFS_DEF bool FileExistsInPhysFS(const char* fileName);                  // Check if the given file exists in PhysFS
 RAYLIB_PHYSFS_DEF bool DirectoryExistsInPhysFS(const char* dirPath);              // Check if the given directory exists in PhysFS
 RAYLIB_PHYSFS_DEF unsigned char* LoadFileDataFromPhysFS(const char* fileName, int* bytesRead);  // Load a data buffer from PhysFS (memory should be freed)
+RAYLIB_PHYSFS_DEF void UnloadFileDataFromPhysFS(unsigned char* data);             // Unload file data loaded from PhysFS, keeping the memory accounting up to date
+RAYLIB_PHYSFS_DEF int GetPhysFSPathId(const char* fileName);                      // Intern a path for the functions taking a path id, which then skip processing the path (returns 0 on failure)
+RAYLIB_PHYSFS_DEF bool FileExistsInPhysFSById(int pathId);                        // Check if the file with the given path id exists in PhysFS
+RAYLIB_PHYSFS_DEF unsigned char* LoadFileDataFromPhysFSById(int pathId, int* bytesRead);  // Load a data buffer from the file with the given path id (memory should be freed)
+RAYLIB_PHYSFS_DEF long GetFileModTimeFromPhysFSById(int pathId);                  // Get the modification time of the file with the given path id
+RAYLIB_PHYSFS_DEF FileView MapFileViewFromPhysFS(const char* fileName);           // Map a read-only view of a file from PhysFS, without copying when possible (view should be unmapped)
+RAYLIB_PHYSFS_DEF void UnmapFileView(FileView view);                              // Unmap a file view loaded with MapFileViewFromPhysFS()
+RAYLIB_PHYSFS_DEF int LoadFileDataFromPhysFSAsync(const char* fileName, int priority);  // Load a data buffer from PhysFS on a worker thread, higher priorities first (returns a job)
+RAYLIB_PHYSFS_DEF bool IsPhysFSJobDone(int job);                                 // Check if an asynchronous PhysFS job has finished
+RAYLIB_PHYSFS_DEF unsigned char* WaitPhysFSJob(int job, int* bytesRead);          // Wait for an asynchronous PhysFS load to finish, and take its data (memory should be freed)
+RAYLIB_PHYSFS_DEF bool CancelPhysFSJob(int job);                                  // Cancel an asynchronous PhysFS job, discarding its data
 RAYLIB_PHYSFS_DEF char* LoadFileTextFromPhysFS(const char* fileName);             // Load text from a file (memory should be freed)
+RAYLIB_PHYSFS_DEF void UnloadFileTextFromPhysFS(char* text);                      // Unload text loaded from PhysFS, keeping the memory accounting up to date
+RAYLIB_PHYSFS_DEF void SetPhysFSCacheSize(long long capacity);                   // Set the maximum bytes of file data to keep cached in memory (0 disables the cache, the default)
+RAYLIB_PHYSFS_DEF void ClearPhysFSCache();                                        // Remove all file data from the cache
+RAYLIB_PHYSFS_DEF PhysFSCacheStats GetPhysFSCacheStats();                         // Get the counters for the file data cache
+RAYLIB_PHYSFS_DEF PhysFSStats GetPhysFSStats();                                   // Get the I/O statistics of all threads, when built with RAYLIB_PHYSFS_STATS
+RAYLIB_PHYSFS_DEF void ResetPhysFSStats();                                        // Reset the I/O statistics to zero
+RAYLIB_PHYSFS_DEF bool ExportPhysFSTrace(const char* fileName);                   // Save the traced calls as Chrome trace event JSON, for Perfetto or chrome://tracing, when built with RAYLIB_PHYSFS_TRACE
+RAYLIB_PHYSFS_DEF void ClearPhysFSTrace();                                        // Forget the traced calls
+RAYLIB_PHYSFS_DEF void SetPhysFSAccessRecording(bool enabled);                    // Set whether to record the order in which files are first loaded, for ExportPhysFSPackPro()
+RAYLIB_PHYSFS_DEF bool ExportPhysFSAccessOrder(const char* fileName);             // Save the recorded order in which files were first loaded, one path per line
+RAYLIB_PHYSFS_DEF void SetPhysFSIORecording(bool enabled);                        // Set whether to record every read request with its time, offset, size and latency, for the raylib-physfs-replay tool
+RAYLIB_PHYSFS_DEF bool ExportPhysFSIORecording(const char* fileName);             // Save the recorded read requests in a compact binary format
+RAYLIB_PHYSFS_DEF PhysFSIORecording LoadPhysFSIORecording(const char* fileName);  // Load read requests saved with ExportPhysFSIORecording() (recording should be unloaded)
+RAYLIB_PHYSFS_DEF void UnloadPhysFSIORecording(PhysFSIORecording recording);      // Unload read requests loaded with LoadPhysFSIORecording()
 RAYLIB_PHYSFS_DEF bool SetPhysFSWriteDirectory(const char* newDir);               // Set the base directory where PhysFS should write files to (defaults to the current working directory)
 RAYLIB_PHYSFS_DEF bool SaveFileDataToPhysFS(const char* fileName, void* data, int bytesToWrite);  // Save the given file data in PhysFS
 RAYLIB_PHYSFS_DEF bool SaveFileTextToPhysFS(const char* fileName, char* text);    // Save the given file text in PhysFS
 RAYLIB_PHYSFS_DEF FilePathList LoadDirectoryFilesFromPhysFS(const char* dirPath);  // Get filenames in a directory path (memory should be freed)
+RAYLIB_PHYSFS_DEF void UnloadDirectoryFilesFromPhysFS(FilePathList files);        // Unload filenames loaded with LoadDirectoryFilesFromPhysFS()
+RAYLIB_PHYSFS_DEF PhysFSFileInfoList LoadDirectoryFilesFromPhysFSEx(const char* dirPath, const char* filter, bool recursive);  // Get the full paths, types, sizes and modification times of files in a directory, optionally filtered (like ".png;.wav", "textures/hero*.png" or "DIR") and including subdirectories (memory should be freed)
+RAYLIB_PHYSFS_DEF void UnloadDirectoryFilesFromPhysFSEx(PhysFSFileInfoList files);  // Unload files loaded with LoadDirectoryFilesFromPhysFSEx()
+RAYLIB_PHYSFS_DEF PhysFSMemoryStats GetPhysFSMemoryStats();                       // Get the memory held by loaded file data, text and directory lists, when built with RAYLIB_PHYSFS_TRACK_MEMORY
 RAYLIB_PHYSFS_DEF long GetFileModTimeFromPhysFS(const char* fileName);            // Get file modification time (last write time) from PhysFS
 RAYLIB_PHYSFS_DEF Image LoadImageFromPhysFS(const char* fileName);                // Load an image from PhysFS
+RAYLIB_PHYSFS_DEF int LoadImagesFromPhysFS(const char** fileNames, int count, Image* images);  // Load and decode many images from PhysFS across the worker threads (returns the amount loaded)
+RAYLIB_PHYSFS_DEF bool ExportImageToPhysFS(Image image, const char* fileName);   // Export an image to a file in PhysFS, including the raw .rimg format
+RAYLIB_PHYSFS_DEF bool LoadPhysFSImageMap(const char* fileName);                 // Load a map of images to their transcoded variants, which LoadImageFromPhysFS() then picks up
+RAYLIB_PHYSFS_DEF void UnloadPhysFSImageMap();                                    // Unload the map of images to their transcoded variants
 RAYLIB_PHYSFS_DEF Texture2D LoadTextureFromPhysFS(const char* fileName);          // Load a texture from PhysFS
+RAYLIB_PHYSFS_DEF int LoadTexturesFromPhysFS(const char** fileNames, int count, Texture2D* textures);  // Load many textures from PhysFS, decoding across the worker threads (returns the amount loaded)
 RAYLIB_PHYSFS_DEF Wave LoadWaveFromPhysFS(const char* fileName);                  // Load wave data from PhysFS
-RAYLIB_PHYSFS_DEF Music LoadMusicStreamFromPhysFS(const char* fileName);          // Load music data from PhysFS
+RAYLIB_PHYSFS_DEF Music LoadMusicStreamFromPhysFS(const char* fileName);          // Load music data from PhysFS, streamed from the file when possible
+RAYLIB_PHYSFS_DEF void UnloadMusicStreamFromPhysFS(Music music);                  // Unload music loaded from PhysFS, along with its file data
+RAYLIB_PHYSFS_DEF bool SetPhysFSMusicThread(bool enabled);                        // Set whether music loaded from PhysFS is decoded on a background thread
+RAYLIB_PHYSFS_DEF void UpdateMusicStreamFromPhysFS(Music music);                  // Update buffers for music loaded from PhysFS, unless the music thread does it
+RAYLIB_PHYSFS_DEF void StopMusicStreamFromPhysFS(Music music);                    // Stop music loaded from PhysFS, safely with the music thread
+RAYLIB_PHYSFS_DEF void SeekMusicStreamFromPhysFS(Music music, float position);    // Seek music loaded from PhysFS to a position (in seconds), safely with the music thread
 RAYLIB_PHYSFS_DEF Font LoadFontFromPhysFS(const char* fileName, int fontSize, int *fontChars, int charsCount);  // Load a font from PhysFS
 RAYLIB_PHYSFS_DEF Shader LoadShaderFromPhysFS(const char* vsFileName, const char* fsFileName);  // Load shader from PhysFS
+RAYLIB_PHYSFS_DEF int AcquireTextureFromPhysFS(const char* fileName);             // Load a texture from PhysFS, or share the one already loaded from the path (returns a handle)
+RAYLIB_PHYSFS_DEF Texture2D GetPhysFSTexture(int texture);                        // Get the texture behind a handle from AcquireTextureFromPhysFS()
+RAYLIB_PHYSFS_DEF void ReleasePhysFSTexture(int texture);                         // Release a texture handle, unloading the texture when it was the last one
+RAYLIB_PHYSFS_DEF int AcquireWaveFromPhysFS(const char* fileName);                // Load wave data from PhysFS, or share the wave already loaded from the path (returns a handle)
+RAYLIB_PHYSFS_DEF Wave GetPhysFSWave(int wave);                                   // Get the wave behind a handle from AcquireWaveFromPhysFS()
+RAYLIB_PHYSFS_DEF void ReleasePhysFSWave(int wave);                               // Release a wave handle, unloading the wave when it was the last one
+RAYLIB_PHYSFS_DEF int AcquireFontFromPhysFS(const char* fileName, int fontSize);  // Load a font from PhysFS, or share the font already loaded from the path at that size (returns a handle)
+RAYLIB_PHYSFS_DEF Font GetPhysFSFont(int font);                                   // Get the font behind a handle from AcquireFontFromPhysFS()
+RAYLIB_PHYSFS_DEF void ReleasePhysFSFont(int font);                               // Release a font handle, unloading the font when it was the last one
+RAYLIB_PHYSFS_DEF int AcquireShaderFromPhysFS(const char* vsFileName, const char* fsFileName);  // Load a shader from PhysFS, or share the shader already loaded from the paths (returns a handle)
+RAYLIB_PHYSFS_DEF Shader GetPhysFSShader(int shader);                             // Get the shader behind a handle from AcquireShaderFromPhysFS()
+RAYLIB_PHYSFS_DEF void ReleasePhysFSShader(int shader);                           // Release a shader handle, unloading the shader when it was the last one
+RAYLIB_PHYSFS_DEF bool PreloadPhysFSAssetGroup(const char* manifest, const char* group);  // Start reading and decoding a group of assets from a manifest on the worker threads
+RAYLIB_PHYSFS_DEF bool LoadPhysFSAssetGroup(const char* manifest, const char* group);  // Load a group of assets from a manifest, decoding them in parallel (returns true if all loaded)
+RAYLIB_PHYSFS_DEF void UnloadPhysFSAssetGroup(const char* group);                 // Release all assets in a loaded group
+RAYLIB_PHYSFS_DEF bool QueuePhysFSAsset(const char* group, const char* asset);    // Queue a single asset into a group, described like a manifest line (e.g. "texture assets/tiles.png")
+RAYLIB_PHYSFS_DEF bool UpdatePhysFSLoader(float maxMilliseconds);                 // Finish loading queued assets, within the given time budget (returns true once all are done)
+RAYLIB_PHYSFS_DEF PhysFSLoaderProgress GetPhysFSLoaderProgress();                 // Get how many of the queued assets have loaded
 RAYLIB_PHYSFS_DEF void SetPhysFSCallbacks();                                      // Set the raylib file loader/saver callbacks to use PhysFS
 RAYLIB_PHYSFS_DEF const char* GetPerfDirectory(const char *organization, const char *application); // Get the user's current config directory for the application.
 
@@ -86,418 +345,8222 @@ RAYLIB_PHYSFS_DEF const char* GetPerfDirectory(const char *organization, const c
 #define PHYSFS_DECL RAYLIB_PHYSFS_DEF
 #include "physfs.h"
 
+// Sorting
+#include <stdlib.h>     // qsort()
+#include <string.h>     // strcmp(), strchr()
+
+// Index snapshots
+#include <stdio.h>      // fopen(), rename(), vsnprintf()
+#include <stdarg.h>     // va_list
+
+// Memory mapping
+#if !defined(RAYLIB_PHYSFS_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#define RAYLIB_PHYSFS_MMAP
+#include <stdio.h>      // snprintf()
+#include <string.h>     // strncmp()
+#include <fcntl.h>      // open()
+#include <unistd.h>     // close(), sysconf()
+#include <sys/mman.h>   // mmap(), munmap()
+#include <sys/stat.h>   // stat()
+#endif
+
+// Threading
+#if defined(_MSC_VER)
+#include <threads.h>
+#include <time.h>       // timespec_get()
+typedef thrd_t PhysFSThread;
+typedef mtx_t PhysFSMutex;
+typedef cnd_t PhysFSCondition;
+typedef int PhysFSThreadResult;
+#define CreatePhysFSThread(thread, proc, arg) (thrd_create(&(thread), proc, arg) == thrd_success)
+#define JoinPhysFSThread(thread) thrd_join(thread, 0)
+#define InitPhysFSMutex(mutex) mtx_init(&(mutex), mtx_plain)
+#define DestroyPhysFSMutex(mutex) mtx_destroy(&(mutex))
+#define LockPhysFSMutex(mutex) mtx_lock(&(mutex))
+#define UnlockPhysFSMutex(mutex) mtx_unlock(&(mutex))
+#define InitPhysFSCondition(condition) cnd_init(&(condition))
+#define DestroyPhysFSCondition(condition) cnd_destroy(&(condition))
+#define WaitPhysFSCondition(condition, mutex) cnd_wait(&(condition), &(mutex))
+#define BroadcastPhysFSCondition(condition) cnd_broadcast(&(condition))
+#define SleepPhysFSThread(milliseconds) do { struct timespec duration = { (milliseconds) / 1000, ((milliseconds) % 1000) * 1000000L }; thrd_sleep(&duration, 0); } while (0)
+#else
+#include <pthread.h>
+#include <time.h>       // nanosleep(), clock_gettime()
+typedef pthread_t PhysFSThread;
+typedef pthread_mutex_t PhysFSMutex;
+typedef pthread_cond_t PhysFSCondition;
+typedef void* PhysFSThreadResult;
+#define CreatePhysFSThread(thread, proc, arg) (pthread_create(&(thread), 0, proc, arg) == 0)
+#define JoinPhysFSThread(thread) pthread_join(thread, 0)
+#define InitPhysFSMutex(mutex) pthread_mutex_init(&(mutex), 0)
+#define DestroyPhysFSMutex(mutex) pthread_mutex_destroy(&(mutex))
+#define LockPhysFSMutex(mutex) pthread_mutex_lock(&(mutex))
+#define UnlockPhysFSMutex(mutex) pthread_mutex_unlock(&(mutex))
+#define InitPhysFSCondition(condition) pthread_cond_init(&(condition), 0)
+#define DestroyPhysFSCondition(condition) pthread_cond_destroy(&(condition))
+#define WaitPhysFSCondition(condition, mutex) pthread_cond_wait(&(condition), &(mutex))
+#define BroadcastPhysFSCondition(condition) pthread_cond_broadcast(&(condition))
+#define SleepPhysFSThread(milliseconds) do { struct timespec duration = { (milliseconds) / 1000, ((milliseconds) % 1000) * 1000000L }; nanosleep(&duration, 0); } while (0)
+#endif
+
+// Atomics, for 64-bit and int values that are written under a lock but checked without it
+#if defined(_MSC_VER)
+#define LoadPhysFSAtomic(value) (*(volatile unsigned long long*)&(value))
+#define StorePhysFSAtomic(value, newValue) (*(volatile unsigned long long*)&(value) = (newValue))
+#define LoadPhysFSAtomicInt(value) (*(volatile int*)&(value))
+#define StorePhysFSAtomicInt(value, newValue) (*(volatile int*)&(value) = (newValue))
+#else
+#define LoadPhysFSAtomic(value) __atomic_load_n(&(value), __ATOMIC_ACQUIRE)
+#define StorePhysFSAtomic(value, newValue) __atomic_store_n(&(value), (newValue), __ATOMIC_RELEASE)
+#define LoadPhysFSAtomicInt(value) __atomic_load_n(&(value), __ATOMIC_ACQUIRE)
+#define StorePhysFSAtomicInt(value, newValue) __atomic_store_n(&(value), (newValue), __ATOMIC_RELEASE)
+#endif
+
+// Statistics and tracing
+#if defined(RAYLIB_PHYSFS_STATS) || defined(RAYLIB_PHYSFS_TRACE)
+#if defined(_MSC_VER)
+#define PHYSFS_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define PHYSFS_THREAD_LOCAL _Thread_local
+#else
+#define PHYSFS_THREAD_LOCAL __thread
+#endif
+#define GetPhysFSCallTime() GetPhysFSTime()
+#define RecordPhysFSCall(api, fileName, openTime, readTime, decodeTime, bytesRead, bytesWritten, failed) RecordPhysFSCallEvent(api, fileName, openTime, readTime, decodeTime, bytesRead, bytesWritten, failed)
+#else
+#define GetPhysFSCallTime() 0.0
+#define RecordPhysFSCall(api, fileName, openTime, readTime, decodeTime, bytesRead, bytesWritten, failed) ((void)(fileName), (void)(openTime), (void)(readTime), (void)(decodeTime))
+#endif
+
+// Memory accounting
+#ifdef RAYLIB_PHYSFS_TRACK_MEMORY
+#define TrackPhysFSAllocation(data, size, api, fileName) AddPhysFSAllocation(data, size, api, fileName)
+#define UntrackPhysFSAllocation(data) RemovePhysFSAllocation(data)
+#else
+#define TrackPhysFSAllocation(data, size, api, fileName) ((void)0)
+#define UntrackPhysFSAllocation(data) ((void)0)
+#endif
+
+#ifndef RAYLIB_PHYSFS_WORKER_COUNT
+/**
+ * The number of worker threads used for asynchronous loading.
+ */
+#define RAYLIB_PHYSFS_WORKER_COUNT 4
+#endif
+
+#ifndef RAYLIB_PHYSFS_PACK_ALIGNMENT
+/**
+ * The alignment of entries in packs written by ExportPhysFSPack(), in bytes. Matches the page size, so entries can be memory mapped.
+ */
+#define RAYLIB_PHYSFS_PACK_ALIGNMENT 4096
+#endif
+
+#ifndef RAYLIB_PHYSFS_INDEX_SNAPSHOTS
+/**
+ * The most index snapshots to keep in the directory set with SetPhysFSIndexSnapshotDirectory(). Saving one removes the oldest beyond that.
+ */
+#define RAYLIB_PHYSFS_INDEX_SNAPSHOTS 64
+#endif
+
+#ifndef RAYLIB_PHYSFS_MUSIC_THREAD_INTERVAL
+/**
+ * How often the music thread tops up music buffers, in milliseconds.
+ */
+#define RAYLIB_PHYSFS_MUSIC_THREAD_INTERVAL 10
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
- * Reports the last PhysFS error to raylib's TraceLog.
- *
- * @param detail Any additional detail to append to the reported error.
- *
- * @see PHYSFS_getLastErrorCode()
+ * The state of an asynchronous job.
+ *
+ * @internal
+ */
+typedef enum {
+    PHYSFS_JOB_QUEUED = 0,
+    PHYSFS_JOB_RUNNING,
+    PHYSFS_JOB_DONE
+} PhysFSJobState;
+
+/**
+ * An asynchronous job, run by the worker threads.
+ *
+ * @internal
+ */
+typedef struct PhysFSJobData {
+    PhysFSJobState state;
+    bool cancelled;                             // Whether the job was cancelled while running
+    int priority;                               // Higher priorities run first
+    unsigned long long sequence;                // Submission order, for jobs of the same priority
+    void (*proc)(struct PhysFSJobData* job);    // The work to do, called without holding the job mutex
+    char* fileName;
+    unsigned char* data;
+    int dataSize;
+    int fileSize;                               // The size of the file, when data holds it compressed
+    unsigned int checksum;                      // The CRC-32 of the file
+    Image image;
+    Wave wave;
+} PhysFSJobData;
+
+/**
+ * A slot backing a job handle. The generation changes whenever the slot is reused.
+ *
+ * @internal
+ */
+typedef struct PhysFSJobSlot {
+    unsigned int generation;
+    PhysFSJobData* job;
+    int nextFree;
+} PhysFSJobSlot;
+
+static PhysFSMutex physfsJobMutex;
+static PhysFSCondition physfsJobQueued;         // Signalled when a job is queued, or the workers should stop
+static PhysFSCondition physfsJobDone;           // Signalled when a job finishes
+static PhysFSThread physfsWorkers[RAYLIB_PHYSFS_WORKER_COUNT];
+static int physfsWorkerCount = 0;
+static bool physfsWorkersStopping = false;
+static PhysFSJobData** physfsJobQueue = 0;      // Binary heap of queued jobs
+static int physfsJobQueueCount = 0;
+static int physfsJobQueueCapacity = 0;
+static PhysFSJobSlot* physfsJobSlots = 0;
+static int physfsJobSlotCount = 0;
+static int physfsJobSlotFree = -1;
+static unsigned long long physfsJobSequence = 0;
+
+/**
+ * Open addressing hash map from strings to integers. The keys are owned by the caller.
+ *
+ * @internal
+ */
+typedef struct PhysFSHashMap {
+    const char** keys;                          // 0 for empty slots
+    unsigned int* hashes;
+    int* values;
+    int capacity;                               // Always a power of two
+    int count;
+} PhysFSHashMap;
+
+/**
+ * File data kept in the cache.
+ *
+ * @internal
+ */
+typedef struct PhysFSCacheEntry {
+    char* fileName;
+    unsigned int hash;
+    unsigned char* data;
+    int size;
+    int refCount;                               // File views reading from the data
+    bool cached;                                // False once removed from the cache, while views still read from it
+    int previous;                               // More recently used entry, or the next free entry
+    int next;                                   // Less recently used entry
+} PhysFSCacheEntry;
+
+static PhysFSMutex physfsCacheMutex;
+static PhysFSHashMap physfsCacheMap = { 0 };
+static PhysFSCacheEntry* physfsCacheEntries = 0;
+static int physfsCacheEntryCount = 0;
+static int physfsCacheEntryFree = -1;
+static int physfsCacheFirst = -1;               // Most recently used entry
+static int physfsCacheLast = -1;                // Least recently used entry
+static PhysFSCacheStats physfsCacheStats = { 0 };
+
+/**
+ * A path in the merged search path, kept by SetPhysFSIndexing().
+ *
+ * @internal
+ */
+typedef struct PhysFSIndexEntry {
+    char* path;                                 // 0 for free entries
+    unsigned int hash;
+    int mount;                                  // The mount the path resolves to, or -1 if it isn't known
+    PHYSFS_Stat stat;
+    int nextFree;
+} PhysFSIndexEntry;
+
+static PhysFSMutex physfsIndexMutex;
+static int physfsIndexing = 0;                  // Also checked without the lock, with LoadPhysFSAtomicInt()
+static PhysFSHashMap physfsIndexMap = { 0 };
+static PhysFSIndexEntry* physfsIndexEntries = 0;
+static int physfsIndexEntryCount = 0;
+static int physfsIndexEntryCapacity = 0;
+static int physfsIndexEntryFree = -1;
+static char** physfsIndexMounts = 0;            // The directories and archives paths resolve to, 0 once unmounted
+static int physfsIndexMountCount = 0;
+
+#define PHYSFS_INDEX_SNAPSHOT_VERSION 1
+#define PHYSFS_INDEX_SNAPSHOT_HEADER_SIZE 20
+#define PHYSFS_INDEX_SNAPSHOT_ENTRY_SIZE 36
+static char* physfsIndexSnapshotDirectory = 0;  // Where SetPhysFSIndexSnapshotDirectory() keeps snapshots, 0 if disabled
+static unsigned long long physfsIndexSnapshotKey = 0;   // Everything mounted since indexing was enabled
+static bool physfsIndexSnapshotKeyValid = false;
+
+/**
+ * A directory or archive registered with MountPhysFSLazy(), that's not mounted yet.
+ *
+ * @internal
+ */
+typedef struct PhysFSLazyMount {
+    char* newDir;
+    char* mountPoint;                           // Without leading or trailing slashes
+    bool opening;                               // True while a thread mounts it, outside of the lock
+} PhysFSLazyMount;
+
+static PhysFSMutex physfsLazyMutex;
+static PhysFSCondition physfsLazyOpened;        // Signalled when a thread is done mounting a lazy mount
+static PhysFSLazyMount* physfsLazyMounts = 0;   // In the order they were registered
+static int physfsLazyMountCount = 0;
+
+/**
+ * A path interned with GetPhysFSPathId(), along with what it last resolved to.
+ *
+ * @internal
+ */
+typedef struct PhysFSPathId {
+    char* path;                                 // Without leading slashes
+    unsigned int generation;                    // The generation the stat was taken at, 0 if it wasn't yet
+    bool exists;
+    PHYSFS_Stat stat;
+} PhysFSPathId;
+
+#define PHYSFS_PATH_ID_LOCKS 16
+
+static PhysFSMutex physfsPathIdMutex;                               // Guards interning paths
+static PhysFSMutex physfsPathIdLocks[PHYSFS_PATH_ID_LOCKS];         // Path id i is guarded by lock i % PHYSFS_PATH_ID_LOCKS, and changing what's shared takes all of them
+static PhysFSHashMap physfsPathIdMap = { 0 };
+static PhysFSPathId* physfsPathIds = 0;         // The path with id i is at i - 1
+static int physfsPathIdCount = 0;
+static int physfsPathIdCapacity = 0;
+static unsigned int physfsPathIdGeneration = 1; // Bumped whenever what paths resolve to may have changed
+
+/**
+ * The order in which files were first loaded, recorded with SetPhysFSAccessRecording().
+ *
+ * @internal
+ */
+static PhysFSMutex physfsAccessMutex;
+static int physfsAccessRecording = 0;           // Also checked without the lock, with LoadPhysFSAtomicInt()
+static PhysFSHashMap physfsAccessMap = { 0 };
+static char** physfsAccessPaths = 0;
+static int physfsAccessCount = 0;
+
+#ifdef RAYLIB_PHYSFS_TRACK_MEMORY
+/**
+ * A buffer loaded from PhysFS, tracked with RAYLIB_PHYSFS_TRACK_MEMORY.
+ *
+ * @internal
+ */
+typedef struct PhysFSAllocation {
+    const void* data;                   // 0 for empty slots
+    long long size;
+    const char* api;                    // The function that loaded it
+    char* fileName;                     // The file or directory it was loaded from
+} PhysFSAllocation;
+
+static PhysFSMutex physfsMemoryMutex;
+static PhysFSAllocation* physfsAllocations = 0;    // Open addressing, keyed by the buffer
+static int physfsAllocationCapacity = 0;            // Always a power of two
+static PhysFSMemoryStats physfsMemoryStats = { 0 };
+#endif
+
+#define PHYSFS_IO_RECORDING_VERSION 1
+#define PHYSFS_IO_RECORDING_HEADER_SIZE 16
+#define PHYSFS_IO_REQUEST_SIZE 30
+
+static PhysFSMutex physfsIOMutex;
+static int physfsIORecording = 0;               // Also checked without the lock, with LoadPhysFSAtomicInt()
+static double physfsIORecordingStartTime = 0.0;
+static PhysFSIORecording physfsIORequests = { 0 };
+static int physfsIORequestCapacity = 0;
+static int physfsIOPathCapacity = 0;
+static PhysFSHashMap physfsIOPathMap = { 0 };
+
+#ifdef RAYLIB_PHYSFS_STATS
+/**
+ * The statistics recorded by one thread. Threads only lock their own statistics while recording,
+ * so they never wait on each other, and GetPhysFSStats() adds them all up.
+ *
+ * @internal
+ */
+typedef struct PhysFSStatsThread {
+    PhysFSMutex mutex;
+    PhysFSStats stats;
+    unsigned int mountHashes[RAYLIB_PHYSFS_STATS_MOUNTS];  // HashPhysFSString() of each of the mounts in the statistics
+    struct PhysFSStatsThread* next;
+} PhysFSStatsThread;
+
+static PhysFSMutex physfsStatsMutex;
+static PhysFSStatsThread* physfsStatsThreads = 0;
+static unsigned int physfsStatsGeneration = 0;  // Changes with every InitPhysFS(), so threads drop statistics that ClosePhysFS() freed
+static PHYSFS_THREAD_LOCAL PhysFSStatsThread* physfsStatsThread = 0;
+static PHYSFS_THREAD_LOCAL unsigned int physfsStatsThreadGeneration = 0;
+#endif
+
+#ifdef RAYLIB_PHYSFS_TRACE
+#define PHYSFS_TRACE_PATH_SIZE 128
+
+/**
+ * A call recorded for ExportPhysFSTrace().
+ *
+ * @internal
+ */
+typedef struct PhysFSTraceEvent {
+    double startTime;                   // When the call started, in milliseconds since InitPhysFS()
+    double phases[PHYSFS_STATS_PHASE_COUNT];    // The time spent in each phase, in milliseconds
+    long long bytes;                    // The bytes read or written
+    PhysFSStatsApi api;
+    bool failed;
+    char fileName[PHYSFS_TRACE_PATH_SIZE];
+} PhysFSTraceEvent;
+
+/**
+ * The ring buffer of calls recorded by one thread. Only the thread itself writes to it, publishing
+ * each event by advancing eventCount, so recording never takes a lock.
+ *
+ * @internal
+ */
+typedef struct PhysFSTraceThread {
+    PhysFSTraceEvent events[RAYLIB_PHYSFS_TRACE_EVENTS];
+    unsigned long long eventCount;      // Events ever written, the newest at (eventCount - 1) % RAYLIB_PHYSFS_TRACE_EVENTS
+    unsigned long long firstEvent;      // The first event since ClearPhysFSTrace()
+    int id;
+    struct PhysFSTraceThread* next;
+} PhysFSTraceThread;
+
+static PhysFSMutex physfsTraceMutex;
+static PhysFSTraceThread* physfsTraceThreads = 0;
+static int physfsTraceThreadCount = 0;
+static double physfsTraceStartTime = 0.0;
+static unsigned int physfsTraceGeneration = 0;  // Changes with every InitPhysFS(), like physfsStatsGeneration
+static PHYSFS_THREAD_LOCAL PhysFSTraceThread* physfsTraceThread = 0;
+static PHYSFS_THREAD_LOCAL unsigned int physfsTraceThreadGeneration = 0;
+#endif
+
+#define PHYSFS_PACK_VERSION 1
+#define PHYSFS_PACK_HEADER_SIZE 32
+#define PHYSFS_PACK_ENTRY_SIZE 32
+#define PHYSFS_PACK_CODEC_STORED 0
+#define PHYSFS_PACK_CODEC_DEFLATE 1
+#define PHYSFS_PACK_MAX_DEFLATED_SIZE (64 * 1024 * 1024)  // The most raylib's DecompressData() inflates, so larger files are stored
+
+#define PHYSFS_ZIP_LOCAL_HEADER_SIZE 30
+#define PHYSFS_ZIP_CENTRAL_HEADER_SIZE 46
+#define PHYSFS_ZIP_END_SIZE 22
+#define PHYSFS_ZIP_DATE 0x0021                  // 1980-01-01, so that archives don't change with the time they're built
+
+/**
+ * An entry in a pack.
+ *
+ * @internal
+ */
+typedef struct PhysFSPackEntry {
+    unsigned long long offset;                  // Where the entry's data starts in the pack
+    unsigned long long size;                    // Size of the entry once decompressed
+    unsigned long long compressedSize;          // Size of the entry's data in the pack
+    unsigned int nameOffset;                    // Where the entry's path starts in the names
+    unsigned char codec;                        // PHYSFS_PACK_CODEC_STORED or PHYSFS_PACK_CODEC_DEFLATE
+} PhysFSPackEntry;
+
+/**
+ * A directory within a pack, implied by the names of its entries.
+ *
+ * Directories only keep the last part of their name, and find the rest through their parent.
+ *
+ * @internal
+ */
+typedef struct PhysFSPackDirectory {
+    unsigned int hash;                          // HashPhysFSString() of the whole path
+    int parent;                                 // -1 for the root
+    unsigned int nameOffset;                    // Where the last part of the path starts in the directory names
+    int firstEntry;                             // Where the directory's files start in the entries
+    int entryCount;
+    int firstSubdirectory;                      // Where the directory's own directories start in the subdirectories
+    int subdirectoryCount;
+} PhysFSPackDirectory;
+
+/**
+ * A pack mounted in PhysFS.
+ *
+ * The pack starts with a 32 byte header: "RPAK", the version, the entry count, the bucket count,
+ * the size of the names, the alignment, and the offset of the index. Each entry's data follows,
+ * aligned to the page size. The index holds a seed for each bucket of the perfect hash table, a
+ * 32 byte record for each entry in hash table order, and then the null terminated names. All
+ * integers are little-endian.
+ *
+ * @internal
+ */
+typedef struct PhysFSPackData {
+    PHYSFS_Io* io;
+    char* name;                                 // The pack as it was mounted
+    int entryCount;
+    int bucketCount;
+    unsigned int* seeds;                        // The hash seed for each bucket
+    int* slots;                                 // The entry in each slot of the hash table
+    PhysFSPackEntry* entries;                   // The entries, grouped by directory
+    char* strings;                              // The last part of each entry's path
+    unsigned int stringsSize;
+    PhysFSPackDirectory* directories;           // The directories implied by the entry names, the root first
+    int directoryCount;
+    int directoryCapacity;
+    char* directoryNames;                       // The last part of each directory's path
+    unsigned int directoryNamesSize;
+    unsigned int directoryNamesCapacity;
+    int* directoryTable;                        // Directories by the hash of their path, with linear probing, -1 for empty slots
+    int directoryTableCapacity;                 // Always a power of two
+    int* subdirectories;                        // The directories, grouped by parent
+    struct PhysFSPackData* next;
+} PhysFSPackData;
+
+/**
+ * A file open for reading within a pack.
+ *
+ * @internal
+ */
+typedef struct PhysFSPackFile {
+    PHYSFS_Io* io;                              // The file's own handle to the pack
+    PhysFSPackEntry entry;
+    unsigned long long position;
+    unsigned char* data;                        // The decompressed data, for compressed entries
+} PhysFSPackFile;
+
+#define PHYSFS_RAW_IMAGE_HEADER_SIZE 24
+
+/**
+ * Images mapped to their transcoded variants with LoadPhysFSImageMap().
+ *
+ * @internal
+ */
+static PhysFSMutex physfsImageMapMutex;
+static PhysFSHashMap physfsImageMap = { 0 };
+static char** physfsImageMapPaths = 0;          // The image paths followed by their variants, in pairs
+static int physfsImageMapCount = 0;
+
+static PhysFSMutex physfsPackMutex;
+static PhysFSPackData* physfsPacks = 0;
+
+/**
+ * Resources of one type shared through the registry, keyed by path, stored as a struct of arrays.
+ *
+ * Handles are the slot index with a generation in the upper bits, so stale handles are rejected
+ * once a slot is reused.
+ *
+ * @internal
+ */
+typedef struct PhysFSResourcePool {
+    const char* typeName;                       // For logging
+    int resourceSize;                           // Size of each resource in bytes
+    int count;                                  // Slots in use
+    int capacity;
+    int firstFree;                              // First free slot, or -1
+    unsigned char* resources;                   // The resources, resourceSize bytes each
+    char** keys;                                // The path each resource was loaded from, 0 for free slots
+    unsigned int* hashes;
+    int* refCounts;
+    unsigned int* generations;
+    int* nextFree;
+    PhysFSHashMap map;                          // Keys to slots
+} PhysFSResourcePool;
+
+static PhysFSResourcePool physfsTexturePool = { "texture", sizeof(Texture2D), 0, 0, -1, 0, 0, 0, 0, 0, 0, { 0 } };
+static PhysFSResourcePool physfsWavePool = { "wave", sizeof(Wave), 0, 0, -1, 0, 0, 0, 0, 0, 0, { 0 } };
+static PhysFSResourcePool physfsFontPool = { "font", sizeof(Font), 0, 0, -1, 0, 0, 0, 0, 0, 0, { 0 } };
+static PhysFSResourcePool physfsShaderPool = { "shader", sizeof(Shader), 0, 0, -1, 0, 0, 0, 0, 0, 0, { 0 } };
+
+/**
+ * The types of assets that can be listed in an asset group manifest.
+ *
+ * @internal
+ */
+typedef enum PhysFSAssetType {
+    PHYSFS_ASSET_TEXTURE = 0,
+    PHYSFS_ASSET_WAVE,
+    PHYSFS_ASSET_FONT,
+    PHYSFS_ASSET_SHADER
+} PhysFSAssetType;
+
+/**
+ * An asset being loaded through the registry, along with the jobs reading and decoding it.
+ *
+ * @internal
+ */
+typedef struct PhysFSAssetData {
+    PhysFSAssetType type;
+    char* fileName;                             // For shaders, the vs file, or 0
+    char* fsFileName;                           // For shaders, the fs file, or 0
+    int fontSize;                               // For fonts
+    int jobs[2];                                // Jobs reading and decoding the asset, 0 when none
+    int handle;                                 // The registry handle, once loaded
+    bool failed;                                // Whether the asset failed to load
+    long long size;                             // File bytes read for the asset, once loaded
+} PhysFSAssetData;
+
+/**
+ * A group of assets loaded with LoadPhysFSAssetGroup().
+ *
+ * @internal
+ */
+typedef struct PhysFSAssetGroupData {
+    char* name;
+    PhysFSAssetData* assets;
+    int assetCount;
+} PhysFSAssetGroupData;
+
+static PhysFSAssetGroupData* physfsAssetGroups = 0;
+static int physfsAssetGroupCount = 0;
+
+/**
+ * Music loaded through LoadMusicStreamFromPhysFS(), along with the file data it streams from.
+ *
+ * @internal
+ */
+typedef struct PhysFSMusicData {
+    Music music;
+    FileView view;
+} PhysFSMusicData;
+
+static PhysFSMusicData* physfsMusics = 0;
+static int physfsMusicCount = 0;
+static PhysFSMutex physfsMusicMutex;            // Guards the music, and its decoders while the music thread runs
+static PhysFSThread physfsMusicThread;
+static bool physfsMusicThreadRunning = false;
+static bool physfsMusicThreadStopping = false;
+
+static const unsigned char physfsEmptyFileView[1] = { 0 };  // What views of empty files read from
+
+#ifdef RAYLIB_PHYSFS_MMAP
+static FileView* physfsMappedArchives = 0;      // Archives mapped by MountPhysFSMapped()
+static int physfsMappedArchiveCount = 0;
+static PhysFSMutex physfsMappedArchiveMutex;    // Guards the mapped archives, which PhysFS unmaps from whichever thread unmounts them
+
+/**
+ * An entry of a ZIP archive, for finding where its bytes are.
+ *
+ * @internal
+ */
+typedef struct PhysFSZipEntry {
+    bool stored;                                // Whether the bytes are kept uncompressed, so that they can be viewed directly
+    long long size;
+    long long localOffset;                      // Where the entry's local header is
+    long long dataOffset;                       // Where the entry's bytes are, or -1 until the local header is read
+} PhysFSZipEntry;
+
+/**
+ * The entries of a mounted ZIP archive, read from its central directory when it's mounted.
+ *
+ * @internal
+ */
+typedef struct PhysFSZipData {
+    char* name;                                 // The archive as it was mounted
+    long long size;
+    PhysFSZipEntry* entries;
+    int entryCount;
+    char* names;                                // The name of each entry, which the map's keys point into
+    PhysFSHashMap entryMap;                     // Entries by name
+    struct PhysFSZipData* next;
+} PhysFSZipData;
+
+static PhysFSMutex physfsZipMutex;
+static PhysFSZipData* physfsZips = 0;
+#endif
+
+/**
+ * Reports the last PhysFS error to raylib's TraceLog.
+ *
+ * @param detail Any additional detail to append to the reported error.
+ *
+ * @see PHYSFS_getLastErrorCode()
+ *
+ * @internal
+ */
+void TracePhysFSError(const char* detail) {
+    PHYSFS_ErrorCode errorCode = PHYSFS_getLastErrorCode();
+    if (errorCode == PHYSFS_ERR_OK) {
+        TraceLog(LOG_WARNING, "PHYSFS: %s", detail);
+    } else {
+        const char* errorMessage = PHYSFS_getErrorByCode(errorCode);
+        TraceLog(LOG_WARNING, "PHYSFS: %s (%s)", errorMessage, detail);
+    }
+}
+
+/**
+ * Gets the current time of a monotonic clock, in milliseconds.
+ *
+ * With MSVC, this is the wall clock instead, so durations can jump if the system time changes.
+ *
+ * @internal
+ */
+double GetPhysFSTime() {
+#if defined(_MSC_VER)
+    struct timespec time;
+    timespec_get(&time, TIME_UTC);
+    return (double)time.tv_sec * 1000.0 + (double)time.tv_nsec / 1000000.0;
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec * 1000.0 + (double)time.tv_nsec / 1000000.0;
+#endif
+}
+
+/**
+ * Copies the given string with MemAlloc().
+ *
+ * @internal
+ */
+char* CopyPhysFSString(const char* text) {
+    int length = (int)TextLength(text);
+    char* output = (char*)MemAlloc(length + 1);
+    if (output != 0) {
+        for (int i = 0; i < length; i++) {
+            output[i] = text[i];
+        }
+        output[length] = '\0';
+    }
+    return output;
+}
+
+/**
+ * Formats a string into memory from MemAlloc(). Unlike TextFormat(), this is safe from the worker threads.
+ *
+ * @internal
+ */
+char* FormatPhysFSString(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(0, 0, format, args);
+    va_end(args);
+    if (length < 0) {
+        return 0;
+    }
+    char* output = (char*)MemAlloc(length + 1);
+    if (output != 0) {
+        va_start(args, format);
+        vsnprintf(output, length + 1, format, args);
+        va_end(args);
+    }
+    return output;
+}
+
+/**
+ * Resizes the given array with MemRealloc(), leaving it untouched on failure.
+ *
+ * @return True on success, false on failure.
+ *
+ * @internal
+ */
+bool GrowPhysFSArray(void** array, int size) {
+    void* grown = MemRealloc(*array, size);
+    if (grown == 0) {
+        return false;
+    }
+    *array = grown;
+    return true;
+}
+
+/**
+ * Reads a little-endian 16-bit integer.
+ *
+ * @internal
+ */
+unsigned int ReadPhysFSUInt16(const unsigned char* data) {
+    return (unsigned int)data[0] | ((unsigned int)data[1] << 8);
+}
+
+/**
+ * Reads a little-endian 32-bit integer.
+ *
+ * @internal
+ */
+unsigned int ReadPhysFSUInt32(const unsigned char* data) {
+    return (unsigned int)data[0] | ((unsigned int)data[1] << 8) | ((unsigned int)data[2] << 16) | ((unsigned int)data[3] << 24);
+}
+
+/**
+ * Reads a little-endian 64-bit integer.
+ *
+ * @internal
+ */
+unsigned long long ReadPhysFSUInt64(const unsigned char* data) {
+    return (unsigned long long)ReadPhysFSUInt32(data) | ((unsigned long long)ReadPhysFSUInt32(data + 4) << 32);
+}
+
+/**
+ * Writes a little-endian integer of the given amount of bytes.
+ *
+ * @internal
+ */
+void WritePhysFSUInt(unsigned char* data, unsigned long long value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        data[i] = (unsigned char)(value >> (i * 8));
+    }
+}
+
+/**
+ * Splits the next whitespace separated token off the given line.
+ *
+ * @return The token, or 0 if there are none left.
+ *
+ * @internal
+ */
+char* GetPhysFSManifestToken(char** line) {
+    char* start = *line;
+    while (*start == ' ' || *start == '\t') {
+        start++;
+    }
+    if (*start == '\0') {
+        *line = start;
+        return 0;
+    }
+    char* end = start;
+    while (*end != '\0' && *end != ' ' && *end != '\t') {
+        end++;
+    }
+    if (*end != '\0') {
+        *end++ = '\0';
+    }
+    *line = end;
+    return start;
+}
+
+/**
+ * Hashes the given string with FNV-1a.
+ *
+ * @internal
+ */
+unsigned int HashPhysFSString(const char* text) {
+    unsigned int hash = 2166136261u;
+    while (*text != '\0') {
+        hash = (hash ^ (unsigned char)*text++) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Finds the given key in the hash map.
+ *
+ * @return The value for the key, or -1 if it is not in the map.
+ *
+ * @internal
+ */
+int FindInPhysFSHashMap(PhysFSHashMap* map, const char* key, unsigned int hash) {
+    if (map->count == 0) {
+        return -1;
+    }
+    int mask = map->capacity - 1;
+    for (int i = (int)(hash & (unsigned int)mask); map->keys[i] != 0; i = (i + 1) & mask) {
+        if (map->hashes[i] == hash && TextIsEqual(map->keys[i], key)) {
+            return map->values[i];
+        }
+    }
+    return -1;
+}
+
+/**
+ * Adds the given key to the hash map, replacing its value if it is already there.
+ *
+ * @return True on success, false on failure.
+ *
+ * @internal
+ */
+bool AddToPhysFSHashMap(PhysFSHashMap* map, const char* key, unsigned int hash, int value) {
+    // Keep the load factor under a half.
+    if ((map->count + 1) * 2 > map->capacity) {
+        PhysFSHashMap grown = { 0 };
+        grown.capacity = map->capacity == 0 ? 64 : map->capacity * 2;
+        grown.keys = (const char**)MemAlloc(sizeof(const char*) * grown.capacity);
+        grown.hashes = (unsigned int*)MemAlloc(sizeof(unsigned int) * grown.capacity);
+        grown.values = (int*)MemAlloc(sizeof(int) * grown.capacity);
+        if (grown.keys == 0 || grown.hashes == 0 || grown.values == 0) {
+            MemFree((void*)grown.keys);
+            MemFree(grown.hashes);
+            MemFree(grown.values);
+            return false;
+        }
+        for (int i = 0; i < map->capacity; i++) {
+            if (map->keys[i] != 0) {
+                AddToPhysFSHashMap(&grown, map->keys[i], map->hashes[i], map->values[i]);
+            }
+        }
+        MemFree((void*)map->keys);
+        MemFree(map->hashes);
+        MemFree(map->values);
+        *map = grown;
+    }
+
+    int mask = map->capacity - 1;
+    int i = (int)(hash & (unsigned int)mask);
+    while (map->keys[i] != 0) {
+        if (map->hashes[i] == hash && TextIsEqual(map->keys[i], key)) {
+            map->values[i] = value;
+            return true;
+        }
+        i = (i + 1) & mask;
+    }
+    map->keys[i] = key;
+    map->hashes[i] = hash;
+    map->values[i] = value;
+    map->count++;
+    return true;
+}
+
+/**
+ * Removes the given key from the hash map.
+ *
+ * @internal
+ */
+void RemoveFromPhysFSHashMap(PhysFSHashMap* map, const char* key, unsigned int hash) {
+    if (map->count == 0) {
+        return;
+    }
+    int mask = map->capacity - 1;
+    int i = (int)(hash & (unsigned int)mask);
+    while (map->keys[i] != 0 && !(map->hashes[i] == hash && TextIsEqual(map->keys[i], key))) {
+        i = (i + 1) & mask;
+    }
+    if (map->keys[i] == 0) {
+        return;
+    }
+
+    // Shift back any following entries that would no longer be reachable.
+    map->keys[i] = 0;
+    map->count--;
+    for (int j = (i + 1) & mask; map->keys[j] != 0; j = (j + 1) & mask) {
+        int home = (int)(map->hashes[j] & (unsigned int)mask);
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            map->keys[i] = map->keys[j];
+            map->hashes[i] = map->hashes[j];
+            map->values[i] = map->values[j];
+            map->keys[j] = 0;
+            i = j;
+        }
+    }
+}
+
+/**
+ * Frees the given hash map. The keys are owned by the caller.
+ *
+ * @internal
+ */
+void UnloadPhysFSHashMap(PhysFSHashMap* map) {
+    MemFree((void*)map->keys);
+    MemFree(map->hashes);
+    MemFree(map->values);
+    PhysFSHashMap empty = { 0 };
+    *map = empty;
+}
+
+/**
+ * Unlinks the given entry from the cache's least recently used list. Requires the cache mutex.
+ *
+ * @internal
+ */
+void UnlinkPhysFSCacheEntry(int index) {
+    PhysFSCacheEntry* entry = &physfsCacheEntries[index];
+    if (entry->previous != -1) {
+        physfsCacheEntries[entry->previous].next = entry->next;
+    } else {
+        physfsCacheFirst = entry->next;
+    }
+    if (entry->next != -1) {
+        physfsCacheEntries[entry->next].previous = entry->previous;
+    } else {
+        physfsCacheLast = entry->previous;
+    }
+    entry->previous = -1;
+    entry->next = -1;
+}
+
+/**
+ * Links the given entry as the most recently used entry in the cache. Requires the cache mutex.
+ *
+ * @internal
+ */
+void LinkPhysFSCacheEntry(int index) {
+    PhysFSCacheEntry* entry = &physfsCacheEntries[index];
+    entry->previous = -1;
+    entry->next = physfsCacheFirst;
+    if (physfsCacheFirst != -1) {
+        physfsCacheEntries[physfsCacheFirst].previous = index;
+    } else {
+        physfsCacheLast = index;
+    }
+    physfsCacheFirst = index;
+}
+
+/**
+ * Frees the data of the given cache entry, and makes its slot available. Requires the cache mutex.
+ *
+ * @internal
+ */
+void FreePhysFSCacheEntry(int index) {
+    PhysFSCacheEntry* entry = &physfsCacheEntries[index];
+    MemFree(entry->fileName);
+    MemFree(entry->data);
+    entry->fileName = 0;
+    entry->data = 0;
+    entry->previous = physfsCacheEntryFree;
+    physfsCacheEntryFree = index;
+}
+
+/**
+ * Removes the given entry from the cache. Its data stays alive while file views read from it. Requires the cache mutex.
+ *
+ * @internal
+ */
+void RemovePhysFSCacheEntry(int index) {
+    PhysFSCacheEntry* entry = &physfsCacheEntries[index];
+    RemoveFromPhysFSHashMap(&physfsCacheMap, entry->fileName, entry->hash);
+    UnlinkPhysFSCacheEntry(index);
+    entry->cached = false;
+    physfsCacheStats.size -= entry->size;
+    physfsCacheStats.count--;
+    if (entry->refCount == 0) {
+        FreePhysFSCacheEntry(index);
+    }
+}
+
+/**
+ * Evicts the least recently used entries until the cache has room for the given amount of bytes. Requires the cache mutex.
+ *
+ * @internal
+ */
+void EvictPhysFSCache(long long size) {
+    int index = physfsCacheLast;
+    while (index != -1 && physfsCacheStats.size + size > physfsCacheStats.capacity) {
+        int previous = physfsCacheEntries[index].previous;
+        RemovePhysFSCacheEntry(index);
+        physfsCacheStats.evictions++;
+        index = previous;
+    }
+}
+
+/**
+ * Finds the given file in the cache, marking it as the most recently used. Requires the cache mutex.
+ *
+ * @return The index of the cache entry, or -1 if the file is not cached.
+ *
+ * @internal
+ */
+int FindPhysFSCacheEntry(const char* fileName) {
+    while (*fileName == '/') {
+        fileName++;
+    }
+    int index = FindInPhysFSHashMap(&physfsCacheMap, fileName, HashPhysFSString(fileName));
+    if (index == -1) {
+        physfsCacheStats.misses++;
+        return -1;
+    }
+    physfsCacheStats.hits++;
+    UnlinkPhysFSCacheEntry(index);
+    LinkPhysFSCacheEntry(index);
+    return index;
+}
+
+/**
+ * Copies the given file data into the cache, if the cache is enabled and it fits.
+ *
+ * @internal
+ */
+void AddToPhysFSCache(const char* fileName, const unsigned char* data, int size) {
+    // The capacity is checked again under the lock, so loads don't serialize on it while it's disabled.
+    if (LoadPhysFSAtomic(physfsCacheStats.capacity) <= 0) {
+        return;
+    }
+    while (*fileName == '/') {
+        fileName++;
+    }
+
+    LockPhysFSMutex(physfsCacheMutex);
+    if (size <= 0 || size > physfsCacheStats.capacity) {
+        UnlockPhysFSMutex(physfsCacheMutex);
+        return;
+    }
+
+    // Another thread may have cached it in the meantime.
+    unsigned int hash = HashPhysFSString(fileName);
+    if (FindInPhysFSHashMap(&physfsCacheMap, fileName, hash) != -1) {
+        UnlockPhysFSMutex(physfsCacheMutex);
+        return;
+    }
+
+    EvictPhysFSCache(size);
+
+    // Find a free slot for the entry.
+    if (physfsCacheEntryFree == -1) {
+        PhysFSCacheEntry* entries = (PhysFSCacheEntry*)MemRealloc(physfsCacheEntries, sizeof(PhysFSCacheEntry) * (physfsCacheEntryCount + 1));
+        if (entries == 0) {
+            UnlockPhysFSMutex(physfsCacheMutex);
+            return;
+        }
+        physfsCacheEntries = entries;
+        physfsCacheEntries[physfsCacheEntryCount].fileName = 0;
+        physfsCacheEntries[physfsCacheEntryCount].data = 0;
+        physfsCacheEntries[physfsCacheEntryCount].previous = -1;
+        physfsCacheEntryFree = physfsCacheEntryCount++;
+    }
+
+    int index = physfsCacheEntryFree;
+    PhysFSCacheEntry* entry = &physfsCacheEntries[index];
+    entry->fileName = CopyPhysFSString(fileName);
+    entry->data = (unsigned char*)MemAlloc(size);
+    if (entry->fileName == 0 || entry->data == 0 || !AddToPhysFSHashMap(&physfsCacheMap, entry->fileName, hash, index)) {
+        MemFree(entry->fileName);
+        MemFree(entry->data);
+        entry->fileName = 0;
+        entry->data = 0;
+        UnlockPhysFSMutex(physfsCacheMutex);
+        return;
+    }
+    physfsCacheEntryFree = entry->previous;
+
+    for (int i = 0; i < size; i++) {
+        entry->data[i] = data[i];
+    }
+    entry->hash = hash;
+    entry->size = size;
+    entry->refCount = 0;
+    entry->cached = true;
+    LinkPhysFSCacheEntry(index);
+    physfsCacheStats.size += size;
+    physfsCacheStats.count++;
+    UnlockPhysFSMutex(physfsCacheMutex);
+}
+
+/**
+ * Loads a copy of the given file's data from the cache.
+ *
+ * @return The file data, or 0 if the file is not cached.
+ *
+ * @internal
+ */
+unsigned char* LoadFileDataFromPhysFSCache(const char* fileName, int* bytesRead) {
+    unsigned char* output = 0;
+    if (!IsPhysFSReady() || LoadPhysFSAtomic(physfsCacheStats.capacity) <= 0) {
+        return output;
+    }
+
+    LockPhysFSMutex(physfsCacheMutex);
+    if (physfsCacheStats.capacity > 0) {
+        int index = FindPhysFSCacheEntry(fileName);
+        if (index != -1) {
+            PhysFSCacheEntry* entry = &physfsCacheEntries[index];
+            output = (unsigned char*)MemAlloc(entry->size);
+            if (output != 0) {
+                for (int i = 0; i < entry->size; i++) {
+                    output[i] = entry->data[i];
+                }
+                *bytesRead = entry->size;
+            }
+        }
+    }
+    UnlockPhysFSMutex(physfsCacheMutex);
+    return output;
+}
+
+/**
+ * Removes any cached files that saving the given file in the write directory could change.
+ *
+ * Where the write directory appears in the search path isn't known, so all cached files with the
+ * same name are removed.
+ *
+ * @internal
+ */
+void InvalidatePhysFSCache(const char* fileName) {
+    const char* name = GetFileName(fileName);
+    int nameLength = (int)TextLength(name);
+
+    LockPhysFSMutex(physfsCacheMutex);
+    for (int i = 0; i < physfsCacheEntryCount; i++) {
+        PhysFSCacheEntry* entry = &physfsCacheEntries[i];
+        if (entry->fileName == 0 || !entry->cached) {
+            continue;
+        }
+        int length = (int)TextLength(entry->fileName);
+        if (length >= nameLength && TextIsEqual(entry->fileName + length - nameLength, name) && (length == nameLength || entry->fileName[length - nameLength - 1] == '/')) {
+            RemovePhysFSCacheEntry(i);
+        }
+    }
+    UnlockPhysFSMutex(physfsCacheMutex);
+}
+
+/**
+ * Sets the maximum amount of file data to keep cached in memory.
+ *
+ * While enabled, LoadFileDataFromPhysFS() keeps a copy of the data it loads, and serves repeated
+ * loads of the same file from memory. MapFileViewFromPhysFS() reads cached files without copying.
+ * The least recently used files are evicted to stay within the size. The cache is cleared when
+ * anything is mounted or unmounted, and files are removed from it when saved.
+ *
+ * @param capacity The maximum bytes to cache. 0 disables the cache, which is the default.
+ *
+ * @see GetPhysFSCacheStats()
+ * @see ClearPhysFSCache()
+ */
+void SetPhysFSCacheSize(long long capacity) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot set the cache size before InitPhysFS()");
+        return;
+    }
+
+    LockPhysFSMutex(physfsCacheMutex);
+    StorePhysFSAtomic(physfsCacheStats.capacity, capacity > 0 ? capacity : 0);
+    EvictPhysFSCache(0);
+    UnlockPhysFSMutex(physfsCacheMutex);
+}
+
+/**
+ * Removes all file data from the cache.
+ *
+ * @see SetPhysFSCacheSize()
+ */
+void ClearPhysFSCache() {
+    if (!IsPhysFSReady()) {
+        return;
+    }
+
+    LockPhysFSMutex(physfsCacheMutex);
+    while (physfsCacheFirst != -1) {
+        RemovePhysFSCacheEntry(physfsCacheFirst);
+    }
+    UnlockPhysFSMutex(physfsCacheMutex);
+}
+
+/**
+ * Gets the counters for the file data cache.
+ *
+ * @return The cache counters.
+ *
+ * @see SetPhysFSCacheSize()
+ */
+PhysFSCacheStats GetPhysFSCacheStats() {
+    PhysFSCacheStats stats = { 0 };
+    if (!IsPhysFSReady()) {
+        return stats;
+    }
+
+    LockPhysFSMutex(physfsCacheMutex);
+    stats = physfsCacheStats;
+    UnlockPhysFSMutex(physfsCacheMutex);
+    return stats;
+}
+
+/**
+ * Checks whether the given path, without leading slashes, is written the way the index keeps paths.
+ *
+ * Paths PhysFS would clean up or reject, like "a//b" or "../a", are left to PHYSFS_stat().
+ *
+ * @internal
+ */
+bool IsPhysFSIndexPath(const char* path) {
+    const char* component = path;
+    for (const char* i = path; ; i++) {
+        if (*i == ':' || *i == '\\') {
+            return false;
+        }
+        if (*i == '/' || *i == '\0') {
+            int length = (int)(i - component);
+            if (length == 0 || (component[0] == '.' && (length == 1 || (length == 2 && component[1] == '.')))) {
+                return false;
+            }
+            if (*i == '\0') {
+                return true;
+            }
+            component = i + 1;
+        }
+    }
+}
+
+/**
+ * Gets the index of the given mount, adding it if it's new. Requires the index mutex.
+ *
+ * @param dir The directory or archive, as given to PhysFS when it was mounted.
+ *
+ * @return The index of the mount, or -1 if it isn't known.
+ *
+ * @internal
+ */
+int GetPhysFSIndexMount(const char* dir) {
+    if (dir == 0) {
+        return -1;
+    }
+    int slot = -1;
+    for (int i = 0; i < physfsIndexMountCount; i++) {
+        if (physfsIndexMounts[i] == 0) {
+            if (slot == -1) {
+                slot = i;
+            }
+        } else if (TextIsEqual(physfsIndexMounts[i], dir)) {
+            return i;
+        }
+    }
+    if (slot == -1) {
+        if (!GrowPhysFSArray((void**)&physfsIndexMounts, sizeof(char*) * (physfsIndexMountCount + 1))) {
+            return -1;
+        }
+        slot = physfsIndexMountCount++;
+    }
+    physfsIndexMounts[slot] = CopyPhysFSString(dir);
+    return physfsIndexMounts[slot] != 0 ? slot : -1;
+}
+
+/**
+ * Removes the given entry from the index, and makes its slot available. Requires the index mutex.
+ *
+ * @internal
+ */
+void RemovePhysFSIndexEntry(int index) {
+    PhysFSIndexEntry* entry = &physfsIndexEntries[index];
+    RemoveFromPhysFSHashMap(&physfsIndexMap, entry->path, entry->hash);
+    MemFree(entry->path);
+    entry->path = 0;
+    entry->nextFree = physfsIndexEntryFree;
+    physfsIndexEntryFree = index;
+}
+
+/**
+ * Adds the given path to the index. Requires the index mutex.
+ *
+ * @param path The path, without leading slashes, which must not be indexed yet.
+ * @param mount The mount the path resolves to, or -1 if it isn't known.
+ *
+ * @return The index of the entry, or -1 on failure.
+ *
+ * @internal
+ */
+int AddPhysFSIndexEntry(const char* path, unsigned int hash, int mount, const PHYSFS_Stat* stat) {
+    // Find a free slot for the entry.
+    if (physfsIndexEntryFree == -1) {
+        if (physfsIndexEntryCount == physfsIndexEntryCapacity) {
+            int capacity = physfsIndexEntryCapacity == 0 ? 256 : physfsIndexEntryCapacity * 2;
+            if (!GrowPhysFSArray((void**)&physfsIndexEntries, sizeof(PhysFSIndexEntry) * capacity)) {
+                return -1;
+            }
+            physfsIndexEntryCapacity = capacity;
+        }
+        physfsIndexEntries[physfsIndexEntryCount].path = 0;
+        physfsIndexEntries[physfsIndexEntryCount].nextFree = -1;
+        physfsIndexEntryFree = physfsIndexEntryCount++;
+    }
+
+    int index = physfsIndexEntryFree;
+    PhysFSIndexEntry* entry = &physfsIndexEntries[index];
+    entry->path = CopyPhysFSString(path);
+    if (entry->path == 0 || !AddToPhysFSHashMap(&physfsIndexMap, entry->path, hash, index)) {
+        MemFree(entry->path);
+        entry->path = 0;
+        return -1;
+    }
+    physfsIndexEntryFree = entry->nextFree;
+    entry->hash = hash;
+    entry->mount = mount;
+    entry->stat = *stat;
+    return index;
+}
+
+/**
+ * Looks up the given path in PhysFS, and adds it to the index if it's not there yet. Requires the index mutex.
+ *
+ * @param path The path, without leading slashes.
+ * @param mount The mount the path resolves to if it's new, or -1 to ask PhysFS.
+ *
+ * @return The index of the entry, or -1 if the path does not exist.
+ *
+ * @internal
+ */
+int AddPhysFSIndexPath(const char* path, int mount) {
+    unsigned int hash = HashPhysFSString(path);
+    int index = FindInPhysFSHashMap(&physfsIndexMap, path, hash);
+    if (index != -1) {
+        return index;
+    }
+
+    PHYSFS_Stat stat;
+    if (PHYSFS_stat(path, &stat) == 0) {
+        return -1;
+    }
+    if (mount == -1) {
+        mount = GetPhysFSIndexMount(PHYSFS_getRealDir(path));
+    }
+    return AddPhysFSIndexEntry(path, hash, mount, &stat);
+}
+
+/**
+ * Adds the paths within the given directory to the index, recursively. Requires the index mutex.
+ *
+ * Paths that are already indexed keep the mount they resolve to, as mounts are appended to the
+ * search path, and earlier mounts win.
+ *
+ * @param dirPath The directory, without leading slashes.
+ * @param mount The mount that new paths resolve to, or -1 to ask PhysFS.
+ *
+ * @internal
+ */
+void AddPhysFSIndexDirectory(const char* dirPath, int mount) {
+    char** list = PHYSFS_enumerateFiles(dirPath);
+    if (list == 0) {
+        return;
+    }
+    for (char** i = list; *i != 0; i++) {
+        char* path = dirPath[0] == '\0' ? CopyPhysFSString(*i) : FormatPhysFSString("%s/%s", dirPath, *i);
+        if (path == 0) {
+            continue;
+        }
+        int index = AddPhysFSIndexPath(path, mount);
+        if (index != -1 && physfsIndexEntries[index].stat.filetype == PHYSFS_FILETYPE_DIRECTORY) {
+            AddPhysFSIndexDirectory(path, mount);
+        }
+        MemFree(path);
+    }
+    PHYSFS_freeList(list);
+}
+
+/**
+ * Looks up the given entry in PhysFS again, after the search path changed. Requires the index mutex.
+ *
+ * @internal
+ */
+void ResolvePhysFSIndexEntry(int index) {
+    PhysFSIndexEntry* entry = &physfsIndexEntries[index];
+    PHYSFS_Stat stat;
+    if (PHYSFS_stat(entry->path, &stat) == 0) {
+        RemovePhysFSIndexEntry(index);
+        return;
+    }
+    entry->stat = stat;
+    entry->mount = GetPhysFSIndexMount(PHYSFS_getRealDir(entry->path));
+}
+
+/**
+ * Frees the index. Requires the index mutex.
+ *
+ * @internal
+ */
+void UnloadPhysFSIndex() {
+    for (int i = 0; i < physfsIndexEntryCount; i++) {
+        MemFree(physfsIndexEntries[i].path);
+    }
+    for (int i = 0; i < physfsIndexMountCount; i++) {
+        MemFree(physfsIndexMounts[i]);
+    }
+    MemFree(physfsIndexEntries);
+    MemFree(physfsIndexMounts);
+    UnloadPhysFSHashMap(&physfsIndexMap);
+    physfsIndexEntries = 0;
+    physfsIndexEntryCount = 0;
+    physfsIndexEntryCapacity = 0;
+    physfsIndexEntryFree = -1;
+    physfsIndexMounts = 0;
+    physfsIndexMountCount = 0;
+}
+
+/**
+ * Hashes the given bytes into an index snapshot key, with 64-bit FNV-1a.
+ *
+ * @internal
+ */
+unsigned long long HashPhysFSIndexSnapshotKey(unsigned long long key, const void* data, int size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (int i = 0; i < size; i++) {
+        key = (key ^ bytes[i]) * 1099511628211ULL;
+    }
+    return key;
+}
+
+/**
+ * Gets the fingerprint of the given archive for a snapshot key, from its size and modification time.
+ *
+ * @param fingerprint Where to save the 16 byte fingerprint.
+ *
+ * @return True if the mount can be snapshotted, as it's an archive on disk, false otherwise.
+ *
+ * @internal
+ */
+bool GetPhysFSIndexSnapshotFingerprint(const char* newDir, unsigned char* fingerprint) {
+    if (!FileExists(newDir) || DirectoryExists(newDir)) {
+        return false;
+    }
+    WritePhysFSUInt(fingerprint, (unsigned long long)GetFileLength(newDir), 8);
+    WritePhysFSUInt(fingerprint + 8, (unsigned long long)GetFileModTime(newDir), 8);
+    return true;
+}
+
+/**
+ * Adds mounting the given archive to a snapshot key.
+ *
+ * Archives are fingerprinted by their size and modification time, so a key only matches while
+ * the same archives are mounted and unmounted in the same order, at the same mount points.
+ *
+ * @param mountPoint The mount point, without leading or trailing slashes.
+ * @param fingerprint The archive's fingerprint, from GetPhysFSIndexSnapshotFingerprint().
+ *
+ * @internal
+ */
+void AddPhysFSIndexSnapshotKey(unsigned long long* key, const char* newDir, const char* mountPoint, const unsigned char* fingerprint) {
+    *key = HashPhysFSIndexSnapshotKey(*key, newDir, (int)TextLength(newDir) + 1);
+    *key = HashPhysFSIndexSnapshotKey(*key, mountPoint, (int)TextLength(mountPoint) + 1);
+    *key = HashPhysFSIndexSnapshotKey(*key, fingerprint, 16);
+}
+
+/**
+ * Gets where the index snapshot with the given key is kept. Requires the index mutex.
+ *
+ * @return The path, to be freed with MemFree().
+ *
+ * @internal
+ */
+char* GetPhysFSIndexSnapshotPath(unsigned long long key) {
+    int length = (int)TextLength(physfsIndexSnapshotDirectory);
+    char last = length > 0 ? physfsIndexSnapshotDirectory[length - 1] : '/';
+    const char* separator = last == '/' || last == '\\' ? "" : PHYSFS_getDirSeparator();
+    return FormatPhysFSString("%s%s%016llx.rpidx", physfsIndexSnapshotDirectory, separator, key);
+}
+
+/**
+ * Reads the index snapshot with the given key, and checks all of it.
+ *
+ * @param count Where to save the amount of paths in the snapshot.
+ *
+ * @return The snapshot's data, or 0 if it's missing or corrupt. Free it with MemFree().
+ *
+ * @internal
+ */
+unsigned char* ReadPhysFSIndexSnapshot(const char* fileName, unsigned long long key, unsigned int* count) {
+    FILE* file = fopen(fileName, "rb");
+    if (file == 0) {
+        return 0;
+    }
+
+    // Read it in one go.
+    unsigned char* data = 0;
+    long size = 0;
+    if (fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) >= PHYSFS_INDEX_SNAPSHOT_HEADER_SIZE && fseek(file, 0, SEEK_SET) == 0) {
+        data = (unsigned char*)MemAlloc((unsigned int)size);
+        if (data != 0 && fread(data, 1, (size_t)size, file) != (size_t)size) {
+            MemFree(data);
+            data = 0;
+        }
+    }
+    fclose(file);
+    if (data == 0) {
+        return 0;
+    }
+
+    // Check the whole snapshot before adding any of it.
+    bool valid = data[0] == 'R' && data[1] == 'P' && data[2] == 'I' && data[3] == 'X' &&
+        ReadPhysFSUInt32(data + 4) == PHYSFS_INDEX_SNAPSHOT_VERSION && ReadPhysFSUInt64(data + 8) == key;
+    *count = valid ? ReadPhysFSUInt32(data + 16) : 0;
+    long position = PHYSFS_INDEX_SNAPSHOT_HEADER_SIZE;
+    for (unsigned int i = 0; valid && i < *count; i++) {
+        valid = position + PHYSFS_INDEX_SNAPSHOT_ENTRY_SIZE <= size;
+        long length = valid ? (long)ReadPhysFSUInt16(data + position) : 0;
+        position += PHYSFS_INDEX_SNAPSHOT_ENTRY_SIZE + length + 1;
+        valid = valid && length > 0 && position <= size && data[position - 1] == '\0';
+    }
+    if (!valid || position != size) {
+        TraceLog(LOG_WARNING, "PHYSFS: Index snapshot '%s' is corrupt", fileName);
+        MemFree(data);
+        return 0;
+    }
+    return data;
+}
+
+/**
+ * Adds the paths from a snapshot read with ReadPhysFSIndexSnapshot(), which a mount added to the index. Requires the index mutex.
+ *
+ * @internal
+ */
+void AddPhysFSIndexSnapshot(const unsigned char* data, unsigned int count, int mount) {
+    long position = PHYSFS_INDEX_SNAPSHOT_HEADER_SIZE;
+    for (unsigned int i = 0; i < count; i++) {
+        const unsigned char* entry = data + position;
+        PHYSFS_Stat stat;
+        stat.filetype = (PHYSFS_FileType)entry[2];
+        stat.readonly = entry[3];
+        stat.filesize = (PHYSFS_sint64)ReadPhysFSUInt64(entry + 4);
+        stat.modtime = (PHYSFS_sint64)ReadPhysFSUInt64(entry + 12);
+        stat.createtime = (PHYSFS_sint64)ReadPhysFSUInt64(entry + 20);
+        stat.accesstime = (PHYSFS_sint64)ReadPhysFSUInt64(entry + 28);
+        const char* path = (const char*)(entry + PHYSFS_INDEX_SNAPSHOT_ENTRY_SIZE);
+        unsigned int hash = HashPhysFSString(path);
+        if (FindInPhysFSHashMap(&physfsIndexMap, path, hash) == -1) {
+            AddPhysFSIndexEntry(path, hash, mount, &stat);
+        }
+        position += PHYSFS_INDEX_SNAPSHOT_ENTRY_SIZE + ReadPhysFSUInt16(entry) + 1;
+    }
+}
+
+/**
+ * Builds the index snapshot with the given key, from the paths a mount added to the index. Requires the index mutex.
+ *
+ * The file starts with "RPIX", the format version, the key as a 64-bit integer, and the amount of
+ * paths. Each path follows as its 16-bit length, its file type and whether it's read-only as bytes,
+ * its size and modification, creation and access times as 64-bit integers, and its characters
+ * ending with a '\0'. Integers are little-endian.
+ *
+ * @param size Where to save the size of the snapshot, in bytes.
+ *
+ * @return The snapshot's data, or 0 on failure. Free it with MemFree().
+ *
+ * @internal
+ */
+unsigned char* BuildPhysFSIndexSnapshot(unsigned long long key, int mount, long* size) {
+    unsigned int count = 0;
+    *size = PHYSFS_INDEX_SNAPSHOT_HEADER_SIZE;
+    for (int i = 0; i < physfsIndexEntryCount; i++) {
+        PhysFSIndexEntry* entry = &physfsIndexEntries[i];
+        if (entry->path != 0 && entry->mount == mount && TextLength(entry->path) <= 0xFFFF) {
+            count++;
+            *size += PHYSFS_INDEX_SNAPSHOT_ENTRY_SIZE + (long)TextLength(entry->path) + 1;
+        }
+    }
+    unsigned char* data = (unsigned char*)MemAlloc((unsigned int)*size);
+    if (data == 0) {
+        return 0;
+    }
+
+    data[0] = 'R';
+    data[1] = 'P';
+    data[2] = 'I';
+    data[3] = 'X';
+    WritePhysFSUInt(data + 4, PHYSFS_INDEX_SNAPSHOT_VERSION, 4);
+    WritePhysFSUInt(data + 8, key, 8);
+    WritePhysFSUInt(data + 16, count, 4);
+    unsigned char* position = data + PHYSFS_INDEX_SNAPSHOT_HEADER_SIZE;
+    for (int i = 0; i < physfsIndexEntryCount; i++) {
+        PhysFSIndexEntry* entry = &physfsIndexEntries[i];
+        unsigned int length = entry->path != 0 ? TextLength(entry->path) : 0;
+        if (entry->path == 0 || entry->mount != mount || length > 0xFFFF) {
+            continue;
+        }
+        WritePhysFSUInt(position, length, 2);
+        position[2] = (unsigned char)entry->stat.filetype;
+        position[3] = entry->stat.readonly != 0 ? 1 : 0;
+        WritePhysFSUInt(position + 4, (unsigned long long)entry->stat.filesize, 8);
+        WritePhysFSUInt(position + 12, (unsigned long long)entry->stat.modtime, 8);
+        WritePhysFSUInt(position + 20, (unsigned long long)entry->stat.createtime, 8);
+        WritePhysFSUInt(position + 28, (unsigned long long)entry->stat.accesstime, 8);
+        for (unsigned int j = 0; j <= length; j++) {
+            position[PHYSFS_INDEX_SNAPSHOT_ENTRY_SIZE + j] = (unsigned char)entry->path[j];
+        }
+        position += PHYSFS_INDEX_SNAPSHOT_ENTRY_SIZE + length + 1;
+    }
+    return data;
+}
+
+/**
+ * Removes the oldest index snapshots in the given directory, until at most RAYLIB_PHYSFS_INDEX_SNAPSHOTS are left.
+ *
+ * Snapshots of archives that changed, or that are mounted in another order, are never read again,
+ * so they'd pile up otherwise.
+ *
+ * @param keep The snapshot that was just saved, which is always kept.
+ *
+ * @internal
+ */
+void PrunePhysFSIndexSnapshots(const char* dirPath, const char* keep) {
+    FilePathList files = LoadDirectoryFilesEx(dirPath, ".rpidx", false);
+    long* modTimes = files.count > 0 ? (long*)MemAlloc(sizeof(long) * files.count) : 0;
+    if (modTimes != 0) {
+        int count = (int)files.count;
+        for (unsigned int i = 0; i < files.count; i++) {
+            modTimes[i] = TextIsEqual(GetFileName(files.paths[i]), GetFileName(keep)) ? -1 : GetFileModTime(files.paths[i]);
+        }
+        while (count > RAYLIB_PHYSFS_INDEX_SNAPSHOTS) {
+            int oldest = -1;
+            for (unsigned int i = 0; i < files.count; i++) {
+                if (modTimes[i] >= 0 && (oldest == -1 || modTimes[i] < modTimes[oldest])) {
+                    oldest = (int)i;
+                }
+            }
+            if (oldest == -1) {
+                break;
+            }
+            remove(files.paths[oldest]);
+            TraceLog(LOG_DEBUG, "PHYSFS: Removed old index snapshot '%s'", files.paths[oldest]);
+            modTimes[oldest] = -1;
+            count--;
+        }
+        MemFree(modTimes);
+    }
+    UnloadDirectoryFiles(files);
+}
+
+/**
+ * Saves an index snapshot built with BuildPhysFSIndexSnapshot(), and prunes old ones from its directory.
+ *
+ * @internal
+ */
+void SavePhysFSIndexSnapshot(const char* dirPath, const char* fileName, const unsigned char* data, long size) {
+    // Write it under another name first, so that a snapshot is never read half written.
+    char* temporaryFileName = FormatPhysFSString("%s.tmp", fileName);
+    bool output = false;
+    if (temporaryFileName != 0) {
+        FILE* file = fopen(temporaryFileName, "wb");
+        if (file != 0) {
+            output = fwrite(data, 1, (size_t)size, file) == (size_t)size;
+            output = fclose(file) == 0 && output;
+            output = output && rename(temporaryFileName, fileName) == 0;
+            if (!output) {
+                remove(temporaryFileName);
+            }
+        }
+    }
+    if (output) {
+        TraceLog(LOG_DEBUG, "PHYSFS: Saved %u paths to index snapshot '%s'", ReadPhysFSUInt32(data + 16), fileName);
+        PrunePhysFSIndexSnapshots(dirPath, fileName);
+    } else {
+        TraceLog(LOG_WARNING, "PHYSFS: Failed to save index snapshot '%s'", fileName);
+    }
+    MemFree(temporaryFileName);
+}
+
+/**
+ * Adds the paths of a newly mounted directory or archive to the index.
+ *
+ * Archives mounted from disk, after indexing was enabled with nothing mounted, are added from an
+ * index snapshot when there is one, and saved to one otherwise. Directories and memory mounts
+ * can't be fingerprinted, so the first one of them ends snapshots for every mount after it. The
+ * snapshot is read and written without holding the index mutex.
+ *
+ * PhysFS can only list the merged search path, not a single archive, so without a snapshot this
+ * walks every directory below the mount point, including those of earlier mounts. Paths that are
+ * already indexed keep their entry without being looked up again, but mounting many archives at
+ * the same mount point, like the root, still walks the directories that are there each time.
+ *
+ * @param snapshot Whether the mount can be snapshotted, which memory mounts can't.
+ *
+ * @internal
+ */
+void AddPhysFSIndexMount(const char* newDir, const char* mountPoint, bool snapshot) {
+    if (!LoadPhysFSAtomicInt(physfsIndexing)) {
+        return;
+    }
+
+    // Fingerprinting reads from the disk, so it happens before taking the lock.
+    unsigned char fingerprint[16];
+    snapshot = snapshot && GetPhysFSIndexSnapshotFingerprint(newDir, fingerprint);
+
+    LockPhysFSMutex(physfsIndexMutex);
+    char* path = physfsIndexing ? CopyPhysFSString(mountPoint != 0 ? mountPoint : "") : 0;
+    if (path == 0) {
+        UnlockPhysFSMutex(physfsIndexMutex);
+        return;
+    }
+
+    // Only the tree below the mount point can change, along with the directories leading to it.
+    int mount = GetPhysFSIndexMount(newDir);
+    char* start = path;
+    while (*start == '/') {
+        start++;
+    }
+    int length = (int)TextLength(start);
+    while (length > 0 && start[length - 1] == '/') {
+        start[--length] = '\0';
+    }
+
+    for (int i = 0; i <= length; i++) {
+        if (i > 0 && (start[i] == '/' || start[i] == '\0')) {
+            char separator = start[i];
+            start[i] = '\0';
+            AddPhysFSIndexPath(start, mount);
+            start[i] = separator;
+        }
+    }
+
+    // Snapshots are keyed by everything mounted before, as that decides which paths are new.
+    physfsIndexSnapshotKeyValid = physfsIndexSnapshotKeyValid && snapshot && physfsIndexSnapshotDirectory != 0;
+    unsigned long long key = 0;
+    char* dirPath = 0;
+    char* fileName = 0;
+    if (physfsIndexSnapshotKeyValid) {
+        AddPhysFSIndexSnapshotKey(&physfsIndexSnapshotKey, newDir, start, fingerprint);
+        key = physfsIndexSnapshotKey;
+        dirPath = CopyPhysFSString(physfsIndexSnapshotDirectory);
+        fileName = GetPhysFSIndexSnapshotPath(key);
+    }
+    UnlockPhysFSMutex(physfsIndexMutex);
+
+    unsigned int count = 0;
+    unsigned char* data = fileName != 0 ? ReadPhysFSIndexSnapshot(fileName, key, &count) : 0;
+    long size = 0;
+
+    // Indexing may have been disabled, or something else mounted, while the snapshot was read.
+    LockPhysFSMutex(physfsIndexMutex);
+    bool current = physfsIndexing && physfsIndexSnapshotKeyValid && physfsIndexSnapshotKey == key && fileName != 0 && dirPath != 0;
+    bool added = data != 0 && current;
+    if (added) {
+        AddPhysFSIndexSnapshot(data, count, mount);
+        TraceLog(LOG_DEBUG, "PHYSFS: Loaded %u paths from index snapshot '%s'", count, fileName);
+    }
+    MemFree(data);
+    data = 0;
+    if (physfsIndexing && !added) {
+        AddPhysFSIndexDirectory(start, mount);
+        if (current) {
+            data = BuildPhysFSIndexSnapshot(key, mount, &size);
+        }
+    }
+    UnlockPhysFSMutex(physfsIndexMutex);
+
+    if (data != 0) {
+        SavePhysFSIndexSnapshot(dirPath, fileName, data, size);
+        MemFree(data);
+    }
+    MemFree(fileName);
+    MemFree(dirPath);
+    MemFree(path);
+}
+
+/**
+ * Resolves the paths of an unmounted directory or archive again, removing those that no longer exist.
+ *
+ * @internal
+ */
+void RemovePhysFSIndexMount(const char* oldDir) {
+    LockPhysFSMutex(physfsIndexMutex);
+    if (!physfsIndexing) {
+        UnlockPhysFSMutex(physfsIndexMutex);
+        return;
+    }
+
+    int mount = -1;
+    for (int i = 0; i < physfsIndexMountCount; i++) {
+        if (physfsIndexMounts[i] != 0 && TextIsEqual(physfsIndexMounts[i], oldDir)) {
+            mount = i;
+            break;
+        }
+    }
+
+    // Paths of unknown mounts, like directories that only exist as mount points, are resolved again too.
+    for (int i = 0; i < physfsIndexEntryCount; i++) {
+        if (physfsIndexEntries[i].path != 0 && (physfsIndexEntries[i].mount == mount || physfsIndexEntries[i].mount == -1)) {
+            ResolvePhysFSIndexEntry(i);
+        }
+    }
+    if (mount != -1) {
+        MemFree(physfsIndexMounts[mount]);
+        physfsIndexMounts[mount] = 0;
+    }
+
+    // The unmount decides which paths later mounts add, so it's part of their snapshot key.
+    if (physfsIndexSnapshotKeyValid) {
+        physfsIndexSnapshotKey = HashPhysFSIndexSnapshotKey(physfsIndexSnapshotKey, "-", 1);
+        physfsIndexSnapshotKey = HashPhysFSIndexSnapshotKey(physfsIndexSnapshotKey, oldDir, (int)TextLength(oldDir) + 1);
+    }
+    UnlockPhysFSMutex(physfsIndexMutex);
+}
+
+/**
+ * Resolves the given path and the directories leading to it again, or adds them if they're new. Requires the index mutex.
+ *
+ * @internal
+ */
+void ResolvePhysFSIndexPath(char* path) {
+    for (int i = 0; ; i++) {
+        if (i > 0 && (path[i] == '/' || path[i] == '\0')) {
+            char separator = path[i];
+            path[i] = '\0';
+            int index = FindInPhysFSHashMap(&physfsIndexMap, path, HashPhysFSString(path));
+            if (index != -1) {
+                ResolvePhysFSIndexEntry(index);
+            } else {
+                AddPhysFSIndexPath(path, -1);
+            }
+            path[i] = separator;
+        }
+        if (path[i] == '\0') {
+            return;
+        }
+    }
+}
+
+/**
+ * Indexes a file saved in the write directory, wherever the write directory, or a directory within it, is mounted.
+ *
+ * Where the write directory appears in the search path isn't known, so the file is looked up
+ * under each mount point, along with the paths it would have if a directory it's in was mounted.
+ *
+ * @internal
+ */
+void UpdatePhysFSIndexPath(const char* fileName) {
+    LockPhysFSMutex(physfsIndexMutex);
+    if (!physfsIndexing) {
+        UnlockPhysFSMutex(physfsIndexMutex);
+        return;
+    }
+
+    while (*fileName == '/') {
+        fileName++;
+    }
+    char** searchPath = IsPhysFSIndexPath(fileName) ? PHYSFS_getSearchPath() : 0;
+    for (char** i = searchPath; i != 0 && *i != 0; i++) {
+        const char* mountPoint = PHYSFS_getMountPoint(*i);
+        if (mountPoint == 0) {
+            continue;
+        }
+        while (*mountPoint == '/') {
+            mountPoint++;
+        }
+        int length = (int)TextLength(mountPoint);
+        while (length > 0 && mountPoint[length - 1] == '/') {
+            length--;
+        }
+        for (const char* name = fileName; name != 0; name = strchr(name, '/')) {
+            while (*name == '/') {
+                name++;
+            }
+            char* path = length == 0 ? CopyPhysFSString(name) : FormatPhysFSString("%.*s/%s", length, mountPoint, name);
+            if (path != 0) {
+                ResolvePhysFSIndexPath(path);
+                MemFree(path);
+            }
+        }
+    }
+    PHYSFS_freeList(searchPath);
+    UnlockPhysFSMutex(physfsIndexMutex);
+}
+
+#ifdef RAYLIB_PHYSFS_MMAP
+/**
+ * Reads the given range of a file.
+ *
+ * @return True if the whole range was read, false otherwise.
+ *
+ * @internal
+ */
+bool ReadPhysFSFileRange(int fd, unsigned char* data, long long size, long long offset) {
+    while (size > 0) {
+        ssize_t count = pread(fd, data, (size_t)size, (off_t)offset);
+        if (count <= 0) {
+            return false;
+        }
+        data += count;
+        size -= count;
+        offset += count;
+    }
+    return true;
+}
+
+/**
+ * Frees the entries read with LoadPhysFSZipData().
+ *
+ * @internal
+ */
+void UnloadPhysFSZipData(PhysFSZipData* zip) {
+    UnloadPhysFSHashMap(&zip->entryMap);
+    MemFree(zip->entries);
+    MemFree(zip->names);
+    MemFree(zip->name);
+    MemFree(zip);
+}
+
+/**
+ * Reads the entries of a ZIP archive from its central directory, without reading the rest of the archive.
+ *
+ * @param archivePath The ZIP archive, in platform-dependent notation.
+ *
+ * @return The entries, which are empty if it isn't a ZIP archive. 0 on failure.
+ *
+ * @internal
+ */
+PhysFSZipData* LoadPhysFSZipData(const char* archivePath) {
+    PhysFSZipData* zip = (PhysFSZipData*)MemAlloc(sizeof(PhysFSZipData));
+    if (zip == 0) {
+        return 0;
+    }
+    zip->name = CopyPhysFSString(archivePath);
+    if (zip->name == 0) {
+        MemFree(zip);
+        return 0;
+    }
+
+    int fd = open(archivePath, O_RDONLY);
+    if (fd == -1) {
+        return zip;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size < 22) {
+        close(fd);
+        return zip;
+    }
+    zip->size = (long long)info.st_size;
+
+    // Find the end of central directory record, which may be followed by a comment.
+    long long tailSize = zip->size < 22 + 65535 ? zip->size : 22 + 65535;
+    long long tailOffset = zip->size - tailSize;
+    unsigned char* tail = (unsigned char*)MemAlloc((unsigned int)tailSize);
+    long long end = -1;
+    if (tail != 0 && ReadPhysFSFileRange(fd, tail, tailSize, tailOffset)) {
+        for (long long i = tailSize - 22; i >= 0; i--) {
+            if (ReadPhysFSUInt32(tail + i) == 0x06054b50) {
+                end = i;
+                break;
+            }
+        }
+    }
+    unsigned int entryCount = 0;
+    long long directorySize = 0;
+    long long directoryOffset = 0;
+    if (end >= 0) {
+        entryCount = ReadPhysFSUInt16(tail + end + 10);
+        directorySize = ReadPhysFSUInt32(tail + end + 12);
+        directoryOffset = ReadPhysFSUInt32(tail + end + 16);
+        end += tailOffset;
+    }
+    MemFree(tail);
+
+    // Account for data prepended to the archive, like self-extracting executables.
+    long long adjust = end - directoryOffset - directorySize;
+    unsigned char* directory = 0;
+    if (end >= 0 && adjust >= 0 && entryCount > 0) {
+        directory = (unsigned char*)MemAlloc((unsigned int)directorySize);
+        zip->entries = (PhysFSZipEntry*)MemAlloc(sizeof(PhysFSZipEntry) * entryCount);
+
+        // Each entry's record is longer than its name, so the names fit in the size of the directory.
+        zip->names = (char*)MemAlloc((unsigned int)directorySize);
+    }
+    if (directory == 0 || zip->entries == 0 || zip->names == 0 || !ReadPhysFSFileRange(fd, directory, directorySize, directoryOffset + adjust)) {
+        close(fd);
+        MemFree(directory);
+        MemFree(zip->entries);
+        MemFree(zip->names);
+        zip->entries = 0;
+        zip->names = 0;
+        return zip;
+    }
+    close(fd);
+
+    long long position = 0;
+    int namesSize = 0;
+    for (unsigned int i = 0; i < entryCount; i++) {
+        if (position + 46 > directorySize || ReadPhysFSUInt32(directory + position) != 0x02014b50) {
+            break;
+        }
+        const unsigned char* record = directory + position;
+        int nameLength = (int)ReadPhysFSUInt16(record + 28);
+        int extraLength = (int)ReadPhysFSUInt16(record + 30);
+        int commentLength = (int)ReadPhysFSUInt16(record + 32);
+        if (position + 46 + nameLength > directorySize) {
+            break;
+        }
+        position += 46 + nameLength + extraLength + commentLength;
+
+        // Only the first entry with a name is found, as with PhysFS.
+        char* name = zip->names + namesSize;
+        for (int j = 0; j < nameLength; j++) {
+            name[j] = (char)record[46 + j];
+        }
+        name[nameLength] = '\0';
+        unsigned int hash = HashPhysFSString(name);
+        if (FindInPhysFSHashMap(&zip->entryMap, name, hash) != -1) {
+            continue;
+        }
+
+        // Only unencrypted, uncompressed, non-ZIP64 entries can be viewed directly.
+        PhysFSZipEntry* entry = &zip->entries[zip->entryCount];
+        unsigned int flags = ReadPhysFSUInt16(record + 8);
+        unsigned int method = ReadPhysFSUInt16(record + 10);
+        long long compressedSize = ReadPhysFSUInt32(record + 20);
+        entry->size = ReadPhysFSUInt32(record + 24);
+        entry->localOffset = (long long)ReadPhysFSUInt32(record + 42) + adjust;
+        entry->dataOffset = -1;
+        entry->stored = method == 0 && (flags & 1) == 0 && compressedSize == entry->size && entry->size != 0xFFFFFFFF && entry->localOffset + 30 <= zip->size;
+        if (!AddToPhysFSHashMap(&zip->entryMap, name, hash, zip->entryCount)) {
+            break;
+        }
+        zip->entryCount++;
+        namesSize += nameLength + 1;
+    }
+    MemFree(directory);
+    return zip;
+}
+
+/**
+ * Finds the entries of the given archive. Requires the ZIP mutex.
+ *
+ * @internal
+ */
+PhysFSZipData* FindPhysFSZipData(const char* archivePath) {
+    for (PhysFSZipData* zip = physfsZips; zip != 0; zip = zip->next) {
+        if (TextIsEqual(zip->name, archivePath)) {
+            return zip;
+        }
+    }
+    return 0;
+}
+#endif
+
+/**
+ * Reads where the entries of the given archive are, so that looking up where a file's bytes are doesn't scan the archive.
+ *
+ * @param newDir The directory or archive that was mounted, in platform-dependent notation.
+ *
+ * @internal
+ */
+void AddPhysFSZipArchive(const char* newDir) {
+#ifdef RAYLIB_PHYSFS_MMAP
+    PhysFSZipData* zip = LoadPhysFSZipData(newDir);
+    if (zip == 0) {
+        return;
+    }
+    LockPhysFSMutex(physfsZipMutex);
+    bool added = FindPhysFSZipData(newDir) == 0;
+    if (added) {
+        zip->next = physfsZips;
+        physfsZips = zip;
+    }
+    UnlockPhysFSMutex(physfsZipMutex);
+    if (!added) {
+        UnloadPhysFSZipData(zip);
+    }
+#else
+    (void)newDir;
+#endif
+}
+
+/**
+ * Forgets the entries of the given archive, once it's unmounted.
+ *
+ * @internal
+ */
+void RemovePhysFSZipArchive(const char* oldDir) {
+#ifdef RAYLIB_PHYSFS_MMAP
+    LockPhysFSMutex(physfsZipMutex);
+    for (PhysFSZipData** zip = &physfsZips; *zip != 0; zip = &(*zip)->next) {
+        if (TextIsEqual((*zip)->name, oldDir)) {
+            PhysFSZipData* removed = *zip;
+            *zip = removed->next;
+            UnloadPhysFSZipData(removed);
+            break;
+        }
+    }
+    UnlockPhysFSMutex(physfsZipMutex);
+#else
+    (void)oldDir;
+#endif
+}
+
+/**
+ * Checks whether the given path is the given directory, or within it.
+ *
+ * @param path The path, without leading or trailing slashes.
+ * @param dirPath The directory, without leading or trailing slashes. "" is the root, which holds every path.
+ *
+ * @internal
+ */
+bool IsPhysFSPathWithin(const char* path, int pathLength, const char* dirPath, int dirLength) {
+    if (dirLength == 0) {
+        return true;
+    }
+    return pathLength >= dirLength && strncmp(path, dirPath, (size_t)dirLength) == 0 && (pathLength == dirLength || path[dirLength] == '/');
+}
+
+/**
+ * Checks whether the given path needs the given lazy mount.
+ *
+ * Looking a path up needs the lazy mounts whose mount point holds it. Listing a directory, or
+ * mounting over it, also needs those within it.
+ *
+ * @param path The path, without leading or trailing slashes.
+ * @param within Whether lazy mounts within the path are needed too.
+ *
+ * @internal
+ */
+bool IsPhysFSLazyMountNeeded(const char* path, int pathLength, const PhysFSLazyMount* lazyMount, bool within) {
+    int length = (int)TextLength(lazyMount->mountPoint);
+    return IsPhysFSPathWithin(path, pathLength, lazyMount->mountPoint, length) || (within && IsPhysFSPathWithin(lazyMount->mountPoint, length, path, pathLength));
+}
+
+/**
+ * Takes every path id lock, to change the path ids, their count or their generation.
+ *
+ * Looking a path id up only takes the lock of that id, so lookups of different ids on different
+ * threads rarely wait on each other.
+ *
+ * @internal
+ */
+void LockPhysFSPathIds() {
+    for (int i = 0; i < PHYSFS_PATH_ID_LOCKS; i++) {
+        LockPhysFSMutex(physfsPathIdLocks[i]);
+    }
+}
+
+/**
+ * Releases every path id lock, taken with LockPhysFSPathIds().
+ *
+ * @internal
+ */
+void UnlockPhysFSPathIds() {
+    for (int i = PHYSFS_PATH_ID_LOCKS - 1; i >= 0; i--) {
+        UnlockPhysFSMutex(physfsPathIdLocks[i]);
+    }
+}
+
+/**
+ * Forgets what the paths interned with GetPhysFSPathId() resolved to, so that they're looked up again.
+ *
+ * @internal
+ */
+void InvalidatePhysFSPathIds() {
+    if (!IsPhysFSReady()) {
+        return;
+    }
+
+    LockPhysFSPathIds();
+    physfsPathIdGeneration++;
+    if (physfsPathIdGeneration == 0) {
+        physfsPathIdGeneration = 1;
+    }
+    UnlockPhysFSPathIds();
+}
+
+/**
+ * Finds the first lazy mount to mount for the given path. Requires the lazy mount mutex.
+ *
+ * Mounts are appended to the search path, so lazy mounts are mounted in the order they were
+ * registered. A lazy mount that's needed brings along the earlier ones whose mount points overlap
+ * it, and those that overlap them in turn, so that whichever was registered first still wins.
+ *
+ * @return The index of the lazy mount, or -1 if none are needed.
+ *
+ * @internal
+ */
+int FindPhysFSLazyMount(const char* path, int pathLength, bool within) {
+    int last = -1;
+    for (int i = physfsLazyMountCount - 1; i >= 0 && last == -1; i--) {
+        if (IsPhysFSLazyMountNeeded(path, pathLength, &physfsLazyMounts[i], within)) {
+            last = i;
+        }
+    }
+    if (last <= 0) {
+        return last;
+    }
+
+    // Without the memory to find the overlaps, mount everything before it to keep the order.
+    bool* needed = (bool*)MemAlloc(sizeof(bool) * (last + 1));
+    if (needed == 0) {
+        return 0;
+    }
+    int output = last;
+    needed[last] = true;
+    for (int i = last - 1; i >= 0; i--) {
+        needed[i] = IsPhysFSLazyMountNeeded(path, pathLength, &physfsLazyMounts[i], within);
+        for (int j = i + 1; !needed[i] && j <= last; j++) {
+            const char* mountPoint = physfsLazyMounts[j].mountPoint;
+            needed[i] = needed[j] && IsPhysFSLazyMountNeeded(mountPoint, (int)TextLength(mountPoint), &physfsLazyMounts[i], true);
+        }
+        if (needed[i]) {
+            output = i;
+        }
+    }
+    MemFree(needed);
+    return output;
+}
+
+/**
+ * Mounts the lazy mounts that the given path needs, in the order they were registered.
+ *
+ * @param within Whether to mount the lazy mounts within the path too, to list it or mount over it.
+ *
+ * @internal
+ */
+void OpenPhysFSLazyMounts(const char* path, bool within) {
+    if (path == 0 || !IsPhysFSReady()) {
+        return;
+    }
+    // Skip the lock once every lazy mount is mounted, which is the common case.
+    if (LoadPhysFSAtomicInt(physfsLazyMountCount) == 0) {
+        return;
+    }
+    while (*path == '/') {
+        path++;
+    }
+    int pathLength = (int)TextLength(path);
+    while (pathLength > 0 && path[pathLength - 1] == '/') {
+        pathLength--;
+    }
+
+    LockPhysFSMutex(physfsLazyMutex);
+    for (;;) {
+        int index = FindPhysFSLazyMount(path, pathLength, within);
+        if (index == -1) {
+            break;
+        }
+        PhysFSLazyMount* lazyMount = &physfsLazyMounts[index];
+
+        // Another thread is mounting it, so the path can't be looked up until it's done.
+        if (lazyMount->opening) {
+            WaitPhysFSCondition(physfsLazyOpened, physfsLazyMutex);
+            continue;
+        }
+
+        // Mount it without holding the lock, so that lookups that don't need it aren't held up.
+        // Mounts are appended, so files found before stay the same, and the cache is kept.
+        lazyMount->opening = true;
+        char* newDir = lazyMount->newDir;
+        char* mountPoint = lazyMount->mountPoint;
+        UnlockPhysFSMutex(physfsLazyMutex);
+        if (PHYSFS_mount(newDir, mountPoint, 1) == 0) {
+            char* detail = FormatPhysFSString("Failed to mount '%s' at '%s'", newDir, mountPoint);
+            TracePhysFSError(detail != 0 ? detail : newDir);
+            MemFree(detail);
+        } else {
+            // Files that were missing may be found now.
+            InvalidatePhysFSPathIds();
+            AddPhysFSIndexMount(newDir, mountPoint, true);
+            AddPhysFSZipArchive(newDir);
+            TraceLog(LOG_DEBUG, "PHYSFS: Mounted lazy '%s' at '%s'", newDir, mountPoint);
+        }
+        LockPhysFSMutex(physfsLazyMutex);
+
+        // Other threads may have registered or removed lazy mounts in the meantime.
+        for (int i = 0; i < physfsLazyMountCount; i++) {
+            if (physfsLazyMounts[i].newDir == newDir) {
+                for (int j = i; j < physfsLazyMountCount - 1; j++) {
+                    physfsLazyMounts[j] = physfsLazyMounts[j + 1];
+                }
+                StorePhysFSAtomicInt(physfsLazyMountCount, physfsLazyMountCount - 1);
+                break;
+            }
+        }
+        MemFree(newDir);
+        MemFree(mountPoint);
+        BroadcastPhysFSCondition(physfsLazyOpened);
+    }
+    UnlockPhysFSMutex(physfsLazyMutex);
+}
+
+/**
+ * Gets the file information of a directory leading to the mount point of a lazy mount, which exists without mounting it.
+ *
+ * @return True if the path leads to a lazy mount, false otherwise.
+ *
+ * @internal
+ */
+bool GetPhysFSLazyMountParentStat(const char* path, PHYSFS_Stat* stat) {
+    if (!IsPhysFSReady() || LoadPhysFSAtomicInt(physfsLazyMountCount) == 0) {
+        return false;
+    }
+    while (*path == '/') {
+        path++;
+    }
+    int pathLength = (int)TextLength(path);
+    while (pathLength > 0 && path[pathLength - 1] == '/') {
+        pathLength--;
+    }
+
+    bool output = false;
+    LockPhysFSMutex(physfsLazyMutex);
+    for (int i = 0; i < physfsLazyMountCount && !output; i++) {
+        const char* mountPoint = physfsLazyMounts[i].mountPoint;
+        output = IsPhysFSPathWithin(mountPoint, (int)TextLength(mountPoint), path, pathLength);
+    }
+    UnlockPhysFSMutex(physfsLazyMutex);
+
+    // The same information PhysFS gives the directories leading to a mount point.
+    if (output) {
+        stat->filesize = -1;
+        stat->modtime = -1;
+        stat->createtime = -1;
+        stat->accesstime = -1;
+        stat->filetype = PHYSFS_FILETYPE_DIRECTORY;
+        stat->readonly = 1;
+    }
+    return output;
+}
+
+/**
+ * Forgets the given lazy mount, if it's not mounted yet.
+ *
+ * @return True if it was waiting to be mounted, false otherwise.
+ *
+ * @internal
+ */
+bool RemovePhysFSLazyMount(const char* oldDir) {
+    bool output = false;
+    LockPhysFSMutex(physfsLazyMutex);
+    for (int i = 0; i < physfsLazyMountCount; i++) {
+        if (TextIsEqual(physfsLazyMounts[i].newDir, oldDir)) {
+            // Let a lookup finish mounting it, so that it's unmounted like any other mount.
+            if (physfsLazyMounts[i].opening) {
+                WaitPhysFSCondition(physfsLazyOpened, physfsLazyMutex);
+                i = -1;
+                continue;
+            }
+            MemFree(physfsLazyMounts[i].newDir);
+            MemFree(physfsLazyMounts[i].mountPoint);
+            for (int j = i; j < physfsLazyMountCount - 1; j++) {
+                physfsLazyMounts[j] = physfsLazyMounts[j + 1];
+            }
+            StorePhysFSAtomicInt(physfsLazyMountCount, physfsLazyMountCount - 1);
+            output = true;
+            break;
+        }
+    }
+    UnlockPhysFSMutex(physfsLazyMutex);
+    return output;
+}
+
+/**
+ * Gets the file information of the given path, from the index while it's enabled.
+ *
+ * @return True if the path exists, false otherwise.
+ *
+ * @internal
+ */
+bool GetPhysFSPathStat(const char* path, PHYSFS_Stat* stat) {
+    if (path == 0) {
+        return false;
+    }
+
+    if (IsPhysFSReady()) {
+        OpenPhysFSLazyMounts(path, false);
+
+        // Indexing is checked again under the lock, in case it was disabled in between.
+        if (LoadPhysFSAtomicInt(physfsIndexing)) {
+            LockPhysFSMutex(physfsIndexMutex);
+            if (physfsIndexing) {
+                const char* key = path;
+                while (*key == '/') {
+                    key++;
+                }
+                if (key[0] != '\0' && IsPhysFSIndexPath(key)) {
+                    // The index holds every path, so a path that's not in it doesn't exist.
+                    int index = FindInPhysFSHashMap(&physfsIndexMap, key, HashPhysFSString(key));
+                    if (index != -1) {
+                        *stat = physfsIndexEntries[index].stat;
+                    }
+                    UnlockPhysFSMutex(physfsIndexMutex);
+                    return index != -1 || GetPhysFSLazyMountParentStat(path, stat);
+                }
+            }
+            UnlockPhysFSMutex(physfsIndexMutex);
+        }
+    }
+    return PHYSFS_stat(path, stat) != 0 || GetPhysFSLazyMountParentStat(path, stat);
+}
+
+/**
+ * Checks whether the given path is a regular file, without counting it as a FileExistsInPhysFS() call.
+ *
+ * @internal
+ */
+bool IsPhysFSFile(const char* fileName) {
+    PHYSFS_Stat stat;
+    if (!GetPhysFSPathStat(fileName, &stat)) {
+        return false;
+    }
+    return stat.filetype == PHYSFS_FILETYPE_REGULAR;
+}
+
+/**
+ * Gets the directory or archive that the index resolves the given path to.
+ *
+ * @param mount Where to save the directory or archive, as it was mounted.
+ * @param mountSize The size of the mount buffer.
+ *
+ * @return True if the path is indexed and its mount is known, false otherwise.
+ *
+ * @internal
+ */
+bool GetPhysFSIndexPathMount(const char* path, char* mount, int mountSize) {
+    if (path == 0 || !LoadPhysFSAtomicInt(physfsIndexing)) {
+        return false;
+    }
+    while (*path == '/') {
+        path++;
+    }
+
+    bool output = false;
+    LockPhysFSMutex(physfsIndexMutex);
+    int index = physfsIndexing ? FindInPhysFSHashMap(&physfsIndexMap, path, HashPhysFSString(path)) : -1;
+    int mountIndex = index != -1 ? physfsIndexEntries[index].mount : -1;
+    if (mountIndex != -1 && physfsIndexMounts[mountIndex] != 0) {
+        const char* name = physfsIndexMounts[mountIndex];
+        int length = 0;
+        while (name[length] != '\0' && length < mountSize - 1) {
+            mount[length] = name[length];
+            length++;
+        }
+        mount[length] = '\0';
+        output = true;
+    }
+    UnlockPhysFSMutex(physfsIndexMutex);
+    return output;
+}
+
+/**
+ * Gets the file information of a path interned with GetPhysFSPathId(), looking it up again only
+ * after something was mounted, unmounted or saved.
+ *
+ * @param path Where to save the interned path, which is kept until ClosePhysFS(), or 0 if the id is unknown.
+ *
+ * @return True if the path exists, false otherwise.
+ *
+ * @internal
+ */
+bool GetPhysFSPathIdStat(int pathId, PHYSFS_Stat* stat, const char** path) {
+    *path = 0;
+    if (!IsPhysFSReady()) {
+        return false;
+    }
+
+    if (pathId <= 0) {
+        TraceLog(LOG_WARNING, "PHYSFS: Unknown path id %i", pathId);
+        return false;
+    }
+    PhysFSMutex* lock = &physfsPathIdLocks[pathId % PHYSFS_PATH_ID_LOCKS];
+    LockPhysFSMutex(*lock);
+    if (pathId > physfsPathIdCount) {
+        UnlockPhysFSMutex(*lock);
+        TraceLog(LOG_WARNING, "PHYSFS: Unknown path id %i", pathId);
+        return false;
+    }
+    PhysFSPathId* entry = &physfsPathIds[pathId - 1];
+    *path = entry->path;
+    if (entry->generation == physfsPathIdGeneration) {
+        bool exists = entry->exists;
+        *stat = entry->stat;
+        UnlockPhysFSMutex(*lock);
+        return exists;
+    }
+
+    // The entries may move while the lock isn't held, but the path they point to doesn't.
+    unsigned int generation = physfsPathIdGeneration;
+    UnlockPhysFSMutex(*lock);
+
+    PHYSFS_Stat found = { 0 };
+    bool exists = GetPhysFSPathStat(*path, &found);
+
+    // Only keep the result if nothing changed while looking it up.
+    LockPhysFSMutex(*lock);
+    if (generation == physfsPathIdGeneration) {
+        entry = &physfsPathIds[pathId - 1];
+        entry->exists = exists;
+        entry->stat = found;
+        entry->generation = generation;
+    }
+    UnlockPhysFSMutex(*lock);
+
+    if (exists) {
+        *stat = found;
+    }
+    return exists;
+}
+
+/**
+ * Gets the size of the given file in PhysFS.
+ *
+ * @return The size in bytes, or 0 if the file does not exist.
+ *
+ * @internal
+ */
+int GetPhysFSFileLength(const char* fileName) {
+    PHYSFS_Stat stat;
+    if (!GetPhysFSPathStat(fileName, &stat) || stat.filesize < 0) {
+        return 0;
+    }
+    return (int)stat.filesize;
+}
+
+/**
+ * Sets whether to keep an index of every path in the search path.
+ *
+ * Without the index, FileExistsInPhysFS(), DirectoryExistsInPhysFS(), GetFileModTimeFromPhysFS()
+ * and the loaders ask each mounted directory and archive in turn, until one of them has the path.
+ * The index maps each path to the mount it resolves to and its file information, so looking a
+ * path up is a single hash lookup, whether it exists or not. Enabling it indexes everything that
+ * is mounted. MountPhysFS() and UnmountPhysFS() then only index the paths they change, and saved
+ * files are indexed as they're written. Mounting or writing through PhysFS directly bypasses the index.
+ *
+ * Each mount walks the directories below its mount point, as PhysFS can't list a single archive, so
+ * mounting many archives at the root costs a walk of every indexed directory per mount. Index snapshots
+ * skip that walk for archives mounted from disk.
+ *
+ * @param enabled Whether to index paths. Disabled by default.
+ *
+ * @see MountPhysFS()
+ * @see FileExistsInPhysFS()
+ * @see SetPhysFSIndexSnapshotDirectory()
+ */
+void SetPhysFSIndexing(bool enabled) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot set indexing before InitPhysFS()");
+        return;
+    }
+
+    LockPhysFSMutex(physfsIndexMutex);
+    if (enabled && !physfsIndexing) {
+        AddPhysFSIndexDirectory("", -1);
+        TraceLog(LOG_DEBUG, "PHYSFS: Indexed %i paths", physfsIndexMap.count);
+
+        // Snapshots start from an empty search path, so that their key covers everything mounted.
+        char** searchPath = PHYSFS_getSearchPath();
+        physfsIndexSnapshotKey = 14695981039346656037ULL;
+        physfsIndexSnapshotKeyValid = searchPath != 0 && searchPath[0] == 0;
+        PHYSFS_freeList(searchPath);
+    } else if (!enabled) {
+        UnloadPhysFSIndex();
+        physfsIndexSnapshotKeyValid = false;
+    }
+    StorePhysFSAtomicInt(physfsIndexing, enabled ? 1 : 0);
+    UnlockPhysFSMutex(physfsIndexMutex);
+}
+
+/**
+ * Set a directory to keep snapshots of the index in, so that mounting the same archives again skips indexing them.
+ *
+ * While indexing is enabled, every archive that's mounted adds its paths to the index. When
+ * indexing was enabled before anything was mounted, the paths each archive adds are saved to the
+ * given directory, along with the size and modification time of the archives mounted and unmounted
+ * so far. The next time the same archives are mounted and unmounted in the same order, each one's
+ * paths are read from its snapshot instead of walking the archive's directories. The paths are still
+ * copied into the index, so this saves the walk, not the cost of building the index.
+ *
+ * Directories and memory mounts are always indexed in full, and as their contents can't be
+ * fingerprinted, the first one mounted stops snapshots for every archive mounted after it, until
+ * indexing is enabled again. Mount them after the archives to keep snapshots for every archive. Only
+ * the newest RAYLIB_PHYSFS_INDEX_SNAPSHOTS snapshots are kept in the directory.
+ *
+ * @param dirPath The directory to keep snapshots in, like the one from GetPerfDirectory(). 0 to disable snapshots.
+ *
+ * @see SetPhysFSIndexing()
+ */
+void SetPhysFSIndexSnapshotDirectory(const char* dirPath) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot set the index snapshot directory before InitPhysFS()");
+        return;
+    }
+
+    LockPhysFSMutex(physfsIndexMutex);
+    MemFree(physfsIndexSnapshotDirectory);
+    physfsIndexSnapshotDirectory = dirPath != 0 ? CopyPhysFSString(dirPath) : 0;
+    UnlockPhysFSMutex(physfsIndexMutex);
+}
+
+#ifdef RAYLIB_PHYSFS_STATS
+/**
+ * Copies a string into a fixed size buffer, cutting it short if needed.
+ *
+ * @internal
+ */
+void CopyPhysFSStatsString(char* destination, const char* source, int size) {
+    int i = 0;
+    while (i < size - 1 && source[i] != '\0') {
+        destination[i] = source[i];
+        i++;
+    }
+    destination[i] = '\0';
+}
+
+/**
+ * Adds a call to the given counters.
+ *
+ * @param phases The time spent in each phase, in milliseconds. Phases the call didn't have are 0.
+ *
+ * @internal
+ */
+void AddPhysFSStatsCall(PhysFSStatsCounters* counters, const double* phases, long long bytesRead, long long bytesWritten, bool failed) {
+    counters->calls++;
+    if (failed) {
+        counters->failures++;
+    }
+    counters->bytesRead += (unsigned long long)bytesRead;
+    counters->bytesWritten += (unsigned long long)bytesWritten;
+    for (int phase = 0; phase < PHYSFS_STATS_PHASE_COUNT; phase++) {
+        if (phases[phase] <= 0.0) {
+            continue;
+        }
+        counters->milliseconds[phase] += phases[phase];
+
+        // Bucket i counts times under 2^i microseconds.
+        double microseconds = phases[phase] * 1000.0;
+        int bucket = 0;
+        while (bucket < PHYSFS_STATS_HISTOGRAM_SIZE - 1 && microseconds >= (double)(1u << bucket)) {
+            bucket++;
+        }
+        counters->histogram[phase][bucket]++;
+    }
+}
+
+/**
+ * Adds the given counters to another set of counters.
+ *
+ * @internal
+ */
+void AddPhysFSStatsCounters(PhysFSStatsCounters* counters, const PhysFSStatsCounters* other) {
+    counters->calls += other->calls;
+    counters->failures += other->failures;
+    counters->bytesRead += other->bytesRead;
+    counters->bytesWritten += other->bytesWritten;
+    for (int phase = 0; phase < PHYSFS_STATS_PHASE_COUNT; phase++) {
+        counters->milliseconds[phase] += other->milliseconds[phase];
+        for (int bucket = 0; bucket < PHYSFS_STATS_HISTOGRAM_SIZE; bucket++) {
+            counters->histogram[phase][bucket] += other->histogram[phase][bucket];
+        }
+    }
+}
+
+/**
+ * Finds the counters of the given mount, adding them if there's room.
+ *
+ * @param hashes The hashes of the mounts in the statistics, which are compared before their names.
+ * @param hash HashPhysFSString() of the mount.
+ *
+ * @return The counters, or 0 when there are already RAYLIB_PHYSFS_STATS_MOUNTS mounts.
+ *
+ * @internal
+ */
+PhysFSStatsCounters* GetPhysFSMountStats(PhysFSStats* stats, unsigned int* hashes, const char* mount, unsigned int hash) {
+    for (int i = 0; i < stats->mountCount; i++) {
+        if (hashes[i] == hash && TextIsEqual(stats->mounts[i].mount, mount)) {
+            return &stats->mounts[i].counters;
+        }
+    }
+    if (stats->mountCount == RAYLIB_PHYSFS_STATS_MOUNTS) {
+        return 0;
+    }
+
+    hashes[stats->mountCount] = hash;
+    PhysFSMountStats* output = &stats->mounts[stats->mountCount++];
+    CopyPhysFSStatsString(output->mount, mount, sizeof(output->mount));
+    return &output->counters;
+}
+
+/**
+ * Adds a call to the list of slowest calls, if it's slow enough.
+ *
+ * @internal
+ */
+void AddPhysFSSlowCall(PhysFSStats* stats, const char* fileName, PhysFSStatsApi api, double milliseconds) {
+    int position = stats->slowestCount;
+    while (position > 0 && stats->slowest[position - 1].milliseconds < milliseconds) {
+        position--;
+    }
+    if (position >= RAYLIB_PHYSFS_STATS_SLOWEST) {
+        return;
+    }
+
+    int last = stats->slowestCount < RAYLIB_PHYSFS_STATS_SLOWEST ? stats->slowestCount : RAYLIB_PHYSFS_STATS_SLOWEST - 1;
+    for (int i = last; i > position; i--) {
+        stats->slowest[i] = stats->slowest[i - 1];
+    }
+    CopyPhysFSStatsString(stats->slowest[position].fileName, fileName, sizeof(stats->slowest[position].fileName));
+    stats->slowest[position].api = api;
+    stats->slowest[position].milliseconds = milliseconds;
+    if (stats->slowestCount < RAYLIB_PHYSFS_STATS_SLOWEST) {
+        stats->slowestCount++;
+    }
+}
+
+/**
+ * Gets the statistics of the calling thread, creating them on first use.
+ *
+ * @internal
+ */
+PhysFSStatsThread* GetPhysFSStatsThread() {
+    if (physfsStatsThread != 0 && physfsStatsThreadGeneration == physfsStatsGeneration) {
+        return physfsStatsThread;
+    }
+
+    PhysFSStatsThread* thread = (PhysFSStatsThread*)MemAlloc(sizeof(PhysFSStatsThread));
+    if (thread == 0) {
+        return 0;
+    }
+    InitPhysFSMutex(thread->mutex);
+    LockPhysFSMutex(physfsStatsMutex);
+    thread->next = physfsStatsThreads;
+    physfsStatsThreads = thread;
+    UnlockPhysFSMutex(physfsStatsMutex);
+
+    physfsStatsThread = thread;
+    physfsStatsThreadGeneration = physfsStatsGeneration;
+    return thread;
+}
+
+/**
+ * Records a call in the statistics of the calling thread.
+ *
+ * @param openTime The time spent finding and opening the file, in milliseconds.
+ * @param readTime The time spent reading or writing the file, in milliseconds.
+ * @param decodeTime The time spent decoding the file, in milliseconds.
+ *
+ * @internal
+ */
+void RecordPhysFSStatsCall(PhysFSStatsApi api, const char* fileName, double openTime, double readTime, double decodeTime, long long bytesRead, long long bytesWritten, bool failed) {
+    PhysFSStatsThread* thread = GetPhysFSStatsThread();
+    if (thread == 0) {
+        return;
+    }
+
+    // File reads and writes also count against the mount they went through. Reads only know their
+    // mount through the index, as asking PhysFS would search the whole search path again.
+    char mount[256];
+    bool counted = false;
+    if (api == PHYSFS_STATS_SAVE_FILE_DATA) {
+        const char* writeDir = PHYSFS_getWriteDir();
+        if (writeDir != 0) {
+            CopyPhysFSStatsString(mount, writeDir, sizeof(mount));
+            counted = true;
+        }
+    } else if ((api == PHYSFS_STATS_LOAD_FILE_DATA || api == PHYSFS_STATS_MAP_FILE_VIEW) && !failed) {
+        counted = GetPhysFSIndexPathMount(fileName, mount, sizeof(mount));
+    }
+    unsigned int mountHash = counted ? HashPhysFSString(mount) : 0;
+
+    double phases[PHYSFS_STATS_PHASE_COUNT] = { openTime, readTime, decodeTime };
+    LockPhysFSMutex(thread->mutex);
+    PhysFSStats* stats = &thread->stats;
+    AddPhysFSStatsCall(&stats->apis[api], phases, bytesRead, bytesWritten, failed);
+    PhysFSStatsCounters* mountStats = counted ? GetPhysFSMountStats(stats, thread->mountHashes, mount, mountHash) : 0;
+    if (mountStats != 0) {
+        AddPhysFSStatsCall(mountStats, phases, bytesRead, bytesWritten, failed);
+    }
+    AddPhysFSSlowCall(stats, fileName, api, openTime + readTime + decodeTime);
+    UnlockPhysFSMutex(thread->mutex);
+}
+#endif
+
+/**
+ * Get the statistics of the I/O through raylib-physfs, added up across all threads.
+ *
+ * Statistics are only collected when RAYLIB_PHYSFS_STATS is defined. Each thread counts its own
+ * calls without waiting on other threads, so collecting them is cheap enough to leave on. Without
+ * RAYLIB_PHYSFS_STATS, the counting compiles out, and the statistics are always empty.
+ *
+ * MapFileViewFromPhysFS() counts the views that were mapped or served from the cache. Views that
+ * fall back to copying the file count as LoadFileDataFromPhysFS() instead. Loaders that decode
+ * files count the file's reading as their read phase, as well as counting it under
+ * LoadFileDataFromPhysFS().
+ *
+ * Saves count against the write directory. Reads count against the mount they were read from only
+ * while SetPhysFSIndexing() is enabled, as only the index knows it without searching the search path
+ * again. Each of those reads takes the index mutex briefly to look it up. Without indexing, reads
+ * aren't counted against any mount, and looking them up costs nothing.
+ *
+ * @return The statistics.
+ *
+ * @see ResetPhysFSStats()
+ */
+PhysFSStats GetPhysFSStats() {
+    PhysFSStats output = { 0 };
+#ifdef RAYLIB_PHYSFS_STATS
+    if (!IsPhysFSReady()) {
+        return output;
+    }
+
+    unsigned int mountHashes[RAYLIB_PHYSFS_STATS_MOUNTS];
+    LockPhysFSMutex(physfsStatsMutex);
+    for (PhysFSStatsThread* thread = physfsStatsThreads; thread != 0; thread = thread->next) {
+        LockPhysFSMutex(thread->mutex);
+        PhysFSStats* stats = &thread->stats;
+        for (int i = 0; i < PHYSFS_STATS_API_COUNT; i++) {
+            AddPhysFSStatsCounters(&output.apis[i], &stats->apis[i]);
+        }
+        for (int i = 0; i < stats->mountCount; i++) {
+            PhysFSStatsCounters* counters = GetPhysFSMountStats(&output, mountHashes, stats->mounts[i].mount, thread->mountHashes[i]);
+            if (counters != 0) {
+                AddPhysFSStatsCounters(counters, &stats->mounts[i].counters);
+            }
+        }
+        for (int i = 0; i < stats->slowestCount; i++) {
+            AddPhysFSSlowCall(&output, stats->slowest[i].fileName, stats->slowest[i].api, stats->slowest[i].milliseconds);
+        }
+        UnlockPhysFSMutex(thread->mutex);
+    }
+    UnlockPhysFSMutex(physfsStatsMutex);
+#endif
+    return output;
+}
+
+/**
+ * Reset the I/O statistics of all threads to zero.
+ *
+ * @see GetPhysFSStats()
+ */
+void ResetPhysFSStats() {
+#ifdef RAYLIB_PHYSFS_STATS
+    if (!IsPhysFSReady()) {
+        return;
+    }
+
+    LockPhysFSMutex(physfsStatsMutex);
+    for (PhysFSStatsThread* thread = physfsStatsThreads; thread != 0; thread = thread->next) {
+        PhysFSStats empty = { 0 };
+        LockPhysFSMutex(thread->mutex);
+        thread->stats = empty;
+        UnlockPhysFSMutex(thread->mutex);
+    }
+    UnlockPhysFSMutex(physfsStatsMutex);
+#endif
+}
+
+#ifdef RAYLIB_PHYSFS_TRACE
+/**
+ * Gets the trace of the calling thread, creating it on first use.
+ *
+ * @internal
+ */
+PhysFSTraceThread* GetPhysFSTraceThread() {
+    if (physfsTraceThread != 0 && physfsTraceThreadGeneration == physfsTraceGeneration) {
+        return physfsTraceThread;
+    }
+
+    PhysFSTraceThread* thread = (PhysFSTraceThread*)MemAlloc(sizeof(PhysFSTraceThread));
+    if (thread == 0) {
+        return 0;
+    }
+    LockPhysFSMutex(physfsTraceMutex);
+    thread->id = ++physfsTraceThreadCount;
+    thread->next = physfsTraceThreads;
+    physfsTraceThreads = thread;
+    UnlockPhysFSMutex(physfsTraceMutex);
+
+    physfsTraceThread = thread;
+    physfsTraceThreadGeneration = physfsTraceGeneration;
+    return thread;
+}
+
+/**
+ * Records a call in the trace of the calling thread. The call ends now, with its phases one after
+ * the other before it.
+ *
+ * @internal
+ */
+void AddPhysFSTraceEvent(PhysFSStatsApi api, const char* fileName, double openTime, double readTime, double decodeTime, long long bytes, bool failed) {
+    PhysFSTraceThread* thread = GetPhysFSTraceThread();
+    if (thread == 0) {
+        return;
+    }
+
+    unsigned long long index = thread->eventCount;
+    PhysFSTraceEvent* event = &thread->events[index % RAYLIB_PHYSFS_TRACE_EVENTS];
+    event->startTime = GetPhysFSTime() - physfsTraceStartTime - openTime - readTime - decodeTime;
+    event->phases[PHYSFS_STATS_OPEN] = openTime;
+    event->phases[PHYSFS_STATS_READ] = readTime;
+    event->phases[PHYSFS_STATS_DECODE] = decodeTime;
+    event->bytes = bytes;
+    event->api = api;
+    event->failed = failed;
+    int i = 0;
+    for (; i < PHYSFS_TRACE_PATH_SIZE - 1 && fileName[i] != '\0'; i++) {
+        event->fileName[i] = fileName[i];
+    }
+
+    // Cut long paths before the character that doesn't fit, so that they stay valid UTF-8.
+    if (fileName[i] != '\0') {
+        while (i > 0 && ((unsigned char)fileName[i] & 0xC0) == 0x80) {
+            i--;
+        }
+    }
+    event->fileName[i] = '\0';
+    StorePhysFSAtomic(thread->eventCount, index + 1);
+}
+
+/**
+ * Writes the given text to the file.
+ *
+ * @internal
+ */
+bool WritePhysFSTraceText(PHYSFS_File* file, const char* text) {
+    PHYSFS_sint64 length = (PHYSFS_sint64)TextLength(text);
+    return PHYSFS_writeBytes(file, text, length) == length;
+}
+
+/**
+ * Writes the events recorded by the given thread as Chrome trace events. Each call is a complete
+ * event, holding an event for each of its phases.
+ *
+ * @param events A buffer of RAYLIB_PHYSFS_TRACE_EVENTS events to copy the ring buffer into.
+ *
+ * @internal
+ */
+bool WritePhysFSTraceThread(PHYSFS_File* file, PhysFSTraceThread* thread, PhysFSTraceEvent* events, bool* first) {
+    static const char* apiNames[PHYSFS_STATS_API_COUNT] = {
+        "LoadFileDataFromPhysFS",
+        "MapFileViewFromPhysFS",
+        "SaveFileDataToPhysFS",
+        "LoadImageFromPhysFS",
+        "LoadWaveFromPhysFS",
+        "LoadMusicStreamFromPhysFS",
+        "LoadFontFromPhysFS",
+        "LoadShaderFromPhysFS",
+        "FileExistsInPhysFS",
+        "LoadFileTextFromPhysFS",
+        "LoadDirectoryFilesFromPhysFS"
+    };
+    static const char* phaseNames[PHYSFS_STATS_PHASE_COUNT] = { "open", "read", "decode" };
+
+    // Copy out the events, and skip any that the thread overwrote while they were being copied.
+    unsigned long long count = LoadPhysFSAtomic(thread->eventCount);
+    unsigned long long start = LoadPhysFSAtomic(thread->firstEvent);
+    if (count > RAYLIB_PHYSFS_TRACE_EVENTS && start < count - RAYLIB_PHYSFS_TRACE_EVENTS) {
+        start = count - RAYLIB_PHYSFS_TRACE_EVENTS;
+    }
+    for (unsigned long long i = start; i < count; i++) {
+        events[i % RAYLIB_PHYSFS_TRACE_EVENTS] = thread->events[i % RAYLIB_PHYSFS_TRACE_EVENTS];
+    }
+    // The thread may be part way through writing the event after the last one it published, over the oldest slot.
+    unsigned long long written = LoadPhysFSAtomic(thread->eventCount);
+    if (written >= RAYLIB_PHYSFS_TRACE_EVENTS && start <= written - RAYLIB_PHYSFS_TRACE_EVENTS) {
+        start = written - RAYLIB_PHYSFS_TRACE_EVENTS + 1;
+    }
+    if (start >= count) {
+        return true;
+    }
+
+    bool output = WritePhysFSTraceText(file, TextFormat("%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%i,\"args\":{\"name\":\"raylib-physfs thread %i\"}}", *first ? "" : ",", thread->id, thread->id));
+    *first = false;
+    for (unsigned long long i = start; output && i < count; i++) {
+        PhysFSTraceEvent* event = &events[i % RAYLIB_PHYSFS_TRACE_EVENTS];
+
+        // Escape the path for JSON.
+        char fileName[PHYSFS_TRACE_PATH_SIZE * 2];
+        int length = 0;
+        for (int j = 0; event->fileName[j] != '\0'; j++) {
+            char c = event->fileName[j];
+            if (c == '"' || c == '\\') {
+                fileName[length++] = '\\';
+            } else if ((unsigned char)c < 0x20) {
+                c = '?';
+            }
+            fileName[length++] = c;
+        }
+        fileName[length] = '\0';
+
+        double duration = event->phases[PHYSFS_STATS_OPEN] + event->phases[PHYSFS_STATS_READ] + event->phases[PHYSFS_STATS_DECODE];
+        output = WritePhysFSTraceText(file, TextFormat(",\n{\"name\":\"%s\",\"cat\":\"raylib-physfs\",\"ph\":\"X\",\"pid\":1,\"tid\":%i,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"path\":\"%s\",\"bytes\":%lli,\"failed\":%s}}",
+            apiNames[event->api], thread->id, event->startTime * 1000.0, duration * 1000.0, fileName, event->bytes, event->failed ? "true" : "false"));
+
+        double phaseStart = event->startTime;
+        for (int phase = 0; output && phase < PHYSFS_STATS_PHASE_COUNT; phase++) {
+            if (event->phases[phase] <= 0.0) {
+                continue;
+            }
+            output = WritePhysFSTraceText(file, TextFormat(",\n{\"name\":\"%s\",\"cat\":\"raylib-physfs\",\"ph\":\"X\",\"pid\":1,\"tid\":%i,\"ts\":%.3f,\"dur\":%.3f}",
+                phaseNames[phase], thread->id, phaseStart * 1000.0, event->phases[phase] * 1000.0));
+            phaseStart += event->phases[phase];
+        }
+    }
+    return output;
+}
+#endif
+
+#if defined(RAYLIB_PHYSFS_STATS) || defined(RAYLIB_PHYSFS_TRACE)
+/**
+ * Records a call in the statistics and the trace. Use RecordPhysFSCall(), which compiles out when
+ * neither RAYLIB_PHYSFS_STATS nor RAYLIB_PHYSFS_TRACE are defined.
+ *
+ * @param openTime The time spent finding and opening the file, in milliseconds.
+ * @param readTime The time spent reading or writing the file, in milliseconds.
+ * @param decodeTime The time spent decoding the file, in milliseconds.
+ *
+ * @internal
+ */
+void RecordPhysFSCallEvent(PhysFSStatsApi api, const char* fileName, double openTime, double readTime, double decodeTime, long long bytesRead, long long bytesWritten, bool failed) {
+    if (!IsPhysFSReady()) {
+        return;
+    }
+    if (fileName == 0) {
+        fileName = "";
+    }
+#ifdef RAYLIB_PHYSFS_STATS
+    RecordPhysFSStatsCall(api, fileName, openTime, readTime, decodeTime, bytesRead, bytesWritten, failed);
+#endif
+#ifdef RAYLIB_PHYSFS_TRACE
+    AddPhysFSTraceEvent(api, fileName, openTime, readTime, decodeTime, bytesRead + bytesWritten, failed);
+#endif
+}
+#endif
+
+/**
+ * Save the calls traced since InitPhysFS() or ClearPhysFSTrace() as Chrome trace event JSON, which
+ * Perfetto and chrome://tracing open as a timeline.
+ *
+ * Calls are only traced when RAYLIB_PHYSFS_TRACE is defined. Each thread keeps its latest
+ * RAYLIB_PHYSFS_TRACE_EVENTS calls in its own ring buffer, without taking locks, so the trace shows
+ * how the threads overlapped. Each call holds spans for opening, reading and decoding its file,
+ * and loaders hold the calls they made, like LoadFileDataFromPhysFS().
+ *
+ * @param fileName The file to save the trace to, in the write directory.
+ *
+ * @return True on success, false on failure, or when built without RAYLIB_PHYSFS_TRACE.
+ *
+ * @see ClearPhysFSTrace()
+ */
+bool ExportPhysFSTrace(const char* fileName) {
+#ifdef RAYLIB_PHYSFS_TRACE
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot export trace '%s' before InitPhysFS()", fileName);
+        return false;
+    }
+
+    PhysFSTraceEvent* events = (PhysFSTraceEvent*)MemAlloc(sizeof(PhysFSTraceEvent) * RAYLIB_PHYSFS_TRACE_EVENTS);
+    if (events == 0) {
+        return false;
+    }
+    PHYSFS_File* file = PHYSFS_openWrite(fileName);
+    if (file == 0) {
+        TracePhysFSError(fileName);
+        MemFree(events);
+        return false;
+    }
+
+    bool first = true;
+    bool output = WritePhysFSTraceText(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    LockPhysFSMutex(physfsTraceMutex);
+    for (PhysFSTraceThread* thread = physfsTraceThreads; output && thread != 0; thread = thread->next) {
+        output = WritePhysFSTraceThread(file, thread, events, &first);
+    }
+    UnlockPhysFSMutex(physfsTraceMutex);
+    output = output && WritePhysFSTraceText(file, "\n]}\n");
+    MemFree(events);
+
+    if (PHYSFS_close(file) == 0 || !output) {
+        TracePhysFSError(fileName);
+        return false;
+    }
+    UpdatePhysFSIndexPath(fileName);
+    InvalidatePhysFSPathIds();
+    TraceLog(LOG_INFO, "PHYSFS: Exported the trace to '%s'", fileName);
+    return true;
+#else
+    TraceLog(LOG_WARNING, "PHYSFS: Cannot export trace '%s' without RAYLIB_PHYSFS_TRACE", fileName);
+    return false;
+#endif
+}
+
+/**
+ * Forget the calls traced so far, so that ExportPhysFSTrace() only saves the calls made after.
+ *
+ * @see ExportPhysFSTrace()
+ */
+void ClearPhysFSTrace() {
+#ifdef RAYLIB_PHYSFS_TRACE
+    if (!IsPhysFSReady()) {
+        return;
+    }
+
+    LockPhysFSMutex(physfsTraceMutex);
+    for (PhysFSTraceThread* thread = physfsTraceThreads; thread != 0; thread = thread->next) {
+        StorePhysFSAtomic(thread->firstEvent, LoadPhysFSAtomic(thread->eventCount));
+    }
+    UnlockPhysFSMutex(physfsTraceMutex);
+#endif
+}
+
+/**
+ * Records that the given file was loaded, if access recording is enabled and it's the first time.
+ *
+ * @internal
+ */
+void RecordPhysFSAccess(const char* fileName) {
+    // Recording is checked again under the lock, so loads don't serialize on it while it's off.
+    if (!IsPhysFSReady() || !LoadPhysFSAtomicInt(physfsAccessRecording)) {
+        return;
+    }
+
+    while (*fileName == '/') {
+        fileName++;
+    }
+    LockPhysFSMutex(physfsAccessMutex);
+    if (physfsAccessRecording) {
+        unsigned int hash = HashPhysFSString(fileName);
+        if (FindInPhysFSHashMap(&physfsAccessMap, fileName, hash) == -1 && GrowPhysFSArray((void**)&physfsAccessPaths, sizeof(char*) * (physfsAccessCount + 1))) {
+            char* path = CopyPhysFSString(fileName);
+            if (path != 0 && AddToPhysFSHashMap(&physfsAccessMap, path, hash, physfsAccessCount)) {
+                physfsAccessPaths[physfsAccessCount++] = path;
+            } else {
+                MemFree(path);
+            }
+        }
+    }
+    UnlockPhysFSMutex(physfsAccessMutex);
+}
+
+/**
+ * Forgets the recorded access order.
+ *
+ * @internal
+ */
+void ClearPhysFSAccessOrder() {
+    for (int i = 0; i < physfsAccessCount; i++) {
+        MemFree(physfsAccessPaths[i]);
+    }
+    MemFree(physfsAccessPaths);
+    UnloadPhysFSHashMap(&physfsAccessMap);
+    physfsAccessPaths = 0;
+    physfsAccessCount = 0;
+}
+
+/**
+ * Set whether to record the order in which files are first loaded from PhysFS.
+ *
+ * Play through a level with recording enabled, and save the order with ExportPhysFSAccessOrder().
+ * Packing with that order lays files out in the order they're loaded, so loading reads through the
+ * archive sequentially rather than seeking all over it. Enabling recording starts a new recording.
+ *
+ * @param enabled Whether to record accesses.
+ *
+ * @see ExportPhysFSAccessOrder()
+ * @see ExportPhysFSPackPro()
+ */
+void SetPhysFSAccessRecording(bool enabled) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot record accesses before InitPhysFS()");
+        return;
+    }
+
+    LockPhysFSMutex(physfsAccessMutex);
+    if (enabled && !physfsAccessRecording) {
+        ClearPhysFSAccessOrder();
+    }
+    StorePhysFSAtomicInt(physfsAccessRecording, enabled ? 1 : 0);
+    UnlockPhysFSMutex(physfsAccessMutex);
+}
+
+/**
+ * Save the order in which files were first loaded, to a file in the write directory.
+ *
+ * @param fileName The file to write, with one path per line.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see SetPhysFSAccessRecording()
+ */
+bool ExportPhysFSAccessOrder(const char* fileName) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot export access order '%s' before InitPhysFS()", fileName);
+        return false;
+    }
+
+    PHYSFS_File* file = PHYSFS_openWrite(fileName);
+    if (file == 0) {
+        TracePhysFSError(fileName);
+        return false;
+    }
+
+    bool output = true;
+    LockPhysFSMutex(physfsAccessMutex);
+    for (int i = 0; output && i < physfsAccessCount; i++) {
+        PHYSFS_sint64 length = (PHYSFS_sint64)TextLength(physfsAccessPaths[i]);
+        output = PHYSFS_writeBytes(file, physfsAccessPaths[i], length) == length && PHYSFS_writeBytes(file, "\n", 1) == 1;
+    }
+    int count = physfsAccessCount;
+    UnlockPhysFSMutex(physfsAccessMutex);
+
+    if (PHYSFS_close(file) == 0 || !output) {
+        TracePhysFSError(fileName);
+        return false;
+    }
+    UpdatePhysFSIndexPath(fileName);
+    InvalidatePhysFSPathIds();
+    TraceLog(LOG_INFO, "PHYSFS: Exported the access order of %i files to '%s'", count, fileName);
+    return true;
+}
+
+/**
+ * Gets the time a read request starts at, only reading the clock while it's needed.
+ *
+ * @return The time from GetPhysFSTime() while recording I/O or counting calls, 0 otherwise.
+ *
+ * @internal
+ */
+double GetPhysFSRequestTime() {
+    return LoadPhysFSAtomicInt(physfsIORecording) ? GetPhysFSTime() : GetPhysFSCallTime();
+}
+
+/**
+ * Grows an array to hold one more item than the given count, doubling its capacity when it's full.
+ *
+ * @return True on success, false on failure.
+ *
+ * @internal
+ */
+bool ReservePhysFSArray(void** array, int* capacity, int count, int itemSize) {
+    if (count < *capacity) {
+        return true;
+    }
+    int grown = *capacity == 0 ? 64 : *capacity * 2;
+    if (!GrowPhysFSArray(array, itemSize * grown)) {
+        return false;
+    }
+    *capacity = grown;
+    return true;
+}
+
+/**
+ * Records a read request, if I/O recording is enabled.
+ *
+ * @param startTime When the request started, from GetPhysFSRequestTime().
+ * @param size The bytes read.
+ *
+ * @internal
+ */
+void RecordPhysFSRequest(PhysFSStatsApi api, const char* fileName, double startTime, long long size, bool failed) {
+    // Checked again under the lock, as recording may stop in between.
+    if (!IsPhysFSReady() || !LoadPhysFSAtomicInt(physfsIORecording)) {
+        return;
+    }
+
+    double endTime = GetPhysFSTime();
+    while (*fileName == '/') {
+        fileName++;
+    }
+    LockPhysFSMutex(physfsIOMutex);
+    if (physfsIORecording && ReservePhysFSArray((void**)&physfsIORequests.requests, &physfsIORequestCapacity, physfsIORequests.requestCount, sizeof(PhysFSIORequest))) {
+        // Share the path between all the requests for the file.
+        unsigned int hash = HashPhysFSString(fileName);
+        int path = FindInPhysFSHashMap(&physfsIOPathMap, fileName, hash);
+        if (path == -1 && ReservePhysFSArray((void**)&physfsIORequests.paths, &physfsIOPathCapacity, physfsIORequests.pathCount, sizeof(char*))) {
+            char* copy = CopyPhysFSString(fileName);
+            if (copy != 0 && AddToPhysFSHashMap(&physfsIOPathMap, copy, hash, physfsIORequests.pathCount)) {
+                path = physfsIORequests.pathCount;
+                physfsIORequests.paths[physfsIORequests.pathCount++] = copy;
+            } else {
+                MemFree(copy);
+            }
+        }
+
+        if (path != -1) {
+            PhysFSIORequest* request = &physfsIORequests.requests[physfsIORequests.requestCount++];
+            request->time = startTime - physfsIORecordingStartTime;
+            request->milliseconds = endTime - startTime;
+            request->offset = 0;
+            request->size = size;
+            request->path = path;
+            request->api = api;
+            request->failed = failed;
+        }
+    }
+    UnlockPhysFSMutex(physfsIOMutex);
+}
+
+/**
+ * Unload read requests loaded with LoadPhysFSIORecording().
+ *
+ * @param recording The recording to unload.
+ *
+ * @see LoadPhysFSIORecording()
+ */
+void UnloadPhysFSIORecording(PhysFSIORecording recording) {
+    for (int i = 0; i < recording.pathCount; i++) {
+        MemFree(recording.paths[i]);
+    }
+    MemFree(recording.paths);
+    MemFree(recording.requests);
+}
+
+/**
+ * Forgets the recorded read requests. Requires the I/O mutex.
+ *
+ * @internal
+ */
+void ClearPhysFSIORecording() {
+    UnloadPhysFSIORecording(physfsIORequests);
+    UnloadPhysFSHashMap(&physfsIOPathMap);
+    PhysFSIORecording empty = { 0 };
+    physfsIORequests = empty;
+    physfsIORequestCapacity = 0;
+    physfsIOPathCapacity = 0;
+}
+
+/**
+ * Set whether to record every read request, with when it was made, its offset, size and latency.
+ *
+ * Unlike SetPhysFSAccessRecording(), every request is recorded, including repeated and failed ones,
+ * so that the raylib-physfs-replay tool can issue the same requests against other mounts and cache
+ * settings, and compare how long they take. Enabling recording starts a new recording.
+ *
+ * @param enabled Whether to record read requests.
+ *
+ * @see ExportPhysFSIORecording()
+ */
+void SetPhysFSIORecording(bool enabled) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot record I/O before InitPhysFS()");
+        return;
+    }
+
+    LockPhysFSMutex(physfsIOMutex);
+    if (enabled && !physfsIORecording) {
+        ClearPhysFSIORecording();
+        physfsIORecordingStartTime = GetPhysFSTime();
+    }
+    StorePhysFSAtomicInt(physfsIORecording, enabled ? 1 : 0);
+    UnlockPhysFSMutex(physfsIOMutex);
+}
+
+#ifdef RAYLIB_PHYSFS_TRACK_MEMORY
+/**
+ * Hashes a buffer's address, for the allocation table.
+ *
+ * @internal
+ */
+unsigned int HashPhysFSPointer(const void* data) {
+    unsigned long long value = (unsigned long long)(size_t)data;
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    return (unsigned int)value;
+}
+
+/**
+ * Inserts a buffer into the allocation table, which has to have room for it.
+ *
+ * A buffer that's already in the table was unloaded without UnloadFileDataFromPhysFS(), and its
+ * address reused, so its entry is overwritten.
+ *
+ * @return The entry that was overwritten, with data of 0 if there was none.
+ *
+ * @internal
+ */
+PhysFSAllocation InsertPhysFSAllocation(PhysFSAllocation* allocations, int capacity, PhysFSAllocation allocation) {
+    int slot = (int)(HashPhysFSPointer(allocation.data) & (unsigned int)(capacity - 1));
+    while (allocations[slot].data != 0 && allocations[slot].data != allocation.data) {
+        slot = (slot + 1) & (capacity - 1);
+    }
+    PhysFSAllocation previous = allocations[slot];
+    allocations[slot] = allocation;
+    return previous;
+}
+
+/**
+ * Starts tracking a buffer that was loaded from PhysFS. Use TrackPhysFSAllocation(), which compiles
+ * out without RAYLIB_PHYSFS_TRACK_MEMORY.
+ *
+ * @internal
+ */
+void AddPhysFSAllocation(const void* data, long long size, const char* api, const char* fileName) {
+    if (data == 0 || !IsPhysFSReady()) {
+        return;
+    }
+
+    LockPhysFSMutex(physfsMemoryMutex);
+
+    // Keep the table at most three quarters full.
+    if ((physfsMemoryStats.buffers + 1) * 4 > physfsAllocationCapacity * 3) {
+        int capacity = physfsAllocationCapacity > 0 ? physfsAllocationCapacity * 2 : 64;
+        PhysFSAllocation* allocations = (PhysFSAllocation*)MemAlloc(sizeof(PhysFSAllocation) * capacity);
+        if (allocations == 0) {
+            UnlockPhysFSMutex(physfsMemoryMutex);
+            return;
+        }
+        for (int i = 0; i < physfsAllocationCapacity; i++) {
+            if (physfsAllocations[i].data != 0) {
+                InsertPhysFSAllocation(allocations, capacity, physfsAllocations[i]);
+            }
+        }
+        MemFree(physfsAllocations);
+        physfsAllocations = allocations;
+        physfsAllocationCapacity = capacity;
+    }
+
+    PhysFSAllocation allocation = { data, size, api, CopyPhysFSString(fileName != 0 ? fileName : "") };
+    PhysFSAllocation previous = InsertPhysFSAllocation(physfsAllocations, physfsAllocationCapacity, allocation);
+    if (previous.data != 0) {
+        physfsMemoryStats.bytes -= previous.size;
+        physfsMemoryStats.buffers--;
+        MemFree(previous.fileName);
+    }
+    physfsMemoryStats.bytes += size;
+    physfsMemoryStats.buffers++;
+    physfsMemoryStats.totalBuffers++;
+    if (physfsMemoryStats.bytes > physfsMemoryStats.peakBytes) {
+        physfsMemoryStats.peakBytes = physfsMemoryStats.bytes;
+    }
+    UnlockPhysFSMutex(physfsMemoryMutex);
+}
+
+/**
+ * Stops tracking a buffer that is being unloaded. Buffers that aren't tracked are ignored. Use
+ * UntrackPhysFSAllocation(), which compiles out without RAYLIB_PHYSFS_TRACK_MEMORY.
+ *
+ * @internal
+ */
+void RemovePhysFSAllocation(const void* data) {
+    if (data == 0 || !IsPhysFSReady()) {
+        return;
+    }
+
+    LockPhysFSMutex(physfsMemoryMutex);
+    int mask = physfsAllocationCapacity - 1;
+    int slot = physfsAllocationCapacity > 0 ? (int)(HashPhysFSPointer(data) & (unsigned int)mask) : 0;
+    while (physfsAllocationCapacity > 0 && physfsAllocations[slot].data != 0 && physfsAllocations[slot].data != data) {
+        slot = (slot + 1) & mask;
+    }
+    if (physfsAllocationCapacity == 0 || physfsAllocations[slot].data == 0) {
+        UnlockPhysFSMutex(physfsMemoryMutex);
+        return;
+    }
+
+    physfsMemoryStats.bytes -= physfsAllocations[slot].size;
+    physfsMemoryStats.buffers--;
+    MemFree(physfsAllocations[slot].fileName);
+
+    // Shift back the entries that probed past the removed one, so that lookups still find them.
+    int empty = slot;
+    for (int i = (slot + 1) & mask; physfsAllocations[i].data != 0; i = (i + 1) & mask) {
+        int home = (int)(HashPhysFSPointer(physfsAllocations[i].data) & (unsigned int)mask);
+        if (((i - home) & mask) >= ((i - empty) & mask)) {
+            physfsAllocations[empty] = physfsAllocations[i];
+            empty = i;
+        }
+    }
+    PhysFSAllocation cleared = { 0 };
+    physfsAllocations[empty] = cleared;
+    UnlockPhysFSMutex(physfsMemoryMutex);
+}
+#endif
+
+/**
+ * Unload file data loaded with LoadFileDataFromPhysFS().
+ *
+ * Data from PhysFS can also be unloaded with UnloadFileData(), but only unloading it here keeps
+ * GetPhysFSMemoryStats() up to date.
+ *
+ * @param data The file data to unload.
+ *
+ * @see LoadFileDataFromPhysFS()
+ */
+void UnloadFileDataFromPhysFS(unsigned char* data) {
+    if (data == 0) {
+        return;
+    }
+    UntrackPhysFSAllocation(data);
+    MemFree(data);
+}
+
+/**
+ * Unload text loaded with LoadFileTextFromPhysFS().
+ *
+ * @param text The text to unload.
+ *
+ * @see LoadFileTextFromPhysFS()
+ */
+void UnloadFileTextFromPhysFS(char* text) {
+    UnloadFileDataFromPhysFS((unsigned char*)text);
+}
+
+/**
+ * Unload a list of files loaded with LoadDirectoryFilesFromPhysFS().
+ *
+ * @param files The list to unload.
+ *
+ * @see LoadDirectoryFilesFromPhysFS()
+ */
+void UnloadDirectoryFilesFromPhysFS(FilePathList files) {
+    if (files.paths == 0) {
+        return;
+    }
+    UntrackPhysFSAllocation(files.paths);
+    PHYSFS_freeList(files.paths);
+}
+
+/**
+ * Unload a list of files loaded with LoadDirectoryFilesFromPhysFSEx().
+ *
+ * @param files The list to unload.
+ *
+ * @see LoadDirectoryFilesFromPhysFSEx()
+ */
+void UnloadDirectoryFilesFromPhysFSEx(PhysFSFileInfoList files) {
+    if (files.files == 0) {
+        return;
+    }
+    UntrackPhysFSAllocation(files.files);
+    for (unsigned int i = 0; i < files.count; i++) {
+        MemFree(files.files[i].path);
+    }
+    MemFree(files.files);
+}
+
+/**
+ * Get the memory held by the file data, text and directory lists loaded from PhysFS.
+ *
+ * Buffers are only tracked when RAYLIB_PHYSFS_TRACK_MEMORY is defined, and they're tracked until
+ * they're unloaded with UnloadFileDataFromPhysFS(), UnloadFileTextFromPhysFS(),
+ * UnloadDirectoryFilesFromPhysFS() or UnloadDirectoryFilesFromPhysFSEx(). This includes the buffers that loaders like
+ * LoadImageFromPhysFS() hold while decoding, so the peak shows how much memory loading takes.
+ * ClosePhysFS() reports the buffers that were never unloaded, along with where they came from.
+ *
+ * @return The memory statistics, which are empty without RAYLIB_PHYSFS_TRACK_MEMORY.
+ */
+PhysFSMemoryStats GetPhysFSMemoryStats() {
+    PhysFSMemoryStats output = { 0 };
+#ifdef RAYLIB_PHYSFS_TRACK_MEMORY
+    if (!IsPhysFSReady()) {
+        return output;
+    }
+    LockPhysFSMutex(physfsMemoryMutex);
+    output = physfsMemoryStats;
+    UnlockPhysFSMutex(physfsMemoryMutex);
+#endif
+    return output;
+}
+
+/**
+ * Loads the given file as a byte array from PhysFS, like LoadFileDataFromPhysFS().
+ *
+ * @param stat The file's information when it's already known, like for path ids, which skips checking that the file exists and asking for its size. Can be 0.
+ * @param track Whether to track the data for GetPhysFSMemoryStats(), which data that's freed with UnloadFileData() shouldn't be.
+ *
+ * @internal
+ */
+unsigned char* LoadPhysFSFileData(const char* fileName, int* bytesRead, const PHYSFS_Stat* stat, bool track) {
+    RecordPhysFSAccess(fileName);
+    double startTime = GetPhysFSRequestTime();
+
+    // Serve repeated loads from the cache.
+    unsigned char* cached = LoadFileDataFromPhysFSCache(fileName, bytesRead);
+    if (cached != 0) {
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_FILE_DATA, fileName, 0.0, GetPhysFSCallTime() - startTime, 0.0, *bytesRead, 0, false);
+        RecordPhysFSRequest(PHYSFS_STATS_LOAD_FILE_DATA, fileName, startTime, *bytesRead, false);
+        if (track) {
+            TrackPhysFSAllocation(cached, *bytesRead, "LoadFileDataFromPhysFS", fileName);
+        }
+        return cached;
+    }
+
+    if (stat == 0 && !IsPhysFSFile(fileName)) {
+        TraceLog(LOG_WARNING, "PHYSFS: Tried to load unexisting file '%s'", fileName);
+        *bytesRead = 0;
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_FILE_DATA, fileName, GetPhysFSCallTime() - startTime, 0.0, 0.0, 0, 0, true);
+        RecordPhysFSRequest(PHYSFS_STATS_LOAD_FILE_DATA, fileName, startTime, 0, true);
+        return 0;
+    }
+
+    // Open up the file.
+    PHYSFS_File* handle = PHYSFS_openRead(fileName);
+    if (handle == 0) {
+        TracePhysFSError(fileName);
+        *bytesRead = 0;
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_FILE_DATA, fileName, GetPhysFSCallTime() - startTime, 0.0, 0.0, 0, 0, true);
+        RecordPhysFSRequest(PHYSFS_STATS_LOAD_FILE_DATA, fileName, startTime, 0, true);
+        return 0;
+    }
+    double openTime = GetPhysFSCallTime();
+
+    // Check to see how large the file is.
+    int size = stat != 0 ? (int)stat->filesize : PHYSFS_fileLength(handle);
+    if (size == -1) {
+        *bytesRead = 0;
+        PHYSFS_close(handle);
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot determine size of file '%s'", fileName);
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_FILE_DATA, fileName, openTime - startTime, GetPhysFSCallTime() - openTime, 0.0, 0, 0, true);
+        RecordPhysFSRequest(PHYSFS_STATS_LOAD_FILE_DATA, fileName, startTime, 0, true);
+        return 0;
+    }
+
+    // Close safely when it's empty.
+    if (size == 0) {
+        PHYSFS_close(handle);
+        *bytesRead = 0;
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_FILE_DATA, fileName, openTime - startTime, GetPhysFSCallTime() - openTime, 0.0, 0, 0, false);
+        RecordPhysFSRequest(PHYSFS_STATS_LOAD_FILE_DATA, fileName, startTime, 0, false);
+        return 0;
+    }
+
+    // Read the file, return if it's empty.
+    void* buffer = MemAlloc(size);
+    int read = PHYSFS_readBytes(handle, buffer, size);
+    if (read < 0) {
+        *bytesRead = 0;
+        MemFree(buffer);
+        PHYSFS_close(handle);
+        TracePhysFSError(fileName);
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_FILE_DATA, fileName, openTime - startTime, GetPhysFSCallTime() - openTime, 0.0, 0, 0, true);
+        RecordPhysFSRequest(PHYSFS_STATS_LOAD_FILE_DATA, fileName, startTime, 0, true);
+        return 0;
+    }
+
+    // Close the file handle, and return the bytes read and the buffer.
+    PHYSFS_close(handle);
+    RecordPhysFSCall(PHYSFS_STATS_LOAD_FILE_DATA, fileName, openTime - startTime, GetPhysFSCallTime() - openTime, 0.0, read, 0, false);
+    RecordPhysFSRequest(PHYSFS_STATS_LOAD_FILE_DATA, fileName, startTime, read, false);
+    AddToPhysFSCache(fileName, (unsigned char*)buffer, read);
+    if (track) {
+        TrackPhysFSAllocation(buffer, read, "LoadFileDataFromPhysFS", fileName);
+    }
+    *bytesRead = read;
+    return (unsigned char*) buffer;
+}
+
+/**
+ * Loads the given file as a byte array from PhysFS (read).
+ *
+ * @param fileName The file to load.
+ * @param bytesRead An integer to save the bytes that were read.
+ *
+ * @return The file data as a pointer. Make sure to use UnloadFileDataFromPhysFS() when finished using the file data.
+ *
+ * @see UnloadFileDataFromPhysFS()
+ */
+unsigned char* LoadFileDataFromPhysFS(const char* fileName, int* bytesRead) {
+    return LoadPhysFSFileData(fileName, bytesRead, 0, true);
+}
+
+/**
+ * Save the read requests recorded with SetPhysFSIORecording(), to a file in the write directory.
+ *
+ * The file starts with "RPIO", the format version, and the amount of paths and requests, as 32-bit
+ * integers. Each path follows as a 16-bit length and its characters, then each request as its
+ * time and offset as 64-bit integers, its latency and size as 32-bit integers, its path index as
+ * a 32-bit integer, and its API and whether it failed as bytes. Times are in microseconds, and
+ * integers are little-endian.
+ *
+ * @param fileName The file to write.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see LoadPhysFSIORecording()
+ */
+bool ExportPhysFSIORecording(const char* fileName) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot export I/O recording '%s' before InitPhysFS()", fileName);
+        return false;
+    }
+
+    LockPhysFSMutex(physfsIOMutex);
+    int size = PHYSFS_IO_RECORDING_HEADER_SIZE + PHYSFS_IO_REQUEST_SIZE * physfsIORequests.requestCount;
+    for (int i = 0; i < physfsIORequests.pathCount; i++) {
+        size += 2 + (int)TextLength(physfsIORequests.paths[i]);
+    }
+    unsigned char* data = (unsigned char*)MemAlloc(size);
+    if (data == 0) {
+        UnlockPhysFSMutex(physfsIOMutex);
+        return false;
+    }
+
+    data[0] = 'R';
+    data[1] = 'P';
+    data[2] = 'I';
+    data[3] = 'O';
+    WritePhysFSUInt(data + 4, PHYSFS_IO_RECORDING_VERSION, 4);
+    WritePhysFSUInt(data + 8, (unsigned long long)physfsIORequests.pathCount, 4);
+    WritePhysFSUInt(data + 12, (unsigned long long)physfsIORequests.requestCount, 4);
+    unsigned char* position = data + PHYSFS_IO_RECORDING_HEADER_SIZE;
+    for (int i = 0; i < physfsIORequests.pathCount; i++) {
+        unsigned int length = TextLength(physfsIORequests.paths[i]);
+        WritePhysFSUInt(position, length, 2);
+        for (unsigned int j = 0; j < length; j++) {
+            position[2 + j] = (unsigned char)physfsIORequests.paths[i][j];
+        }
+        position += 2 + length;
+    }
+    for (int i = 0; i < physfsIORequests.requestCount; i++) {
+        PhysFSIORequest* request = &physfsIORequests.requests[i];
+        double microseconds = request->milliseconds * 1000.0;
+        WritePhysFSUInt(position, (unsigned long long)(request->time * 1000.0), 8);
+        WritePhysFSUInt(position + 8, (unsigned long long)request->offset, 8);
+        WritePhysFSUInt(position + 16, microseconds < 4294967295.0 ? (unsigned long long)microseconds : 0xFFFFFFFFu, 4);
+        WritePhysFSUInt(position + 20, (unsigned long long)request->size, 4);
+        WritePhysFSUInt(position + 24, (unsigned long long)request->path, 4);
+        position[28] = (unsigned char)request->api;
+        position[29] = request->failed ? 1 : 0;
+        position += PHYSFS_IO_REQUEST_SIZE;
+    }
+    int requestCount = physfsIORequests.requestCount;
+    UnlockPhysFSMutex(physfsIOMutex);
+
+    bool output = SaveFileDataToPhysFS(fileName, data, size);
+    MemFree(data);
+    if (output) {
+        TraceLog(LOG_INFO, "PHYSFS: Exported %i read requests to '%s'", requestCount, fileName);
+    }
+    return output;
+}
+
+/**
+ * Load the read requests saved with ExportPhysFSIORecording().
+ *
+ * @param fileName The file to load.
+ *
+ * @return The recorded requests, which are empty on failure. Make sure to use UnloadPhysFSIORecording() when finished.
+ *
+ * @see UnloadPhysFSIORecording()
+ */
+PhysFSIORecording LoadPhysFSIORecording(const char* fileName) {
+    PhysFSIORecording output = { 0 };
+    int size = 0;
+    unsigned char* data = LoadFileDataFromPhysFS(fileName, &size);
+    if (data == 0) {
+        return output;
+    }
+
+    if (size < PHYSFS_IO_RECORDING_HEADER_SIZE || data[0] != 'R' || data[1] != 'P' || data[2] != 'I' || data[3] != 'O' || ReadPhysFSUInt32(data + 4) != PHYSFS_IO_RECORDING_VERSION) {
+        TraceLog(LOG_WARNING, "PHYSFS: '%s' is not an I/O recording", fileName);
+        UnloadFileDataFromPhysFS(data);
+        return output;
+    }
+    unsigned int pathCount = ReadPhysFSUInt32(data + 8);
+    unsigned int requestCount = ReadPhysFSUInt32(data + 12);
+    output.paths = (char**)MemAlloc(sizeof(char*) * (pathCount + 1));
+    output.requests = (PhysFSIORequest*)MemAlloc(sizeof(PhysFSIORequest) * (requestCount + 1));
+    bool valid = output.paths != 0 && output.requests != 0 && pathCount <= (unsigned int)size && requestCount <= (unsigned int)size;
+
+    // Read the paths.
+    int position = PHYSFS_IO_RECORDING_HEADER_SIZE;
+    for (unsigned int i = 0; valid && i < pathCount; i++) {
+        valid = position + 2 <= size;
+        int length = valid ? (int)ReadPhysFSUInt16(data + position) : 0;
+        valid = valid && position + 2 + length <= size;
+        char* path = valid ? (char*)MemAlloc(length + 1) : 0;
+        valid = path != 0;
+        for (int j = 0; valid && j < length; j++) {
+            path[j] = (char)data[position + 2 + j];
+        }
+        if (valid) {
+            path[length] = '\0';
+            output.paths[output.pathCount++] = path;
+        }
+        position += 2 + length;
+    }
+
+    // Read the requests.
+    valid = valid && position + (long long)requestCount * PHYSFS_IO_REQUEST_SIZE <= (long long)size;
+    for (unsigned int i = 0; valid && i < requestCount; i++) {
+        const unsigned char* entry = data + position + i * PHYSFS_IO_REQUEST_SIZE;
+        PhysFSIORequest* request = &output.requests[i];
+        request->time = (double)ReadPhysFSUInt64(entry) / 1000.0;
+        request->offset = (long long)ReadPhysFSUInt64(entry + 8);
+        request->milliseconds = (double)ReadPhysFSUInt32(entry + 16) / 1000.0;
+        request->size = (long long)ReadPhysFSUInt32(entry + 20);
+        request->path = (int)ReadPhysFSUInt32(entry + 24);
+        request->api = (PhysFSStatsApi)entry[28];
+        request->failed = entry[29] != 0;
+        valid = request->path >= 0 && request->path < output.pathCount && request->offset >= 0 &&
+            (request->api == PHYSFS_STATS_LOAD_FILE_DATA || request->api == PHYSFS_STATS_MAP_FILE_VIEW);
+        output.requestCount = valid ? (int)i + 1 : output.requestCount;
+    }
+    UnloadFileDataFromPhysFS(data);
+
+    if (!valid) {
+        TraceLog(LOG_WARNING, "PHYSFS: I/O recording '%s' is corrupt", fileName);
+        UnloadPhysFSIORecording(output);
+        PhysFSIORecording empty = { 0 };
+        return empty;
+    }
+    return output;
+}
+
+/**
+ * Hashes a path within a pack, with the given seed.
+ *
+ * @internal
+ */
+unsigned int HashPhysFSPackPath(const char* path, unsigned int seed) {
+    unsigned int hash = 2166136261u ^ (seed * 0x9E3779B9u);
+    while (*path != '\0') {
+        hash = (hash ^ (unsigned char)*path++) * 16777619u;
+    }
+
+    // Mix the bits, so that the low bits depend on the whole path.
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/**
+ * Reads the whole of the given amount of bytes from an I/O stream.
+ *
+ * @return True on success, false on failure.
+ *
+ * @internal
+ */
+bool ReadPhysFSIo(PHYSFS_Io* io, void* buffer, unsigned long long size) {
+    return size == 0 || io->read(io, buffer, size) == (PHYSFS_sint64)size;
+}
+
+/**
+ * Loads an entry's compressed data from the pack, and decompresses it.
+ *
+ * @return True on success, false on failure.
+ *
+ * @internal
+ */
+bool DecompressPhysFSPackEntry(PhysFSPackFile* file) {
+    if (file->entry.size > PHYSFS_PACK_MAX_DEFLATED_SIZE) {
+        PHYSFS_setErrorCode(PHYSFS_ERR_UNSUPPORTED);
+        return false;
+    }
+
+    unsigned char* compressed = (unsigned char*)MemAlloc((unsigned int)file->entry.compressedSize);
+    if (compressed == 0) {
+        PHYSFS_setErrorCode(PHYSFS_ERR_OUT_OF_MEMORY);
+        return false;
+    }
+    if (!file->io->seek(file->io, file->entry.offset) || !ReadPhysFSIo(file->io, compressed, file->entry.compressedSize)) {
+        MemFree(compressed);
+        return false;
+    }
+
+    int size = 0;
+    file->data = DecompressData(compressed, (int)file->entry.compressedSize, &size);
+    MemFree(compressed);
+    if (file->data == 0 || (unsigned long long)size != file->entry.size) {
+        MemFree(file->data);
+        file->data = 0;
+        PHYSFS_setErrorCode(PHYSFS_ERR_CORRUPT);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Reads from a file within a pack.
+ *
+ * @internal
+ */
+PHYSFS_sint64 ReadPhysFSPackFile(PHYSFS_Io* io, void* buffer, PHYSFS_uint64 length) {
+    PhysFSPackFile* file = (PhysFSPackFile*)io->opaque;
+    if (length > file->entry.size - file->position) {
+        length = file->entry.size - file->position;
+    }
+    if (length == 0) {
+        return 0;
+    }
+
+    // Compressed entries are decompressed on the first read, rather than while PhysFS holds its lock in openRead.
+    if (file->entry.codec == PHYSFS_PACK_CODEC_DEFLATE) {
+        if (file->data == 0 && !DecompressPhysFSPackEntry(file)) {
+            return -1;
+        }
+        for (PHYSFS_uint64 i = 0; i < length; i++) {
+            ((unsigned char*)buffer)[i] = file->data[file->position + i];
+        }
+    } else {
+        if (!file->io->seek(file->io, file->entry.offset + file->position) || !ReadPhysFSIo(file->io, buffer, length)) {
+            return -1;
+        }
+    }
+    file->position += length;
+    return (PHYSFS_sint64)length;
+}
+
+/**
+ * Files within packs are read-only.
+ *
+ * @internal
+ */
+PHYSFS_sint64 WritePhysFSPackFile(PHYSFS_Io* io, const void* buffer, PHYSFS_uint64 length) {
+    (void)io;
+    (void)buffer;
+    (void)length;
+    PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+    return -1;
+}
+
+/**
+ * Seeks within a file in a pack.
+ *
+ * @internal
+ */
+int SeekPhysFSPackFile(PHYSFS_Io* io, PHYSFS_uint64 offset) {
+    PhysFSPackFile* file = (PhysFSPackFile*)io->opaque;
+    if (offset > file->entry.size) {
+        PHYSFS_setErrorCode(PHYSFS_ERR_PAST_EOF);
+        return 0;
+    }
+    file->position = offset;
+    return 1;
+}
+
+/**
+ * Gets the position within a file in a pack.
+ *
+ * @internal
+ */
+PHYSFS_sint64 TellPhysFSPackFile(PHYSFS_Io* io) {
+    return (PHYSFS_sint64)((PhysFSPackFile*)io->opaque)->position;
+}
+
+/**
+ * Gets the size of a file in a pack.
+ *
+ * @internal
+ */
+PHYSFS_sint64 GetPhysFSPackFileLength(PHYSFS_Io* io) {
+    return (PHYSFS_sint64)((PhysFSPackFile*)io->opaque)->entry.size;
+}
+
+PHYSFS_Io* OpenPhysFSPackFile(PHYSFS_Io* archiveIo, PhysFSPackEntry entry);
+
+/**
+ * Opens another handle to a file in a pack, starting at the beginning.
+ *
+ * @internal
+ */
+PHYSFS_Io* DuplicatePhysFSPackFile(PHYSFS_Io* io) {
+    PhysFSPackFile* file = (PhysFSPackFile*)io->opaque;
+    return OpenPhysFSPackFile(file->io, file->entry);
+}
+
+/**
+ * Nothing to flush, as files within packs are read-only.
+ *
+ * @internal
+ */
+int FlushPhysFSPackFile(PHYSFS_Io* io) {
+    (void)io;
+    return 1;
+}
+
+/**
+ * Closes a file within a pack.
+ *
+ * @internal
+ */
+void ClosePhysFSPackFile(PHYSFS_Io* io) {
+    PhysFSPackFile* file = (PhysFSPackFile*)io->opaque;
+    file->io->destroy(file->io);
+    MemFree(file->data);
+    MemFree(file);
+    MemFree(io);
+}
+
+/**
+ * Opens a file within a pack, on its own handle to the archive.
+ *
+ * @internal
+ */
+PHYSFS_Io* OpenPhysFSPackFile(PHYSFS_Io* archiveIo, PhysFSPackEntry entry) {
+    PHYSFS_Io* io = (PHYSFS_Io*)MemAlloc(sizeof(PHYSFS_Io));
+    PhysFSPackFile* file = (PhysFSPackFile*)MemAlloc(sizeof(PhysFSPackFile));
+    PHYSFS_Io* duplicate = (io != 0 && file != 0) ? archiveIo->duplicate(archiveIo) : 0;
+    if (duplicate == 0) {
+        MemFree(io);
+        MemFree(file);
+        return 0;
+    }
+
+    file->io = duplicate;
+    file->entry = entry;
+    io->version = 0;
+    io->opaque = file;
+    io->read = ReadPhysFSPackFile;
+    io->write = WritePhysFSPackFile;
+    io->seek = SeekPhysFSPackFile;
+    io->tell = TellPhysFSPackFile;
+    io->length = GetPhysFSPackFileLength;
+    io->duplicate = DuplicatePhysFSPackFile;
+    io->flush = FlushPhysFSPackFile;
+    io->destroy = ClosePhysFSPackFile;
+    return io;
+}
+
+/**
+ * Frees a pack's tables.
+ *
+ * @internal
+ */
+void UnloadPhysFSPack(PhysFSPackData* pack) {
+    MemFree(pack->directories);
+    MemFree(pack->directoryNames);
+    MemFree(pack->directoryTable);
+    MemFree(pack->subdirectories);
+    MemFree(pack->seeds);
+    MemFree(pack->slots);
+    MemFree(pack->entries);
+    MemFree(pack->strings);
+    MemFree(pack->name);
+    MemFree(pack);
+}
+
+/**
+ * Gets how much memory a pack's tables take.
+ *
+ * @internal
+ */
+long long GetPhysFSPackTableSize(PhysFSPackData* pack) {
+    return (long long)sizeof(PhysFSPackData) +
+        (long long)sizeof(unsigned int) * pack->bucketCount +
+        (long long)(sizeof(int) + sizeof(PhysFSPackEntry)) * pack->entryCount +
+        pack->stringsSize +
+        (long long)sizeof(PhysFSPackDirectory) * pack->directoryCapacity +
+        pack->directoryNamesCapacity +
+        (long long)sizeof(int) * pack->directoryTableCapacity +
+        (long long)sizeof(int) * pack->directoryCount;
+}
+
+/**
+ * Gets the directory part of the given path within a pack.
+ *
+ * @return The length of the parent directory, with the name following it after a slash.
+ *
+ * @internal
+ */
+int GetPhysFSPackParentLength(const char* path) {
+    int output = 0;
+    for (int i = 0; path[i] != '\0'; i++) {
+        if (path[i] == '/') {
+            output = i;
+        }
+    }
+    return output;
+}
+
+/**
+ * Checks whether a directory in a pack has the given path.
+ *
+ * @internal
+ */
+bool IsPhysFSPackDirectory(PhysFSPackData* pack, int directory, const char* path, int length) {
+    // Match the path from its end, one parent at a time.
+    while (directory > 0) {
+        const char* name = pack->directoryNames + pack->directories[directory].nameOffset;
+        int nameLength = (int)TextLength(name);
+        if (nameLength > length || strncmp(path + length - nameLength, name, nameLength) != 0) {
+            return false;
+        }
+        length -= nameLength;
+        directory = pack->directories[directory].parent;
+        if (directory > 0) {
+            if (length == 0 || path[length - 1] != '/') {
+                return false;
+            }
+            length--;
+        }
+    }
+    return length == 0;
+}
+
+/**
+ * Finds the given directory in a pack.
+ *
+ * @return The index of the directory, or -1 if it is not in the pack.
+ *
+ * @internal
+ */
+int FindPhysFSPackDirectory(PhysFSPackData* pack, const char* path) {
+    if (path[0] == '\0') {
+        return 0;
+    }
+    unsigned int hash = HashPhysFSString(path);
+    int length = (int)TextLength(path);
+    unsigned int mask = (unsigned int)pack->directoryTableCapacity - 1;
+    for (unsigned int slot = hash & mask; pack->directoryTable[slot] != -1; slot = (slot + 1) & mask) {
+        int directory = pack->directoryTable[slot];
+        if (pack->directories[directory].hash == hash && IsPhysFSPackDirectory(pack, directory, path, length)) {
+            return directory;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Finds the directory an entry of a pack is in.
+ *
+ * Entries are grouped by directory, in the order of the directories, so this is a binary search.
+ *
+ * @internal
+ */
+int FindPhysFSPackEntryDirectory(PhysFSPackData* pack, int entry) {
+    int low = 0;
+    int high = pack->directoryCount - 1;
+    while (low < high) {
+        int middle = (low + high + 1) / 2;
+        if (pack->directories[middle].firstEntry <= entry) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return low;
+}
+
+/**
+ * Finds the given path in a pack's hash table.
+ *
+ * Paths hash to a bucket, and each bucket has a seed that sends its paths to distinct slots, so
+ * a lookup is two hashes, and a comparison of the name and of the directory it's in.
+ *
+ * @return The index of the entry, or -1 if the path is not in the pack.
+ *
+ * @internal
+ */
+int FindPhysFSPackEntry(PhysFSPackData* pack, const char* path) {
+    if (pack->entryCount == 0) {
+        return -1;
+    }
+    unsigned int bucket = HashPhysFSPackPath(path, 0) % (unsigned int)pack->bucketCount;
+    int index = pack->slots[HashPhysFSPackPath(path, pack->seeds[bucket]) % (unsigned int)pack->entryCount];
+    int parentLength = GetPhysFSPackParentLength(path);
+    const char* name = parentLength == 0 ? path : path + parentLength + 1;
+    if (!TextIsEqual(pack->strings + pack->entries[index].nameOffset, name) ||
+        !IsPhysFSPackDirectory(pack, FindPhysFSPackEntryDirectory(pack, index), path, parentLength)) {
+        return -1;
+    }
+    return index;
+}
+
+/**
+ * Adds a directory to a pack's directory table, growing it when it's half full.
+ *
+ * @return True on success, false on failure.
+ *
+ * @internal
+ */
+bool AddPhysFSPackDirectoryToTable(PhysFSPackData* pack, int directory) {
+    if ((directory + 1) * 2 > pack->directoryTableCapacity) {
+        int capacity = pack->directoryTableCapacity == 0 ? 64 : pack->directoryTableCapacity * 2;
+        int* table = (int*)MemAlloc(sizeof(int) * capacity);
+        if (table == 0) {
+            return false;
+        }
+        for (int i = 0; i < capacity; i++) {
+            table[i] = -1;
+        }
+        MemFree(pack->directoryTable);
+        pack->directoryTable = table;
+        pack->directoryTableCapacity = capacity;
+        for (int i = 0; i < directory; i++) {
+            AddPhysFSPackDirectoryToTable(pack, i);
+        }
+    }
+    unsigned int mask = (unsigned int)pack->directoryTableCapacity - 1;
+    unsigned int slot = pack->directories[directory].hash & mask;
+    while (pack->directoryTable[slot] != -1) {
+        slot = (slot + 1) & mask;
+    }
+    pack->directoryTable[slot] = directory;
+    return true;
+}
+
+/**
+ * Finds the directory with the given name within a parent directory of a pack, adding it if it's new.
+ *
+ * @param hash HashPhysFSString() of the directory's whole path.
+ *
+ * @return The index of the directory, or -1 on failure.
+ *
+ * @internal
+ */
+int AddPhysFSPackDirectory(PhysFSPackData* pack, int parent, const char* name, int nameLength, unsigned int hash) {
+    unsigned int mask = (unsigned int)pack->directoryTableCapacity - 1;
+    for (unsigned int slot = hash & mask; pack->directoryTable[slot] != -1; slot = (slot + 1) & mask) {
+        PhysFSPackDirectory* directory = &pack->directories[pack->directoryTable[slot]];
+        const char* directoryName = pack->directoryNames + directory->nameOffset;
+        if (directory->hash == hash && directory->parent == parent &&
+            strncmp(directoryName, name, nameLength) == 0 && directoryName[nameLength] == '\0') {
+            return pack->directoryTable[slot];
+        }
+    }
+
+    // Grow the directories and their names by doubling.
+    if (pack->directoryCount == pack->directoryCapacity) {
+        int capacity = pack->directoryCapacity * 2;
+        if (!GrowPhysFSArray((void**)&pack->directories, sizeof(PhysFSPackDirectory) * capacity)) {
+            return -1;
+        }
+        pack->directoryCapacity = capacity;
+    }
+    while (pack->directoryNamesSize + nameLength + 1 > pack->directoryNamesCapacity) {
+        unsigned int capacity = pack->directoryNamesCapacity * 2;
+        if (!GrowPhysFSArray((void**)&pack->directoryNames, (int)capacity)) {
+            return -1;
+        }
+        pack->directoryNamesCapacity = capacity;
+    }
+
+    int index = pack->directoryCount++;
+    PhysFSPackDirectory empty = { 0 };
+    PhysFSPackDirectory* directory = &pack->directories[index];
+    *directory = empty;
+    directory->hash = hash;
+    directory->parent = parent;
+    directory->nameOffset = pack->directoryNamesSize;
+    for (int i = 0; i < nameLength; i++) {
+        pack->directoryNames[pack->directoryNamesSize++] = name[i];
+    }
+    pack->directoryNames[pack->directoryNamesSize++] = '\0';
+    return AddPhysFSPackDirectoryToTable(pack, index) ? index : -1;
+}
+
+/**
+ * Builds a pack's tables from its entries and their paths, as they're stored in the pack.
+ *
+ * Directories keep only the last part of their path, and the rest through their parent. Entries
+ * are grouped by the directory they're in, and keep only the last part of their path too, with
+ * a table from hash table slots to entries. Enumerating a directory then only visits what's in it,
+ * and the tables take a few large allocations rather than one for each directory.
+ *
+ * @param records The entries, in hash table order, with the offsets of their whole paths.
+ * @param paths The whole paths of the entries.
+ *
+ * @return True on success, false on failure.
+ *
+ * @internal
+ */
+bool BuildPhysFSPackTables(PhysFSPackData* pack, const PhysFSPackEntry* records, const char* paths) {
+    int count = pack->entryCount > 0 ? pack->entryCount : 1;
+    pack->directoryCapacity = 16;
+    pack->directoryNamesCapacity = 256;
+    pack->directories = (PhysFSPackDirectory*)MemAlloc(sizeof(PhysFSPackDirectory) * pack->directoryCapacity);
+    pack->directoryNames = (char*)MemAlloc(pack->directoryNamesCapacity);
+    pack->slots = (int*)MemAlloc(sizeof(int) * count);
+    pack->entries = (PhysFSPackEntry*)MemAlloc(sizeof(PhysFSPackEntry) * count);
+    int* parents = (int*)MemAlloc(sizeof(int) * count);
+    bool output = pack->directories != 0 && pack->directoryNames != 0 && pack->slots != 0 && pack->entries != 0 && parents != 0;
+
+    // The root comes first, with an empty name.
+    if (output) {
+        PhysFSPackDirectory root = { 0 };
+        root.hash = HashPhysFSString("");
+        root.parent = -1;
+        pack->directories[0] = root;
+        pack->directoryNames[0] = '\0';
+        pack->directoryNamesSize = 1;
+        pack->directoryCount = 1;
+        output = AddPhysFSPackDirectoryToTable(pack, 0);
+    }
+
+    // Hash each directory along the way, the same as HashPhysFSString() would.
+    pack->stringsSize = 0;
+    for (int i = 0; output && i < pack->entryCount; i++) {
+        const char* path = paths + records[i].nameOffset;
+        unsigned int hash = HashPhysFSString("");
+        int parent = 0;
+        int start = 0;
+        int j = 0;
+        for (; output && path[j] != '\0'; j++) {
+            if (path[j] == '/') {
+                parent = AddPhysFSPackDirectory(pack, parent, path + start, j - start, hash);
+                output = parent != -1;
+                start = j + 1;
+            }
+            hash = (hash ^ (unsigned char)path[j]) * 16777619u;
+        }
+        parents[i] = parent;
+        pack->directories[parent].entryCount++;
+        pack->stringsSize += (unsigned int)(j - start + 1);
+    }
+
+    // Lay out the entries and the subdirectories by directory.
+    if (output) {
+        pack->subdirectories = (int*)MemAlloc(sizeof(int) * pack->directoryCount);
+        pack->strings = (char*)MemAlloc(pack->stringsSize > 0 ? pack->stringsSize : 1);
+        output = pack->subdirectories != 0 && pack->strings != 0;
+    }
+    for (int i = 1; output && i < pack->directoryCount; i++) {
+        pack->directories[pack->directories[i].parent].subdirectoryCount++;
+    }
+    int firstEntry = 0;
+    int firstSubdirectory = 0;
+    for (int i = 0; output && i < pack->directoryCount; i++) {
+        PhysFSPackDirectory* directory = &pack->directories[i];
+        directory->firstEntry = firstEntry;
+        directory->firstSubdirectory = firstSubdirectory;
+        firstEntry += directory->entryCount;
+        firstSubdirectory += directory->subdirectoryCount;
+        directory->entryCount = 0;
+        directory->subdirectoryCount = 0;
+    }
+    for (int i = 0; output && i < pack->entryCount; i++) {
+        PhysFSPackDirectory* directory = &pack->directories[parents[i]];
+        int index = directory->firstEntry + directory->entryCount++;
+        pack->slots[i] = index;
+        pack->entries[index] = records[i];
+    }
+    for (int i = 1; output && i < pack->directoryCount; i++) {
+        PhysFSPackDirectory* parent = &pack->directories[pack->directories[i].parent];
+        pack->subdirectories[parent->firstSubdirectory + parent->subdirectoryCount++] = i;
+    }
+
+    // Keep only the last part of each entry's path, in the order of the entries.
+    unsigned int stringsSize = 0;
+    for (int i = 0; output && i < pack->entryCount; i++) {
+        const char* path = paths + pack->entries[i].nameOffset;
+        int parentLength = GetPhysFSPackParentLength(path);
+        const char* name = parentLength == 0 ? path : path + parentLength + 1;
+        pack->entries[i].nameOffset = stringsSize;
+        do {
+            pack->strings[stringsSize++] = *name;
+        } while (*name++ != '\0');
+    }
+
+    MemFree(parents);
+    return output;
+}
+
+/**
+ * Opens a pack archive for PhysFS, reading its tables into memory.
+ *
+ * @internal
+ */
+void* OpenPhysFSPackArchive(PHYSFS_Io* io, const char* name, int forWrite, int* claimed) {
+    unsigned char header[PHYSFS_PACK_HEADER_SIZE];
+    if (!io->seek(io, 0) || !ReadPhysFSIo(io, header, sizeof(header)) || strncmp((const char*)header, "RPAK", 4) != 0) {
+        return 0;
+    }
+    *claimed = 1;
+    if (forWrite) {
+        PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+        return 0;
+    }
+    if (ReadPhysFSUInt32(header + 4) != PHYSFS_PACK_VERSION) {
+        PHYSFS_setErrorCode(PHYSFS_ERR_UNSUPPORTED);
+        return 0;
+    }
+
+    PhysFSPackData* pack = (PhysFSPackData*)MemAlloc(sizeof(PhysFSPackData));
+    if (pack == 0) {
+        PHYSFS_setErrorCode(PHYSFS_ERR_OUT_OF_MEMORY);
+        return 0;
+    }
+    pack->entryCount = (int)ReadPhysFSUInt32(header + 8);
+    pack->bucketCount = (int)ReadPhysFSUInt32(header + 12);
+    unsigned int stringsSize = ReadPhysFSUInt32(header + 16);
+    unsigned long long indexOffset = ReadPhysFSUInt64(header + 24);
+    PHYSFS_sint64 archiveSize = io->length(io);
+
+    // Read the seeds, entries and names.
+    unsigned char* records = 0;
+    PhysFSPackEntry* entries = 0;
+    char* strings = 0;
+    bool valid = pack->entryCount >= 0 && pack->bucketCount > 0 && pack->entryCount <= 0xFFFFFF && pack->bucketCount <= 0xFFFFFF && stringsSize > 0;
+    if (valid) {
+        pack->seeds = (unsigned int*)MemAlloc(sizeof(unsigned int) * pack->bucketCount);
+        entries = (PhysFSPackEntry*)MemAlloc(sizeof(PhysFSPackEntry) * (pack->entryCount > 0 ? pack->entryCount : 1));
+        strings = (char*)MemAlloc(stringsSize);
+        records = (unsigned char*)MemAlloc(4 * pack->bucketCount + PHYSFS_PACK_ENTRY_SIZE * pack->entryCount);
+        valid = pack->seeds != 0 && entries != 0 && strings != 0 && records != 0;
+    }
+
+    // The seeds are followed by the entries, so both are read in one go.
+    valid = valid && io->seek(io, indexOffset);
+    valid = valid && ReadPhysFSIo(io, records, 4ULL * pack->bucketCount + (unsigned long long)PHYSFS_PACK_ENTRY_SIZE * pack->entryCount);
+    valid = valid && ReadPhysFSIo(io, strings, stringsSize) && strings[stringsSize - 1] == '\0';
+    for (int i = 0; valid && i < pack->bucketCount; i++) {
+        pack->seeds[i] = ReadPhysFSUInt32(records + i * 4);
+    }
+
+    for (int i = 0; valid && i < pack->entryCount; i++) {
+        const unsigned char* record = records + 4 * pack->bucketCount + i * PHYSFS_PACK_ENTRY_SIZE;
+        PhysFSPackEntry* entry = &entries[i];
+        entry->offset = ReadPhysFSUInt64(record);
+        entry->size = ReadPhysFSUInt64(record + 8);
+        entry->compressedSize = ReadPhysFSUInt64(record + 16);
+        entry->nameOffset = ReadPhysFSUInt32(record + 24);
+        entry->codec = record[28];
+        valid = entry->nameOffset < stringsSize &&
+            entry->offset + entry->compressedSize <= (unsigned long long)archiveSize &&
+            (entry->codec == PHYSFS_PACK_CODEC_DEFLATE || (entry->codec == PHYSFS_PACK_CODEC_STORED && entry->compressedSize == entry->size));
+    }
+    MemFree(records);
+    valid = valid && BuildPhysFSPackTables(pack, entries, strings);
+    MemFree(entries);
+    MemFree(strings);
+    if (!valid) {
+        UnloadPhysFSPack(pack);
+        PHYSFS_setErrorCode(PHYSFS_ERR_CORRUPT);
+        return 0;
+    }
+
+    // Keep track of the pack, so file views can find where its entries are.
+    pack->io = io;
+    pack->name = CopyPhysFSString(name);
+    LockPhysFSMutex(physfsPackMutex);
+    pack->next = physfsPacks;
+    physfsPacks = pack;
+    UnlockPhysFSMutex(physfsPackMutex);
+    TraceLog(LOG_DEBUG, "PHYSFS: Loaded pack '%s' with %i entries and %i directories in %lld bytes",
+        name, pack->entryCount, pack->directoryCount, GetPhysFSPackTableSize(pack));
+    return pack;
+}
+
+/**
+ * Lists the files and directories within a directory of a pack.
+ *
+ * @internal
+ */
+PHYSFS_EnumerateCallbackResult EnumeratePhysFSPack(void* opaque, const char* dirname, PHYSFS_EnumerateCallback callback, const char* origdir, void* callbackdata) {
+    PhysFSPackData* pack = (PhysFSPackData*)opaque;
+    int index = FindPhysFSPackDirectory(pack, dirname);
+    if (index == -1) {
+        return PHYSFS_ENUM_OK;
+    }
+    PhysFSPackDirectory* directory = &pack->directories[index];
+    for (int i = 0; i < directory->entryCount + directory->subdirectoryCount; i++) {
+        const char* name = i < directory->entryCount ?
+            pack->strings + pack->entries[directory->firstEntry + i].nameOffset :
+            pack->directoryNames + pack->directories[pack->subdirectories[directory->firstSubdirectory + i - directory->entryCount]].nameOffset;
+        PHYSFS_EnumerateCallbackResult result = callback(callbackdata, origdir, name);
+        if (result != PHYSFS_ENUM_OK) {
+            if (result == PHYSFS_ENUM_ERROR) {
+                PHYSFS_setErrorCode(PHYSFS_ERR_APP_CALLBACK);
+            }
+            return result;
+        }
+    }
+    return PHYSFS_ENUM_OK;
+}
+
+/**
+ * Opens a file within a pack for reading.
+ *
+ * @internal
+ */
+PHYSFS_Io* OpenReadPhysFSPack(void* opaque, const char* fileName) {
+    PhysFSPackData* pack = (PhysFSPackData*)opaque;
+    int index = FindPhysFSPackEntry(pack, fileName);
+    if (index == -1) {
+        bool directory = FindPhysFSPackDirectory(pack, fileName) != -1;
+        PHYSFS_setErrorCode(directory ? PHYSFS_ERR_NOT_A_FILE : PHYSFS_ERR_NOT_FOUND);
+        return 0;
+    }
+    return OpenPhysFSPackFile(pack->io, pack->entries[index]);
+}
+
+/**
+ * Packs can't be written to.
+ *
+ * @internal
+ */
+PHYSFS_Io* OpenWritePhysFSPack(void* opaque, const char* fileName) {
+    (void)opaque;
+    (void)fileName;
+    PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+    return 0;
+}
+
+/**
+ * Packs can't be modified.
+ *
+ * @internal
+ */
+int ModifyPhysFSPack(void* opaque, const char* fileName) {
+    (void)opaque;
+    (void)fileName;
+    PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+    return 0;
+}
+
+/**
+ * Gets information about a file or directory in a pack.
+ *
+ * @internal
+ */
+int StatPhysFSPack(void* opaque, const char* fileName, PHYSFS_Stat* stat) {
+    PhysFSPackData* pack = (PhysFSPackData*)opaque;
+    stat->modtime = -1;
+    stat->createtime = -1;
+    stat->accesstime = -1;
+    stat->readonly = 1;
+
+    int index = FindPhysFSPackEntry(pack, fileName);
+    if (index != -1) {
+        stat->filesize = (PHYSFS_sint64)pack->entries[index].size;
+        stat->filetype = PHYSFS_FILETYPE_REGULAR;
+        return 1;
+    }
+    if (FindPhysFSPackDirectory(pack, fileName) != -1) {
+        stat->filesize = 0;
+        stat->filetype = PHYSFS_FILETYPE_DIRECTORY;
+        return 1;
+    }
+    PHYSFS_setErrorCode(PHYSFS_ERR_NOT_FOUND);
+    return 0;
+}
+
+/**
+ * Closes a pack archive.
+ *
+ * @internal
+ */
+void ClosePhysFSPackArchive(void* opaque) {
+    PhysFSPackData* pack = (PhysFSPackData*)opaque;
+    LockPhysFSMutex(physfsPackMutex);
+    for (PhysFSPackData** link = &physfsPacks; *link != 0; link = &(*link)->next) {
+        if (*link == pack) {
+            *link = pack->next;
+            break;
+        }
+    }
+    UnlockPhysFSMutex(physfsPackMutex);
+
+    pack->io->destroy(pack->io);
+    UnloadPhysFSPack(pack);
+}
+
+/**
+ * The PhysFS archiver for packs, registered in InitPhysFS().
+ *
+ * @internal
+ */
+static const PHYSFS_Archiver physfsPackArchiver = {
+    0,
+    {
+        "rpak",
+        "raylib-physfs pack",
+        "Rob Loach",
+        "https://github.com/RobLoach/raylib-physfs",
+        0
+    },
+    OpenPhysFSPackArchive,
+    EnumeratePhysFSPack,
+    OpenReadPhysFSPack,
+    OpenWritePhysFSPack,
+    OpenWritePhysFSPack,
+    ModifyPhysFSPack,
+    ModifyPhysFSPack,
+    StatPhysFSPack,
+    ClosePhysFSPackArchive
+};
+
+/**
+ * Finds where an uncompressed entry's bytes live within a mounted pack.
+ *
+ * @param archivePath The pack, as given to PhysFS when it was mounted.
+ * @param entryName The name of the entry within the pack.
+ * @param isPack Where to store whether the archive is a mounted pack.
+ *
+ * @return True if the entry is stored uncompressed, false otherwise.
+ *
+ * @internal
+ */
+bool GetPhysFSPackEntryLocation(const char* archivePath, const char* entryName, long long* offset, long long* size, bool* isPack) {
+    bool output = false;
+    *isPack = false;
+    LockPhysFSMutex(physfsPackMutex);
+    for (PhysFSPackData* pack = physfsPacks; pack != 0; pack = pack->next) {
+        if (!TextIsEqual(pack->name, archivePath)) {
+            continue;
+        }
+        *isPack = true;
+        int index = FindPhysFSPackEntry(pack, entryName);
+        if (index != -1 && pack->entries[index].codec == PHYSFS_PACK_CODEC_STORED) {
+            *offset = (long long)pack->entries[index].offset;
+            *size = (long long)pack->entries[index].size;
+            output = true;
+        }
+        break;
+    }
+    UnlockPhysFSMutex(physfsPackMutex);
+    return output;
+}
+
+#ifdef RAYLIB_PHYSFS_MMAP
+/**
+ * Finds where a STORED (uncompressed) entry's bytes live within a ZIP archive.
+ *
+ * The entries are read from the central directory when the archive is mounted, or the first time
+ * one is looked up for archives mounted otherwise.
+ *
+ * @param archivePath The ZIP archive, in platform-dependent notation.
+ * @param entryName The name of the entry within the archive.
+ * @param offset Where to store the offset of the entry's bytes within the archive.
+ * @param size Where to store the size of the entry.
+ *
+ * @return True if the entry was found and is stored uncompressed, false otherwise.
+ *
+ * @internal
+ */
+bool GetPhysFSZipEntryLocation(const char* archivePath, const char* entryName, long long* offset, long long* size) {
+    unsigned int hash = HashPhysFSString(entryName);
+    LockPhysFSMutex(physfsZipMutex);
+    PhysFSZipData* zip = FindPhysFSZipData(archivePath);
+    if (zip == 0) {
+        UnlockPhysFSMutex(physfsZipMutex);
+        AddPhysFSZipArchive(archivePath);
+        LockPhysFSMutex(physfsZipMutex);
+        zip = FindPhysFSZipData(archivePath);
+    }
+    int index = zip != 0 ? FindInPhysFSHashMap(&zip->entryMap, entryName, hash) : -1;
+    PhysFSZipEntry entry = { 0 };
+    long long archiveSize = 0;
+    if (index != -1) {
+        entry = zip->entries[index];
+        archiveSize = zip->size;
+    }
+    UnlockPhysFSMutex(physfsZipMutex);
+    if (index == -1 || !entry.stored) {
+        return false;
+    }
+
+    // The local header has its own name and extra field lengths, so it's read the first time the entry is viewed.
+    if (entry.dataOffset == -1) {
+        unsigned char header[30];
+        int fd = open(archivePath, O_RDONLY);
+        bool read = fd != -1 && ReadPhysFSFileRange(fd, header, 30, entry.localOffset);
+        if (fd != -1) {
+            close(fd);
+        }
+        if (!read || ReadPhysFSUInt32(header) != 0x04034b50) {
+            return false;
+        }
+        entry.dataOffset = entry.localOffset + 30 + ReadPhysFSUInt16(header + 26) + ReadPhysFSUInt16(header + 28);
+        if (entry.dataOffset + entry.size > archiveSize) {
+            return false;
+        }
+
+        LockPhysFSMutex(physfsZipMutex);
+        zip = FindPhysFSZipData(archivePath);
+        index = zip != 0 ? FindInPhysFSHashMap(&zip->entryMap, entryName, hash) : -1;
+        if (index != -1) {
+            zip->entries[index].dataOffset = entry.dataOffset;
+        }
+        UnlockPhysFSMutex(physfsZipMutex);
+    }
+
+    *offset = entry.dataOffset;
+    *size = entry.size;
+    return true;
+}
+
+/**
+ * Finds where the bytes of the given file are stored uncompressed on disk.
+ *
+ * Supports files from mounted directories, and STORED entries of mounted ZIP archives.
+ *
+ * @param fileName The file to locate, in platform-independent notation.
+ * @param nativePath Where to store the path of the file holding the bytes, in platform-dependent notation.
+ * @param nativePathSize The size of the nativePath buffer.
+ * @param offset Where to store the offset of the bytes within nativePath.
+ * @param size Where to store the size of the file.
+ *
+ * @return True if the bytes can be read directly from nativePath, false otherwise.
+ *
+ * @internal
+ */
+bool GetPhysFSFileLocation(const char* fileName, char* nativePath, int nativePathSize, long long* offset, long long* size) {
+    const char* realDir = PHYSFS_getRealDir(fileName);
+    if (realDir == 0) {
+        return false;
+    }
+
+    const char* mountPoint = PHYSFS_getMountPoint(realDir);
+    if (mountPoint == 0) {
+        return false;
+    }
+
+    // Find the path of the file relative to where it was mounted.
+    while (*fileName == '/') {
+        fileName++;
+    }
+    while (*mountPoint == '/') {
+        mountPoint++;
+    }
+    int mountPointLength = (int)TextLength(mountPoint);
+    if (strncmp(fileName, mountPoint, mountPointLength) != 0) {
+        return false;
+    }
+    const char* relativePath = fileName + mountPointLength;
+    while (*relativePath == '/') {
+        relativePath++;
+    }
+
+    // Memory mounts do not exist on disk.
+    struct stat info;
+    if (stat(realDir, &info) != 0) {
+        return false;
+    }
+
+    // Mounted directories hold the file as-is.
+    if (S_ISDIR(info.st_mode)) {
+        if (snprintf(nativePath, nativePathSize, "%s%s%s", realDir, PHYSFS_getDirSeparator(), relativePath) >= nativePathSize) {
+            return false;
+        }
+        if (stat(nativePath, &info) != 0 || !S_ISREG(info.st_mode)) {
+            return false;
+        }
+        *offset = 0;
+        *size = (long long)info.st_size;
+        return true;
+    }
+
+    // Otherwise, look for the file in the pack or ZIP archive.
+    if (snprintf(nativePath, nativePathSize, "%s", realDir) >= nativePathSize) {
+        return false;
+    }
+    bool isPack;
+    bool stored = GetPhysFSPackEntryLocation(realDir, relativePath, offset, size, &isPack);
+    if (isPack) {
+        return stored;
+    }
+    return GetPhysFSZipEntryLocation(realDir, relativePath, offset, size);
+}
+#endif
+
+/**
+ * Maps a read-only view of the given file from PhysFS.
+ *
+ * Files from mounted directories, and uncompressed entries in mounted ZIP archives, are memory
+ * mapped directly from disk rather than copied. Any other file falls back to being loaded with
+ * LoadFileDataFromPhysFS().
+ *
+ * A mapped view reads the file on disk as it is at the time. If the file is truncated while it's
+ * mapped, like a file in a mounted directory that's saved again, reading past its new end raises
+ * SIGBUS. Copy out of views of files that may change, or load them with LoadFileDataFromPhysFS().
+ *
+ * @param fileName The file to map.
+ *
+ * @return The view of the file. The view's data will be 0 on failure, and non-zero with a size of 0 for empty files. Make sure to use UnmapFileView() when finished using it.
+ *
+ * @see UnmapFileView()
+ * @see LoadFileDataFromPhysFS()
+ */
+FileView MapFileViewFromPhysFS(const char* fileName) {
+    FileView view = { 0 };
+
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot map '%s' before InitPhysFS()", fileName);
+        return view;
+    }
+    RecordPhysFSAccess(fileName);
+    double startTime = GetPhysFSRequestTime();
+
+    // Read cached files in place.
+    int index = -1;
+    if (LoadPhysFSAtomic(physfsCacheStats.capacity) > 0) {
+        LockPhysFSMutex(physfsCacheMutex);
+        index = physfsCacheStats.capacity > 0 ? FindPhysFSCacheEntry(fileName) : -1;
+        if (index != -1) {
+            PhysFSCacheEntry* entry = &physfsCacheEntries[index];
+            entry->refCount++;
+            view.data = entry->data;
+            view.size = entry->size;
+            view.cacheEntry = index + 1;
+        }
+        UnlockPhysFSMutex(physfsCacheMutex);
+    }
+    if (index != -1) {
+        RecordPhysFSCall(PHYSFS_STATS_MAP_FILE_VIEW, fileName, 0.0, GetPhysFSCallTime() - startTime, 0.0, view.size, 0, false);
+        RecordPhysFSRequest(PHYSFS_STATS_MAP_FILE_VIEW, fileName, startTime, view.size, false);
+        return view;
+    }
+
+    OpenPhysFSLazyMounts(fileName, false);
+#ifdef RAYLIB_PHYSFS_MMAP
+    char nativePath[4096];
+    long long offset = 0;
+    long long size = 0;
+    if (GetPhysFSFileLocation(fileName, nativePath, sizeof(nativePath), &offset, &size)) {
+        // Empty files have nothing to map.
+        if (size == 0) {
+            view.data = physfsEmptyFileView;
+            RecordPhysFSCall(PHYSFS_STATS_MAP_FILE_VIEW, fileName, 0.0, GetPhysFSCallTime() - startTime, 0.0, 0, 0, false);
+            RecordPhysFSRequest(PHYSFS_STATS_MAP_FILE_VIEW, fileName, startTime, 0, false);
+            return view;
+        }
+
+        int fd = size <= 0x7FFFFFFF ? open(nativePath, O_RDONLY) : -1;
+        double openTime = GetPhysFSCallTime();
+        if (fd != -1) {
+            // Mappings have to start on a page boundary.
+            long long pageSize = (long long)sysconf(_SC_PAGESIZE);
+            long long mappingOffset = offset - (offset % pageSize);
+            size_t mappingSize = (size_t)(size + offset - mappingOffset);
+            void* mapping = mmap(0, mappingSize, PROT_READ, MAP_PRIVATE, fd, (off_t)mappingOffset);
+            close(fd);
+
+            if (mapping != MAP_FAILED) {
+                view.data = (const unsigned char*)mapping + (offset - mappingOffset);
+                view.size = (int)size;
+                view.mapping = mapping;
+                view.mappingSize = (unsigned long long)mappingSize;
+                RecordPhysFSCall(PHYSFS_STATS_MAP_FILE_VIEW, fileName, openTime - startTime, GetPhysFSCallTime() - openTime, 0.0, view.size, 0, false);
+                RecordPhysFSRequest(PHYSFS_STATS_MAP_FILE_VIEW, fileName, startTime, view.size, false);
+                return view;
+            }
+        }
+    }
+#endif
+
+    // Fall back to copying the file contents.
+    int bytesRead = 0;
+    view.data = LoadFileDataFromPhysFS(fileName, &bytesRead);
+    view.size = bytesRead;
+    PHYSFS_Stat stat;
+    if (view.data == 0 && GetPhysFSPathStat(fileName, &stat) && stat.filetype == PHYSFS_FILETYPE_REGULAR && stat.filesize == 0) {
+        view.data = physfsEmptyFileView;
+    }
+    return view;
+}
+
+/**
+ * Unmaps a file view that was loaded with MapFileViewFromPhysFS().
+ *
+ * Views of cached files read from the cache, which ClosePhysFS() frees. Unmapping one after that
+ * does nothing, and its data must not be read anymore.
+ *
+ * @param view The file view to unmap.
+ *
+ * @see MapFileViewFromPhysFS()
+ */
+void UnmapFileView(FileView view) {
+    if (view.data == 0 || view.data == physfsEmptyFileView) {
+        return;
+    }
+
+    // Release the cache entry, freeing it if it was removed from the cache in the meantime.
+    if (view.cacheEntry != 0) {
+        if (!IsPhysFSReady()) {
+            return;
+        }
+        LockPhysFSMutex(physfsCacheMutex);
+        if (view.cacheEntry <= physfsCacheEntryCount) {
+            PhysFSCacheEntry* entry = &physfsCacheEntries[view.cacheEntry - 1];
+            entry->refCount--;
+            if (entry->refCount == 0 && !entry->cached) {
+                FreePhysFSCacheEntry(view.cacheEntry - 1);
+            }
+        }
+        UnlockPhysFSMutex(physfsCacheMutex);
+        return;
+    }
+
+#ifdef RAYLIB_PHYSFS_MMAP
+    if (view.mapping != 0) {
+        munmap(view.mapping, (size_t)view.mappingSize);
+        return;
+    }
+#endif
+
+    UnloadFileDataFromPhysFS((unsigned char*)view.data);
+}
+
+/**
+ * Check whether job a should run before job b.
+ *
+ * @internal
+ */
+bool IsPhysFSJobBefore(PhysFSJobData* a, PhysFSJobData* b) {
+    if (a->priority != b->priority) {
+        return a->priority > b->priority;
+    }
+    return a->sequence < b->sequence;
+}
+
+/**
+ * Restores the heap order of the job queue around the given position. Requires the job mutex.
+ *
+ * @internal
+ */
+void SortPhysFSJobQueue(int position) {
+    PhysFSJobData** queue = physfsJobQueue;
+
+    // Sift up.
+    while (position > 0 && IsPhysFSJobBefore(queue[position], queue[(position - 1) / 2])) {
+        PhysFSJobData* parent = queue[(position - 1) / 2];
+        queue[(position - 1) / 2] = queue[position];
+        queue[position] = parent;
+        position = (position - 1) / 2;
+    }
+
+    // Sift down.
+    while (true) {
+        int first = position;
+        int left = position * 2 + 1;
+        int right = left + 1;
+        if (left < physfsJobQueueCount && IsPhysFSJobBefore(queue[left], queue[first])) {
+            first = left;
+        }
+        if (right < physfsJobQueueCount && IsPhysFSJobBefore(queue[right], queue[first])) {
+            first = right;
+        }
+        if (first == position) {
+            break;
+        }
+        PhysFSJobData* child = queue[first];
+        queue[first] = queue[position];
+        queue[position] = child;
+        position = first;
+    }
+}
+
+/**
+ * Removes the job at the given position from the job queue. Requires the job mutex.
+ *
+ * @internal
+ */
+void RemovePhysFSJobFromQueue(int position) {
+    physfsJobQueueCount--;
+    if (position < physfsJobQueueCount) {
+        physfsJobQueue[position] = physfsJobQueue[physfsJobQueueCount];
+        SortPhysFSJobQueue(position);
+    }
+}
+
+/**
+ * Frees the given job, and anything it loaded.
+ *
+ * @internal
+ */
+void UnloadPhysFSJob(PhysFSJobData* job) {
+    if (job->data != 0) {
+        UnloadFileDataFromPhysFS(job->data);
+    }
+    if (job->image.data != 0) {
+        UnloadImage(job->image);
+    }
+    if (job->wave.data != 0) {
+        UnloadWave(job->wave);
+    }
+    MemFree(job->fileName);
+    MemFree(job);
+}
+
+/**
+ * Finds the job for the given handle. Requires the job mutex.
+ *
+ * @return The job, or 0 if the handle is not valid anymore.
+ *
+ * @internal
+ */
+PhysFSJobData* GetPhysFSJob(int handle) {
+    int index = handle & 0xFFFFF;
+    unsigned int generation = (unsigned int)handle >> 20;
+    if (handle <= 0 || index >= physfsJobSlotCount || physfsJobSlots[index].generation != generation) {
+        return 0;
+    }
+    return physfsJobSlots[index].job;
+}
+
+/**
+ * Releases the slot behind the given job handle, invalidating the handle. Requires the job mutex.
+ *
+ * @internal
+ */
+void ReleasePhysFSJobSlot(int handle) {
+    int index = handle & 0xFFFFF;
+    PhysFSJobSlot* slot = &physfsJobSlots[index];
+    slot->job = 0;
+    slot->generation = slot->generation >= 0x7FF ? 1 : slot->generation + 1;
+    slot->nextFree = physfsJobSlotFree;
+    physfsJobSlotFree = index;
+}
+
+/**
+ * Raises the priority of the given job, if it's still queued. Jobs that already have a higher priority keep it.
+ *
+ * @internal
+ */
+void RaisePhysFSJobPriority(int handle, int priority) {
+    LockPhysFSMutex(physfsJobMutex);
+    PhysFSJobData* job = GetPhysFSJob(handle);
+    if (job != 0 && job->state == PHYSFS_JOB_QUEUED && job->priority < priority) {
+        for (int i = 0; i < physfsJobQueueCount; i++) {
+            if (physfsJobQueue[i] == job) {
+                job->priority = priority;
+                SortPhysFSJobQueue(i);
+                break;
+            }
+        }
+    }
+    UnlockPhysFSMutex(physfsJobMutex);
+}
+
+/**
+ * Runs queued jobs until the workers are asked to stop.
+ *
+ * @internal
+ */
+PhysFSThreadResult RunPhysFSWorker(void* arg) {
+    (void)arg;
+    LockPhysFSMutex(physfsJobMutex);
+    while (true) {
+        while (!physfsWorkersStopping && physfsJobQueueCount == 0) {
+            WaitPhysFSCondition(physfsJobQueued, physfsJobMutex);
+        }
+        if (physfsWorkersStopping) {
+            break;
+        }
+
+        // Take the most important job.
+        PhysFSJobData* job = physfsJobQueue[0];
+        RemovePhysFSJobFromQueue(0);
+        job->state = PHYSFS_JOB_RUNNING;
+
+        UnlockPhysFSMutex(physfsJobMutex);
+        job->proc(job);
+        LockPhysFSMutex(physfsJobMutex);
+
+        // Nobody is waiting for cancelled jobs anymore.
+        job->state = PHYSFS_JOB_DONE;
+        if (job->cancelled) {
+            UnloadPhysFSJob(job);
+        }
+        BroadcastPhysFSCondition(physfsJobDone);
+    }
+    UnlockPhysFSMutex(physfsJobMutex);
+    return 0;
+}
+
+/**
+ * Queues the given job to be run by the worker threads, starting them if needed.
+ *
+ * @return A handle to the job, or 0 on failure.
+ *
+ * @internal
+ */
+int QueuePhysFSJob(PhysFSJobData* job) {
+    LockPhysFSMutex(physfsJobMutex);
+
+    // Start the workers on first use.
+    while (physfsWorkerCount < RAYLIB_PHYSFS_WORKER_COUNT) {
+        if (!CreatePhysFSThread(physfsWorkers[physfsWorkerCount], RunPhysFSWorker, 0)) {
+            break;
+        }
+        physfsWorkerCount++;
+    }
+    if (physfsWorkerCount == 0) {
+        UnlockPhysFSMutex(physfsJobMutex);
+        TraceLog(LOG_WARNING, "PHYSFS: Failed to start worker threads");
+        return 0;
+    }
+
+    // Find a slot for the handle.
+    if (physfsJobSlotFree == -1) {
+        PhysFSJobSlot* slots = (PhysFSJobSlot*)MemRealloc(physfsJobSlots, sizeof(PhysFSJobSlot) * (physfsJobSlotCount + 1));
+        if (slots == 0 || physfsJobSlotCount >= 0xFFFFF) {
+            if (slots != 0) {
+                physfsJobSlots = slots;
+            }
+            UnlockPhysFSMutex(physfsJobMutex);
+            return 0;
+        }
+        physfsJobSlots = slots;
+        physfsJobSlots[physfsJobSlotCount].generation = 1;
+        physfsJobSlots[physfsJobSlotCount].job = 0;
+        physfsJobSlots[physfsJobSlotCount].nextFree = -1;
+        physfsJobSlotFree = physfsJobSlotCount++;
+    }
+
+    // Make room in the queue.
+    if (physfsJobQueueCount == physfsJobQueueCapacity) {
+        int capacity = physfsJobQueueCapacity == 0 ? 64 : physfsJobQueueCapacity * 2;
+        PhysFSJobData** queue = (PhysFSJobData**)MemRealloc(physfsJobQueue, sizeof(PhysFSJobData*) * capacity);
+        if (queue == 0) {
+            UnlockPhysFSMutex(physfsJobMutex);
+            return 0;
+        }
+        physfsJobQueue = queue;
+        physfsJobQueueCapacity = capacity;
+    }
+
+    int index = physfsJobSlotFree;
+    PhysFSJobSlot* slot = &physfsJobSlots[index];
+    physfsJobSlotFree = slot->nextFree;
+    slot->job = job;
+
+    job->state = PHYSFS_JOB_QUEUED;
+    job->sequence = physfsJobSequence++;
+    physfsJobQueue[physfsJobQueueCount++] = job;
+    SortPhysFSJobQueue(physfsJobQueueCount - 1);
+    BroadcastPhysFSCondition(physfsJobQueued);
+
+    int handle = (int)((slot->generation << 20) | (unsigned int)index);
+    UnlockPhysFSMutex(physfsJobMutex);
+    return handle;
+}
+
+/**
+ * Stops the worker threads, and frees all jobs.
+ *
+ * @internal
+ */
+void StopPhysFSWorkers() {
+    LockPhysFSMutex(physfsJobMutex);
+    physfsWorkersStopping = true;
+    BroadcastPhysFSCondition(physfsJobQueued);
+    UnlockPhysFSMutex(physfsJobMutex);
+
+    for (int i = 0; i < physfsWorkerCount; i++) {
+        JoinPhysFSThread(physfsWorkers[i]);
+    }
+    physfsWorkerCount = 0;
+    physfsWorkersStopping = false;
+
+    // Queued jobs are owned by their slots, as are finished jobs that were never waited on.
+    for (int i = 0; i < physfsJobSlotCount; i++) {
+        if (physfsJobSlots[i].job != 0) {
+            UnloadPhysFSJob(physfsJobSlots[i].job);
+        }
+    }
+    MemFree(physfsJobSlots);
+    MemFree(physfsJobQueue);
+    physfsJobSlots = 0;
+    physfsJobSlotCount = 0;
+    physfsJobSlotFree = -1;
+    physfsJobQueue = 0;
+    physfsJobQueueCount = 0;
+    physfsJobQueueCapacity = 0;
+}
+
+/**
+ * Waits for the given job to finish, and takes ownership of it. The job handle is no longer valid afterwards.
+ *
+ * @return The finished job, to be freed with UnloadPhysFSJob(). 0 if the handle is not valid.
+ *
+ * @internal
+ */
+PhysFSJobData* TakePhysFSJob(int handle) {
+    if (!IsPhysFSReady()) {
+        return 0;
+    }
+
+    LockPhysFSMutex(physfsJobMutex);
+    PhysFSJobData* job = GetPhysFSJob(handle);
+    if (job != 0) {
+        while (job->state != PHYSFS_JOB_DONE) {
+            WaitPhysFSCondition(physfsJobDone, physfsJobMutex);
+        }
+        ReleasePhysFSJobSlot(handle);
+    }
+    UnlockPhysFSMutex(physfsJobMutex);
+    return job;
+}
+
+/**
+ * Loads the file data of the given job.
+ *
+ * @internal
+ */
+void LoadPhysFSJobFileData(PhysFSJobData* job) {
+    job->data = LoadFileDataFromPhysFS(job->fileName, &job->dataSize);
+}
+
+/**
+ * Loads the given file as a byte array from PhysFS on a worker thread.
+ *
+ * @param fileName The file to load.
+ * @param priority Jobs with a higher priority are loaded first. Jobs of the same priority load in the order they were made.
+ *
+ * @return A handle to the job, or 0 on failure. Use WaitPhysFSJob() or CancelPhysFSJob() when finished with it.
+ *
+ * @see WaitPhysFSJob()
+ * @see IsPhysFSJobDone()
+ * @see CancelPhysFSJob()
+ */
+int LoadFileDataFromPhysFSAsync(const char* fileName, int priority) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot load '%s' before InitPhysFS()", fileName);
+        return 0;
+    }
+
+    PhysFSJobData* job = (PhysFSJobData*)MemAlloc(sizeof(PhysFSJobData));
+    if (job == 0) {
+        return 0;
+    }
+    job->fileName = CopyPhysFSString(fileName);
+    job->priority = priority;
+    job->proc = LoadPhysFSJobFileData;
+
+    int handle = QueuePhysFSJob(job);
+    if (handle == 0) {
+        UnloadPhysFSJob(job);
+    }
+    return handle;
+}
+
+/**
+ * Check if the given asynchronous job has finished.
+ *
+ * @param job The job handle.
+ *
+ * @return True if the job has finished, false if it is still running or is not a valid job.
+ *
+ * @see WaitPhysFSJob()
+ */
+bool IsPhysFSJobDone(int job) {
+    if (!IsPhysFSReady()) {
+        return false;
+    }
+
+    LockPhysFSMutex(physfsJobMutex);
+    PhysFSJobData* data = GetPhysFSJob(job);
+    bool done = data != 0 && data->state == PHYSFS_JOB_DONE;
+    UnlockPhysFSMutex(physfsJobMutex);
+    return done;
+}
+
+/**
+ * Waits for the given asynchronous load to finish, and takes its data. The job handle is no longer valid afterwards.
+ *
+ * @param job The job handle, from LoadFileDataFromPhysFSAsync().
+ * @param bytesRead An integer to save the bytes that were read.
+ *
+ * @return The file data. Make sure to use UnloadFileDataFromPhysFS() when finished using the file data. 0 on failure.
+ *
+ * @see LoadFileDataFromPhysFSAsync()
+ */
+unsigned char* WaitPhysFSJob(int job, int* bytesRead) {
+    *bytesRead = 0;
+    PhysFSJobData* data = TakePhysFSJob(job);
+    if (data == 0) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot wait for invalid job (%i)", job);
+        return 0;
+    }
+
+    // Hand over the data.
+    unsigned char* output = data->data;
+    *bytesRead = data->dataSize;
+    data->data = 0;
+    UnloadPhysFSJob(data);
+    return output;
+}
+
+/**
+ * Cancels the given asynchronous job, discarding anything it loaded. The job handle is no longer valid afterwards.
+ *
+ * @param job The job handle.
+ *
+ * @return True if the job was cancelled, false if it is not a valid job.
+ */
+bool CancelPhysFSJob(int job) {
+    if (!IsPhysFSReady()) {
+        return false;
+    }
+
+    LockPhysFSMutex(physfsJobMutex);
+    PhysFSJobData* data = GetPhysFSJob(job);
+    if (data == 0) {
+        UnlockPhysFSMutex(physfsJobMutex);
+        return false;
+    }
+    ReleasePhysFSJobSlot(job);
+
+    if (data->state == PHYSFS_JOB_RUNNING) {
+        // The worker frees it once it is done.
+        data->cancelled = true;
+    } else {
+        if (data->state == PHYSFS_JOB_QUEUED) {
+            for (int i = 0; i < physfsJobQueueCount; i++) {
+                if (physfsJobQueue[i] == data) {
+                    RemovePhysFSJobFromQueue(i);
+                    break;
+                }
+            }
+        }
+        UnloadPhysFSJob(data);
+    }
+    UnlockPhysFSMutex(physfsJobMutex);
+    return true;
+}
+
+/**
+ * Adds the files within the given directory to a list, recursively.
+ *
+ * @internal
+ */
+void AddPhysFSPackFiles(const char* dirPath, FilePathList* files) {
+    char** list = PHYSFS_enumerateFiles(dirPath);
+    if (list == 0) {
+        return;
+    }
+    for (char** i = list; *i != 0; i++) {
+        const char* path = dirPath[0] == '\0' ? *i : TextFormat("%s/%s", dirPath, *i);
+        PHYSFS_Stat stat;
+        if (PHYSFS_stat(path, &stat) == 0) {
+            continue;
+        }
+        if (stat.filetype == PHYSFS_FILETYPE_DIRECTORY) {
+            char* directory = CopyPhysFSString(path);
+            if (directory != 0) {
+                AddPhysFSPackFiles(directory, files);
+                MemFree(directory);
+            }
+        } else if (stat.filetype == PHYSFS_FILETYPE_REGULAR) {
+            if (files->count == files->capacity) {
+                unsigned int capacity = files->capacity == 0 ? 64 : files->capacity * 2;
+                if (!GrowPhysFSArray((void**)&files->paths, sizeof(char*) * capacity)) {
+                    continue;
+                }
+                files->capacity = capacity;
+            }
+            char* copy = CopyPhysFSString(path);
+            if (copy != 0) {
+                files->paths[files->count++] = copy;
+            }
+        }
+    }
+    PHYSFS_freeList(list);
+}
+
+/**
+ * Frees a list of files from AddPhysFSPackFiles().
+ *
+ * @internal
+ */
+void UnloadPhysFSPackFiles(FilePathList files) {
+    for (unsigned int i = 0; i < files.count; i++) {
+        MemFree(files.paths[i]);
+    }
+    MemFree(files.paths);
+}
+
+/**
+ * Builds the perfect hash table for the given paths.
+ *
+ * Paths are split into buckets of about four. Starting with the largest buckets, each bucket gets
+ * the first seed that hashes all of its paths into free slots.
+ *
+ * @param slots Receives the slot for each path.
+ * @param seeds Receives the seed for each bucket.
+ *
+ * @return True on success, false on failure.
+ *
+ * @internal
+ */
+bool BuildPhysFSPackTable(const char** paths, int count, int bucketCount, int* slots, unsigned int* seeds) {
+    int* buckets = (int*)MemAlloc(sizeof(int) * (count + 1));
+    int* bucketStarts = (int*)MemAlloc(sizeof(int) * (bucketCount + 1));
+    int* members = (int*)MemAlloc(sizeof(int) * (count + 1));
+    int* order = (int*)MemAlloc(sizeof(int) * bucketCount);
+    bool* taken = (bool*)MemAlloc(sizeof(bool) * (count + 1));
+    bool output = buckets != 0 && bucketStarts != 0 && members != 0 && order != 0 && taken != 0;
+
+    // Group the paths by bucket.
+    for (int i = 0; output && i < count; i++) {
+        buckets[i] = (int)(HashPhysFSPackPath(paths[i], 0) % (unsigned int)bucketCount);
+        bucketStarts[buckets[i] + 1]++;
+    }
+    for (int i = 0; output && i < bucketCount; i++) {
+        bucketStarts[i + 1] += bucketStarts[i];
+        order[i] = bucketStarts[i];
+    }
+    for (int i = 0; output && i < count; i++) {
+        members[order[buckets[i]]++] = i;
+    }
+
+    // Sort the buckets from largest to smallest.
+    for (int i = 0; output && i < bucketCount; i++) {
+        int size = bucketStarts[i + 1] - bucketStarts[i];
+        int j = i;
+        while (j > 0 && bucketStarts[order[j - 1] + 1] - bucketStarts[order[j - 1]] < size) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    for (int i = 0; output && i < bucketCount; i++) {
+        int bucket = order[i];
+        int* bucketMembers = members + bucketStarts[bucket];
+        int memberCount = bucketStarts[bucket + 1] - bucketStarts[bucket];
+        if (memberCount == 0) {
+            break;
+        }
+
+        // Try seeds until all paths in the bucket land in distinct free slots.
+        bool placed = false;
+        for (unsigned int seed = 1; seed < 0x10000000u && !placed; seed++) {
+            placed = true;
+            for (int j = 0; j < memberCount && placed; j++) {
+                slots[bucketMembers[j]] = (int)(HashPhysFSPackPath(paths[bucketMembers[j]], seed) % (unsigned int)count);
+                placed = !taken[slots[bucketMembers[j]]];
+                for (int k = 0; k < j && placed; k++) {
+                    placed = slots[bucketMembers[k]] != slots[bucketMembers[j]];
+                }
+            }
+            if (placed) {
+                seeds[bucket] = seed;
+                for (int j = 0; j < memberCount; j++) {
+                    taken[slots[bucketMembers[j]]] = true;
+                }
+            }
+        }
+        output = placed;
+    }
+
+    MemFree(buckets);
+    MemFree(bucketStarts);
+    MemFree(members);
+    MemFree(order);
+    MemFree(taken);
+    return output;
+}
+
+/**
+ * Writes the given amount of zeros to a file.
+ *
+ * @internal
+ */
+bool WritePhysFSPadding(PHYSFS_File* file, long long size) {
+    unsigned char zeros[256] = { 0 };
+    while (size > 0) {
+        long long length = size < (long long)sizeof(zeros) ? size : (long long)sizeof(zeros);
+        if (PHYSFS_writeBytes(file, zeros, (PHYSFS_uint64)length) != length) {
+            return false;
+        }
+        size -= length;
+    }
+    return true;
+}
+
+/**
+ * Loads the file of the given job for a pack, and computes its checksum.
+ *
+ * @internal
+ */
+void LoadPhysFSJobPackEntry(PhysFSJobData* job) {
+    job->data = LoadFileDataFromPhysFS(job->fileName, &job->dataSize);
+    job->fileSize = job->dataSize;
+    if (job->data != 0 && job->dataSize > 0) {
+        job->checksum = ComputeCRC32(job->data, job->dataSize);
+    }
+}
+
+/**
+ * Loads and compresses the file of the given job for a pack.
+ *
+ * The compressed data is only kept when it saves at least an eighth, so the job's data is compressed
+ * whenever its dataSize is less than its fileSize. Files over PHYSFS_PACK_MAX_DEFLATED_SIZE are
+ * stored, since DecompressData() couldn't read them back.
+ *
+ * @internal
+ */
+void CompressPhysFSJobPackEntry(PhysFSJobData* job) {
+    LoadPhysFSJobPackEntry(job);
+    if (job->data == 0 || job->fileSize == 0 || job->fileSize > PHYSFS_PACK_MAX_DEFLATED_SIZE) {
+        return;
+    }
+
+    int compressedSize = 0;
+    unsigned char* compressed = CompressData(job->data, job->fileSize, &compressedSize);
+    if (compressed != 0 && compressedSize < job->fileSize - job->fileSize / 8) {
+        UnloadFileDataFromPhysFS(job->data);
+        job->data = compressed;
+        job->dataSize = compressedSize;
+    } else {
+        MemFree(compressed);
+    }
+}
+
+/**
+ * Queues the loading, and possibly compression, of a file for a pack.
+ *
+ * @return A handle to the job, or 0 on failure.
+ *
+ * @internal
+ */
+int QueuePhysFSPackJob(const char* fileName, const char* storedExtensions) {
+    PhysFSJobData* job = (PhysFSJobData*)MemAlloc(sizeof(PhysFSJobData));
+    if (job == 0) {
+        return 0;
+    }
+    job->fileName = CopyPhysFSString(fileName);
+    job->proc = CompressPhysFSJobPackEntry;
+    if (storedExtensions != 0 && storedExtensions[0] != '\0' && IsFileExtension(fileName, storedExtensions)) {
+        job->proc = LoadPhysFSJobPackEntry;
+    }
+
+    int handle = QueuePhysFSJob(job);
+    if (handle == 0) {
+        UnloadPhysFSJob(job);
+    }
+    return handle;
+}
+
+/**
+ * Compares two paths for qsort().
+ *
+ * @internal
+ */
+int ComparePhysFSPaths(const void* a, const void* b) {
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+/**
+ * Moves the files named in an access order to the front of the list, in the order they were first loaded.
+ *
+ * Recorded paths include the mount point the files were loaded from, so each path is matched with
+ * its leading directories stripped one at a time, and "assets/image.png" matches "image.png".
+ *
+ * @param files The files to sort, already sorted by path.
+ * @param prefixLength The length of the directory being packed, which isn't part of the paths in the pack.
+ * @param accessOrder The text from ExportPhysFSAccessOrder(), with one path per line.
+ *
+ * @internal
+ */
+void SortPhysFSPackFilesByAccess(FilePathList* files, int prefixLength, const char* accessOrder) {
+    int count = (int)files->count;
+    char* text = CopyPhysFSString(accessOrder);
+    char** sorted = (char**)MemAlloc(sizeof(char*) * (count + 1));
+    int* ranks = (int*)MemAlloc(sizeof(int) * (count + 1));
+    PhysFSHashMap map = { 0 };
+    bool success = text != 0 && sorted != 0 && ranks != 0;
+    for (int i = 0; success && i < count; i++) {
+        const char* path = files->paths[i] + prefixLength;
+        success = AddToPhysFSHashMap(&map, path, HashPhysFSString(path), i);
+        ranks[i] = -1;
+    }
+
+    // Rank the files by their first access.
+    int rankCount = 0;
+    char* next = text;
+    while (success && next != 0 && *next != '\0') {
+        char* line = next;
+        next = 0;
+        for (char* c = line; *c != '\0'; c++) {
+            if (*c == '\n' || *c == '\r') {
+                *c = '\0';
+                next = c + 1;
+                break;
+            }
+        }
+
+        for (const char* path = line; *path != '\0';) {
+            int index = FindInPhysFSHashMap(&map, path, HashPhysFSString(path));
+            if (index != -1) {
+                if (ranks[index] == -1) {
+                    ranks[index] = rankCount++;
+                }
+                break;
+            }
+            while (*path != '\0' && *path != '/') {
+                path++;
+            }
+            while (*path == '/') {
+                path++;
+            }
+        }
+    }
+
+    // Accessed files go first, followed by the rest in path order.
+    if (success) {
+        int position = rankCount;
+        for (int i = 0; i < count; i++) {
+            sorted[ranks[i] == -1 ? position++ : ranks[i]] = files->paths[i];
+        }
+        for (int i = 0; i < count; i++) {
+            files->paths[i] = sorted[i];
+        }
+        TraceLog(LOG_DEBUG, "PHYSFS: Laid out %i of %i files in access order", rankCount, count);
+    }
+
+    UnloadPhysFSHashMap(&map);
+    MemFree(text);
+    MemFree(sorted);
+    MemFree(ranks);
+}
+
+/**
+ * Writes the hash table, the entries and the names of a pack, followed by its header.
+ *
+ * @internal
+ */
+bool WritePhysFSPackIndex(PHYSFS_File* file, const char** paths, PhysFSPackEntry* entries, int count, unsigned long long indexOffset) {
+    int bucketCount = count / 4 + 1;
+    int* slots = (int*)MemAlloc(sizeof(int) * (count + 1));
+    int* bySlot = (int*)MemAlloc(sizeof(int) * (count + 1));
+    unsigned int* seeds = (unsigned int*)MemAlloc(sizeof(unsigned int) * bucketCount);
+    bool output = slots != 0 && bySlot != 0 && seeds != 0 && BuildPhysFSPackTable(paths, count, bucketCount, slots, seeds);
+
+    // Write the hash table seeds, the entries in slot order, and the names.
+    for (int i = 0; output && i < bucketCount; i++) {
+        unsigned char seed[4];
+        WritePhysFSUInt(seed, seeds[i], 4);
+        output = PHYSFS_writeBytes(file, seed, 4) == 4;
+    }
+    for (int i = 0; output && i < count; i++) {
+        bySlot[slots[i]] = i;
+    }
+    for (int slot = 0; output && slot < count; slot++) {
+        int i = bySlot[slot];
+        unsigned char record[PHYSFS_PACK_ENTRY_SIZE] = { 0 };
+        WritePhysFSUInt(record, entries[i].offset, 8);
+        WritePhysFSUInt(record + 8, entries[i].size, 8);
+        WritePhysFSUInt(record + 16, entries[i].compressedSize, 8);
+        WritePhysFSUInt(record + 24, entries[i].nameOffset, 4);
+        record[28] = entries[i].codec;
+        output = PHYSFS_writeBytes(file, record, PHYSFS_PACK_ENTRY_SIZE) == PHYSFS_PACK_ENTRY_SIZE;
+    }
+    unsigned int stringsSize = 0;
+    for (int i = 0; output && i < count; i++) {
+        PHYSFS_sint64 length = (PHYSFS_sint64)TextLength(paths[i]) + 1;
+        output = PHYSFS_writeBytes(file, paths[i], length) == length;
+        stringsSize += (unsigned int)length;
+    }
+    if (output && count == 0) {
+        output = WritePhysFSPadding(file, 1);
+        stringsSize = 1;
+    }
+
+    // Fill in the header.
+    unsigned char header[PHYSFS_PACK_HEADER_SIZE] = { 'R', 'P', 'A', 'K' };
+    WritePhysFSUInt(header + 4, PHYSFS_PACK_VERSION, 4);
+    WritePhysFSUInt(header + 8, (unsigned long long)count, 4);
+    WritePhysFSUInt(header + 12, (unsigned long long)bucketCount, 4);
+    WritePhysFSUInt(header + 16, stringsSize, 4);
+    WritePhysFSUInt(header + 20, RAYLIB_PHYSFS_PACK_ALIGNMENT, 4);
+    WritePhysFSUInt(header + 24, indexOffset, 8);
+    output = output && PHYSFS_seek(file, 0) != 0 && PHYSFS_writeBytes(file, header, PHYSFS_PACK_HEADER_SIZE) == PHYSFS_PACK_HEADER_SIZE;
+
+    MemFree(slots);
+    MemFree(bySlot);
+    MemFree(seeds);
+    return output;
+}
+
+/**
+ * Writes the local header of a ZIP entry, or the central directory header when central is true.
+ *
+ * @internal
+ */
+bool WritePhysFSZipHeader(PHYSFS_File* file, const char* path, PhysFSPackEntry entry, unsigned int checksum, bool central) {
+    unsigned char header[PHYSFS_ZIP_CENTRAL_HEADER_SIZE] = { 0 };
+    unsigned char* fields = header + (central ? 6 : 4);
+    WritePhysFSUInt(header, central ? 0x02014b50 : 0x04034b50, 4);
+    if (central) {
+        WritePhysFSUInt(header + 4, 20, 2);                    // Version made by
+    }
+    WritePhysFSUInt(fields, 20, 2);                            // Version needed to extract
+    WritePhysFSUInt(fields + 2, 0x0800, 2);                    // Names are UTF-8
+    WritePhysFSUInt(fields + 4, entry.codec == PHYSFS_PACK_CODEC_DEFLATE ? 8 : 0, 2);
+    WritePhysFSUInt(fields + 8, PHYSFS_ZIP_DATE, 2);
+    WritePhysFSUInt(fields + 10, checksum, 4);
+    WritePhysFSUInt(fields + 14, entry.compressedSize, 4);
+    WritePhysFSUInt(fields + 18, entry.size, 4);
+    WritePhysFSUInt(fields + 22, TextLength(path), 2);
+    if (central) {
+        WritePhysFSUInt(header + 42, entry.offset, 4);
+    }
+
+    PHYSFS_sint64 size = central ? PHYSFS_ZIP_CENTRAL_HEADER_SIZE : PHYSFS_ZIP_LOCAL_HEADER_SIZE;
+    PHYSFS_sint64 length = (PHYSFS_sint64)TextLength(path);
+    return PHYSFS_writeBytes(file, header, size) == size && PHYSFS_writeBytes(file, path, length) == length;
+}
+
+/**
+ * Writes the central directory of a ZIP archive, and the record that ends it.
+ *
+ * @internal
+ */
+bool WritePhysFSZipDirectory(PHYSFS_File* file, const char** paths, PhysFSPackEntry* entries, unsigned int* checksums, int count, unsigned long long directoryOffset) {
+    unsigned long long directorySize = 0;
+    bool output = true;
+    for (int i = 0; output && i < count; i++) {
+        output = WritePhysFSZipHeader(file, paths[i], entries[i], checksums[i], true);
+        directorySize += PHYSFS_ZIP_CENTRAL_HEADER_SIZE + TextLength(paths[i]);
+    }
+    if (directoryOffset + directorySize > 0xFFFFFFFFull) {
+        TraceLog(LOG_WARNING, "PHYSFS: ZIP archives over 4GB are not supported, use a pack instead");
+        return false;
+    }
+
+    unsigned char end[PHYSFS_ZIP_END_SIZE] = { 0 };
+    WritePhysFSUInt(end, 0x06054b50, 4);
+    WritePhysFSUInt(end + 8, (unsigned long long)count, 2);
+    WritePhysFSUInt(end + 10, (unsigned long long)count, 2);
+    WritePhysFSUInt(end + 12, directorySize, 4);
+    WritePhysFSUInt(end + 16, directoryOffset, 4);
+    return output && PHYSFS_writeBytes(file, end, PHYSFS_ZIP_END_SIZE) == PHYSFS_ZIP_END_SIZE;
+}
+
+/**
+ * Packs all files within a directory in PhysFS into a pack archive, in the write directory.
+ *
+ * Packs are read by an archiver that InitPhysFS() registers with PhysFS, so they mount like any
+ * other archive with MountPhysFS(). Paths are found through a perfect hash table rather than a
+ * directory walk, entries are compressed only when it saves space, and each entry starts on its
+ * own page, so that MapFileViewFromPhysFS() maps uncompressed entries without copying.
+ *
+ * When the file name ends with .zip, a ZIP archive is written instead.
+ *
+ * @param dirPath The directory in PhysFS to pack. Paths in the pack are relative to it.
+ * @param fileName The pack to write, usually with the .rpak extension.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see ExportPhysFSPackEx()
+ * @see MountPhysFS()
+ */
+bool ExportPhysFSPack(const char* dirPath, const char* fileName) {
+    return ExportPhysFSPackPro(dirPath, fileName, 0, 0);
+}
+
+/**
+ * Packs all files within a directory in PhysFS into a pack or ZIP archive, in the write directory,
+ * storing files with the given extensions as they are.
+ *
+ * @param dirPath The directory in PhysFS to pack. Paths in the pack are relative to it.
+ * @param fileName The archive to write. Archives ending with .zip are ZIP archives, others are packs.
+ * @param storedExtensions Files with these extensions, like ".ogg;.mp3;.png", are stored without trying to compress them. Can be 0.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see ExportPhysFSPackPro()
+ */
+bool ExportPhysFSPackEx(const char* dirPath, const char* fileName, const char* storedExtensions) {
+    return ExportPhysFSPackPro(dirPath, fileName, storedExtensions, 0);
+}
+
+/**
+ * Packs all files within a directory in PhysFS into a pack or ZIP archive, in the write directory.
+ *
+ * Files are loaded and compressed on the worker threads, a few ahead of the one being written.
+ * Entries are sorted by path and ZIP timestamps are fixed, so packing the same files always gives
+ * the same archive. Given an access order from ExportPhysFSAccessOrder(), the files it names come
+ * first instead, in the order they were loaded, so that loading them reads the archive sequentially.
+ * Files over 64MB are always stored, as raylib can't decompress more than that at once.
+ *
+ * @param dirPath The directory in PhysFS to pack. Paths in the pack are relative to it.
+ * @param fileName The archive to write. Archives ending with .zip are ZIP archives, others are packs.
+ * @param storedExtensions Files with these extensions, like ".ogg;.mp3;.png", are stored without trying to compress them. Can be 0.
+ * @param accessOrder The text of an access order from ExportPhysFSAccessOrder(). Can be 0.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see ExportPhysFSPackEx()
+ * @see SetPhysFSAccessRecording()
+ */
+bool ExportPhysFSPackPro(const char* dirPath, const char* fileName, const char* storedExtensions, const char* accessOrder) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot export pack '%s' before InitPhysFS()", fileName);
+        return false;
+    }
+
+    while (*dirPath == '/') {
+        dirPath++;
+    }
+    OpenPhysFSLazyMounts(dirPath, true);
+    FilePathList files = { 0 };
+    AddPhysFSPackFiles(dirPath, &files);
+    if (files.count > 1) {
+        qsort(files.paths, files.count, sizeof(char*), ComparePhysFSPaths);
+    }
+    int prefixLength = dirPath[0] == '\0' ? 0 : (int)TextLength(dirPath) + 1;
+    if (accessOrder != 0) {
+        SortPhysFSPackFilesByAccess(&files, prefixLength, accessOrder);
+    }
+
+    bool isZip = IsFileExtension(fileName, ".zip");
+    int count = (int)files.count;
+    if (isZip && count > 0xFFFF) {
+        TraceLog(LOG_WARNING, "PHYSFS: ZIP archives of over 65535 files are not supported, use a pack instead");
+        UnloadPhysFSPackFiles(files);
+        return false;
+    }
+
+    PHYSFS_File* file = PHYSFS_openWrite(fileName);
+    if (file == 0) {
+        TracePhysFSError(fileName);
+        UnloadPhysFSPackFiles(files);
+        return false;
+    }
+
+    // Packs start with a header that's filled in at the end.
+    PhysFSPackEntry* entries = (PhysFSPackEntry*)MemAlloc(sizeof(PhysFSPackEntry) * (count + 1));
+    const char** paths = (const char**)MemAlloc(sizeof(const char*) * (count + 1));
+    unsigned int* checksums = (unsigned int*)MemAlloc(sizeof(unsigned int) * (count + 1));
+    int* jobs = (int*)MemAlloc(sizeof(int) * (count + 1));
+    bool output = entries != 0 && paths != 0 && checksums != 0 && jobs != 0 && WritePhysFSPadding(file, isZip ? 0 : PHYSFS_PACK_HEADER_SIZE);
+    unsigned long long position = isZip ? 0 : PHYSFS_PACK_HEADER_SIZE;
+    unsigned int stringsSize = 0;
+    int queued = 0;
+    for (int i = 0; output && i < count; i++) {
+        paths[i] = files.paths[i] + prefixLength;
+        entries[i].nameOffset = stringsSize;
+        stringsSize += TextLength(paths[i]) + 1;
+
+        // Keep the workers busy with the next few files.
+        while (queued < count && queued < i + RAYLIB_PHYSFS_WORKER_COUNT * 2) {
+            jobs[queued] = QueuePhysFSPackJob(files.paths[queued], storedExtensions);
+            queued++;
+        }
+        PhysFSJobData* job = TakePhysFSJob(jobs[i]);
+        jobs[i] = 0;
+        if (job == 0 || (job->data == 0 && job->fileSize != 0)) {
+            if (job != 0) {
+                UnloadPhysFSJob(job);
+            }
+            output = false;
+            break;
+        }
+
+        if (!isZip) {
+            long long padding = (long long)((RAYLIB_PHYSFS_PACK_ALIGNMENT - position % RAYLIB_PHYSFS_PACK_ALIGNMENT) % RAYLIB_PHYSFS_PACK_ALIGNMENT);
+            output = WritePhysFSPadding(file, padding);
+            position += (unsigned long long)padding;
+        }
+
+        entries[i].offset = position;
+        entries[i].size = (unsigned long long)job->fileSize;
+        entries[i].compressedSize = (unsigned long long)job->dataSize;
+        entries[i].codec = job->dataSize < job->fileSize ? PHYSFS_PACK_CODEC_DEFLATE : PHYSFS_PACK_CODEC_STORED;
+        checksums[i] = job->checksum;
+        if (isZip) {
+            output = output && WritePhysFSZipHeader(file, paths[i], entries[i], checksums[i], false);
+            position += PHYSFS_ZIP_LOCAL_HEADER_SIZE + TextLength(paths[i]);
+        }
+        if (output && job->dataSize > 0) {
+            output = PHYSFS_writeBytes(file, job->data, job->dataSize) == (PHYSFS_sint64)job->dataSize;
+        }
+        position += (unsigned long long)job->dataSize;
+        UnloadPhysFSJob(job);
+
+        if (isZip && position > 0xFFFFFFFFull) {
+            TraceLog(LOG_WARNING, "PHYSFS: ZIP archives over 4GB are not supported, use a pack instead");
+            output = false;
+        }
+    }
+
+    // Cancel whatever is still queued after a failure.
+    for (int i = 0; jobs != 0 && i < queued; i++) {
+        if (jobs[i] != 0) {
+            CancelPhysFSJob(jobs[i]);
+        }
+    }
+
+    if (output) {
+        if (isZip) {
+            output = WritePhysFSZipDirectory(file, paths, entries, checksums, count, position);
+        } else {
+            output = WritePhysFSPackIndex(file, paths, entries, count, position);
+        }
+    }
+
+    if (PHYSFS_close(file) == 0 || !output) {
+        TracePhysFSError(fileName);
+        output = false;
+    } else {
+        UpdatePhysFSIndexPath(fileName);
+        InvalidatePhysFSPathIds();
+        TraceLog(LOG_INFO, "PHYSFS: Exported %i files from '%s' to '%s'", count, dirPath, fileName);
+    }
+
+    MemFree(entries);
+    MemFree(paths);
+    MemFree(checksums);
+    MemFree(jobs);
+    UnloadPhysFSPackFiles(files);
+    return output;
+}
+
+/**
+ * Initialize the PhysFS virtual file system.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see ClosePhysFS()
+ */
+bool InitPhysFS() {
+    // Initialize PhysFS.
+    if (PHYSFS_init(0) == 0) {
+        TracePhysFSError("InitPhysFS() failed");
+        return false;
+    }
+
+    InitPhysFSMutex(physfsCacheMutex);
+    InitPhysFSMutex(physfsIndexMutex);
+    InitPhysFSMutex(physfsLazyMutex);
+    InitPhysFSCondition(physfsLazyOpened);
+    InitPhysFSMutex(physfsPathIdMutex);
+    for (int i = 0; i < PHYSFS_PATH_ID_LOCKS; i++) {
+        InitPhysFSMutex(physfsPathIdLocks[i]);
+    }
+    InitPhysFSMutex(physfsAccessMutex);
+    InitPhysFSMutex(physfsIOMutex);
+#ifdef RAYLIB_PHYSFS_TRACK_MEMORY
+    InitPhysFSMutex(physfsMemoryMutex);
+#endif
+    InitPhysFSMutex(physfsPackMutex);
+#ifdef RAYLIB_PHYSFS_MMAP
+    InitPhysFSMutex(physfsZipMutex);
+    InitPhysFSMutex(physfsMappedArchiveMutex);
+#endif
+    InitPhysFSMutex(physfsImageMapMutex);
+#ifdef RAYLIB_PHYSFS_STATS
+    InitPhysFSMutex(physfsStatsMutex);
+    physfsStatsGeneration++;
+#endif
+#ifdef RAYLIB_PHYSFS_TRACE
+    InitPhysFSMutex(physfsTraceMutex);
+    physfsTraceGeneration++;
+    physfsTraceStartTime = GetPhysFSTime();
+#endif
+    InitPhysFSMutex(physfsMusicMutex);
+    InitPhysFSMutex(physfsJobMutex);
+    InitPhysFSCondition(physfsJobQueued);
+    InitPhysFSCondition(physfsJobDone);
+
+    // Mount packs from ExportPhysFSPack() like any other archive.
+    if (PHYSFS_registerArchiver(&physfsPackArchiver) == 0) {
+        TracePhysFSError("Failed to register the pack archiver");
+    }
+
+    // Set the default write directory, and report success.
+    SetPhysFSWriteDirectory(GetWorkingDirectory());
+    TraceLog(LOG_DEBUG, "PHYSFS: Initialized PhysFS");
+    return true;
+}
+
+/**
+ * Initialize the PhysFS virtual file system with the given mount point.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see ClosePhysFS()
+ */
+bool InitPhysFSEx(const char* newDir, const char* mountPoint) {
+    if (InitPhysFS()) {
+        return MountPhysFS(newDir, mountPoint);
+    }
+    return false;
+}
+
+/**
+ * Check if PhysFS has been initialized successfully.
+ *
+ * @return True if PhysFS is initialized, false otherwise.
+ *
+ * @see InitPhysFS()
+ */
+bool IsPhysFSReady() {
+    return PHYSFS_isInit() != 0;
+}
+
+/**
+ * Mounts the given directory, at the given mount point.
+ *
+ * @param newDir Directory or archive to add to the path, in platform-dependent notation.
+ * @param mountPoint Location in the interpolated tree that this archive will be "mounted", in platform-independent notation. NULL or "" is equivalent to "/".
+ *
+ * @return True on success, false on failure.
+ *
+ * @see UnmountPhysFS()
+ */
+bool MountPhysFS(const char* newDir, const char* mountPoint) {
+    // Lazy mounts registered before, that overlap the mount point, keep their place ahead of it.
+    OpenPhysFSLazyMounts(mountPoint != 0 ? mountPoint : "", true);
+    if (PHYSFS_mount(newDir, mountPoint, 1) == 0) {
+        TracePhysFSError(mountPoint);
+        return false;
+    }
+
+    ClearPhysFSCache();
+    InvalidatePhysFSPathIds();
+    AddPhysFSIndexMount(newDir, mountPoint, true);
+    AddPhysFSZipArchive(newDir);
+    TraceLog(LOG_DEBUG, "PHYSFS: Mounted '%s' at '%s'", newDir, mountPoint);
+    return true;
+}
+
+/**
+ * Mounts the given file data as a mount point in PhysFS.
+ *
+ * @param fileData The archive data as a file buffer.
+ * @param dataSize The size of the file buffer.
+ * @param newDir A filename that can represent the file data. Has to be unique. For example: data.zip
+ * @param mountPoint The location in the tree that the archive will be mounted.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see MountPhysFS()
+ */
+bool MountPhysFSFromMemory(const unsigned char *fileData, int dataSize, const char* newDir, const char* mountPoint) {
+    if (dataSize <= 0) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot mount a data size of 0");
+        return false;
+    }
+
+    OpenPhysFSLazyMounts(mountPoint != 0 ? mountPoint : "", true);
+    if (PHYSFS_mountMemory(fileData, dataSize, 0, newDir, mountPoint, 1) == 0) {
+        TracePhysFSError(TextFormat("Failed to mount '%s' at '%s'", newDir, mountPoint));
+        return false;
+    }
+
+    ClearPhysFSCache();
+    InvalidatePhysFSPathIds();
+    AddPhysFSIndexMount(newDir, mountPoint, false);
+    TraceLog(LOG_DEBUG, "PHYSFS: Mounted memory '%s' at '%s'", newDir, mountPoint);
+    return true;
+}
+
+/**
+ * Unmaps an archive that was mapped by MountPhysFSMapped(), once PhysFS is done with it.
+ *
+ * @param data The base address of the mapping.
+ *
+ * @internal
+ */
+void UnmapPhysFSArchive(void* data) {
+#ifdef RAYLIB_PHYSFS_MMAP
+    LockPhysFSMutex(physfsMappedArchiveMutex);
+    for (int i = 0; i < physfsMappedArchiveCount; i++) {
+        if (physfsMappedArchives[i].mapping == data) {
+            munmap(data, (size_t)physfsMappedArchives[i].mappingSize);
+            physfsMappedArchives[i] = physfsMappedArchives[--physfsMappedArchiveCount];
+            break;
+        }
+    }
+    UnlockPhysFSMutex(physfsMappedArchiveMutex);
+#else
+    (void)data;
+#endif
+}
+
+/**
+ * Memory maps the given archive, and mounts it at the given mount point.
+ *
+ * Reads from the archive are served straight from the mapping, rather than through file handle
+ * I/O. Directories, and platforms without memory mapping, fall back to MountPhysFS().
+ *
+ * @param newDir The archive to map, in platform-dependent notation. This is also the name to pass to UnmountPhysFS().
+ * @param mountPoint Location in the interpolated tree that this archive will be "mounted", in platform-independent notation. NULL or "" is equivalent to "/".
+ * @param prefault Whether to have the whole archive read into memory up front, rather than on first access.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see MountPhysFS()
+ * @see UnmountPhysFS()
+ */
+bool MountPhysFSMapped(const char* newDir, const char* mountPoint, bool prefault) {
+#ifdef RAYLIB_PHYSFS_MMAP
+    int fd = open(newDir, O_RDONLY);
+    if (fd == -1) {
+        TraceLog(LOG_WARNING, "PHYSFS: Failed to open archive '%s'", newDir);
+        return false;
+    }
+
+    // Only regular files can be mapped.
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0) {
+        close(fd);
+        return MountPhysFS(newDir, mountPoint);
+    }
+
+    // Like MountPhysFS(), lazy mounts registered before that overlap it keep their place ahead of it.
+    OpenPhysFSLazyMounts(mountPoint != 0 ? mountPoint : "", true);
+
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (prefault) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    size_t mappingSize = (size_t)info.st_size;
+    void* mapping = mmap(0, mappingSize, PROT_READ, flags, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        TraceLog(LOG_WARNING, "PHYSFS: Failed to map archive '%s'", newDir);
+        return false;
+    }
+#ifndef MAP_POPULATE
+    if (prefault) {
+        madvise(mapping, mappingSize, MADV_WILLNEED);
+    }
+#endif
+
+    // Keep track of the mapping size so it can be unmapped later.
+    LockPhysFSMutex(physfsMappedArchiveMutex);
+    FileView* mappedArchives = (FileView*)MemRealloc(physfsMappedArchives, sizeof(FileView) * (physfsMappedArchiveCount + 1));
+    if (mappedArchives == 0) {
+        UnlockPhysFSMutex(physfsMappedArchiveMutex);
+        munmap(mapping, mappingSize);
+        return false;
+    }
+    physfsMappedArchives = mappedArchives;
+    FileView* archive = &physfsMappedArchives[physfsMappedArchiveCount++];
+    archive->data = (const unsigned char*)mapping;
+    archive->size = 0;
+    archive->mapping = mapping;
+    archive->mappingSize = (unsigned long long)mappingSize;
+    UnlockPhysFSMutex(physfsMappedArchiveMutex);
+
+    // PhysFS calls UnmapPhysFSArchive() when the mount is no longer in use.
+    if (PHYSFS_mountMemory(mapping, (PHYSFS_uint64)mappingSize, UnmapPhysFSArchive, newDir, mountPoint, 1) == 0) {
+        TracePhysFSError(TextFormat("Failed to mount '%s' at '%s'", newDir, mountPoint));
+        UnmapPhysFSArchive(mapping);
+        return false;
+    }
+
+    ClearPhysFSCache();
+    InvalidatePhysFSPathIds();
+    AddPhysFSIndexMount(newDir, mountPoint, true);
+    AddPhysFSZipArchive(newDir);
+    TraceLog(LOG_DEBUG, "PHYSFS: Mounted mapped '%s' at '%s'", newDir, mountPoint);
+    return true;
+#else
+    (void)prefault;
+    return MountPhysFS(newDir, mountPoint);
+#endif
+}
+
+/**
+ * Registers the given directory or archive, to be mounted the first time a path within its mount point is looked up.
+ *
+ * Mounting an archive reads its whole list of files up front, so mounting many large archives
+ * takes a while even when few of them get used. A lazy mount is only mounted once something
+ * within its mount point is looked up, or a directory leading to it is listed. The directories
+ * leading to its mount point exist without mounting it. It keeps its place in the search path
+ * as of when it was registered: mounting it mounts the lazy mounts registered before it whose mount
+ * points overlap its own first, and mounting anything over or within its mount point mounts it
+ * first. Give each archive its own mount point, like "dlc/pack01", so that lookups elsewhere don't
+ * mount it.
+ *
+ * @param newDir Directory or archive to add to the path, in platform-dependent notation. This is also the name to pass to UnmountPhysFS().
+ * @param mountPoint Location in the interpolated tree that this archive will be "mounted", in platform-independent notation. NULL or "" is equivalent to "/".
+ *
+ * @return True if the directory or archive exists, false otherwise.
+ *
+ * @see MountPhysFS()
+ * @see UnmountPhysFS()
+ */
+bool MountPhysFSLazy(const char* newDir, const char* mountPoint) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot mount '%s' before InitPhysFS()", newDir);
+        return false;
+    }
+    if (!FileExists(newDir)) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot mount missing '%s'", newDir);
+        return false;
+    }
+
+    if (mountPoint == 0) {
+        mountPoint = "";
+    }
+    while (*mountPoint == '/') {
+        mountPoint++;
+    }
+    PhysFSLazyMount lazyMount;
+    lazyMount.newDir = CopyPhysFSString(newDir);
+    lazyMount.mountPoint = CopyPhysFSString(mountPoint);
+    lazyMount.opening = false;
+    if (lazyMount.newDir == 0 || lazyMount.mountPoint == 0) {
+        MemFree(lazyMount.newDir);
+        MemFree(lazyMount.mountPoint);
+        return false;
+    }
+    int length = (int)TextLength(lazyMount.mountPoint);
+    while (length > 0 && lazyMount.mountPoint[length - 1] == '/') {
+        lazyMount.mountPoint[--length] = '\0';
+    }
+
+    LockPhysFSMutex(physfsLazyMutex);
+    bool output = GrowPhysFSArray((void**)&physfsLazyMounts, sizeof(PhysFSLazyMount) * (physfsLazyMountCount + 1));
+    if (output) {
+        physfsLazyMounts[physfsLazyMountCount] = lazyMount;
+        StorePhysFSAtomicInt(physfsLazyMountCount, physfsLazyMountCount + 1);
+    }
+    UnlockPhysFSMutex(physfsLazyMutex);
+    if (!output) {
+        MemFree(lazyMount.newDir);
+        MemFree(lazyMount.mountPoint);
+        return false;
+    }
+
+    InvalidatePhysFSPathIds();
+    TraceLog(LOG_DEBUG, "PHYSFS: Registered lazy '%s' at '%s'", newDir, mountPoint);
+    return true;
+}
+
+/**
+ * Unmounts the given directory or archive.
+ *
+ * @param oldDir The directory that was supplied to MountPhysFS's newDir.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see MountPhysFS()
+ */
+bool UnmountPhysFS(const char* oldDir) {
+    if (RemovePhysFSLazyMount(oldDir)) {
+        TraceLog(LOG_DEBUG, "PHYSFS: Unmounted lazy '%s' before it was used", oldDir);
+        return true;
+    }
+
+    if (PHYSFS_unmount(oldDir) == 0) {
+        TraceLog(LOG_WARNING, "PHYSFS: Failed to unmount directory '%s'", oldDir);
+        return false;
+    }
+
+    ClearPhysFSCache();
+    InvalidatePhysFSPathIds();
+    RemovePhysFSIndexMount(oldDir);
+    RemovePhysFSZipArchive(oldDir);
+    TraceLog(LOG_DEBUG, "PHYSFS: Unmounted '%s'", oldDir);
+    return true;
+}
+
+/**
+ * Determine if a file exists in the search path.
+ *
+ * @param fileName Filename in platform-independent notation.
+ *
+ * @return True if the file exists, false otherwise.
+ *
+ * @see DirectoryExistsInPhysFS()
+ */
+bool FileExistsInPhysFS(const char* fileName) {
+    double startTime = GetPhysFSCallTime();
+    bool output = IsPhysFSFile(fileName);
+    RecordPhysFSCall(PHYSFS_STATS_FILE_EXISTS, fileName, GetPhysFSCallTime() - startTime, 0.0, 0.0, 0, 0, false);
+    return output;
+}
+
+/**
+ * Determine if a directory exists in the search path.
+ *
+ * @param dirPath Directory in platform-independent notation.
+ *
+ * @return True if the directory exists, false otherwise.
+ *
+ * @see FileExistsInPhysFS()
+ */
+bool DirectoryExistsInPhysFS(const char* dirPath) {
+    PHYSFS_Stat stat;
+    if (!GetPhysFSPathStat(dirPath, &stat)) {
+        return false;
+    }
+    return stat.filetype == PHYSFS_FILETYPE_DIRECTORY;
+}
+
+/**
+ * Loads an image in the raw .rimg format written by ExportImageToPhysFS().
+ *
+ * The format is a 24 byte header of "RIMG", the width, the height, the pixel format, the amount of
+ * mipmaps and the size of the pixel data, all little-endian 32-bit integers, followed by the pixel
+ * data as raylib holds it in memory. Loading it is a single copy out of a file view.
+ *
+ * @internal
+ */
+Image LoadPhysFSRawImage(const char* fileName) {
+    Image output = { 0 };
+    double startTime = GetPhysFSCallTime();
+    FileView view = MapFileViewFromPhysFS(fileName);
+    double readTime = GetPhysFSCallTime();
+    if (view.data == 0) {
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_IMAGE, fileName, 0.0, readTime - startTime, 0.0, 0, 0, true);
+        return output;
+    }
+
+    if (view.size < PHYSFS_RAW_IMAGE_HEADER_SIZE || strncmp((const char*)view.data, "RIMG", 4) != 0) {
+        TraceLog(LOG_WARNING, "PHYSFS: '%s' is not a raw image", fileName);
+        UnmapFileView(view);
+        return output;
+    }
+    int width = (int)ReadPhysFSUInt32(view.data + 4);
+    int height = (int)ReadPhysFSUInt32(view.data + 8);
+    int format = (int)ReadPhysFSUInt32(view.data + 12);
+    int mipmaps = (int)ReadPhysFSUInt32(view.data + 16);
+    int dataSize = (int)ReadPhysFSUInt32(view.data + 20);
+    if (width <= 0 || height <= 0 || format <= 0 || mipmaps <= 0 || dataSize < GetPixelDataSize(width, height, format) || dataSize > view.size - PHYSFS_RAW_IMAGE_HEADER_SIZE) {
+        TraceLog(LOG_WARNING, "PHYSFS: Raw image '%s' is corrupt", fileName);
+        UnmapFileView(view);
+        return output;
+    }
+
+    output.data = MemAlloc(dataSize);
+    if (output.data != 0) {
+        for (int i = 0; i < dataSize; i++) {
+            ((unsigned char*)output.data)[i] = view.data[PHYSFS_RAW_IMAGE_HEADER_SIZE + i];
+        }
+        output.width = width;
+        output.height = height;
+        output.format = format;
+        output.mipmaps = mipmaps;
+    }
+    RecordPhysFSCall(PHYSFS_STATS_LOAD_IMAGE, fileName, 0.0, readTime - startTime, GetPhysFSCallTime() - readTime, view.size, 0, output.data == 0);
+    UnmapFileView(view);
+    return output;
+}
+
+/**
+ * Gets the transcoded variant of the given image from the image map, if it exists.
+ *
+ * @return The path of the variant, to be freed with MemFree(), or 0 if there is none.
+ *
+ * @internal
+ */
+char* GetPhysFSImageVariant(const char* fileName) {
+    if (physfsImageMapCount == 0 || !IsPhysFSReady()) {
+        return 0;
+    }
+
+    while (*fileName == '/') {
+        fileName++;
+    }
+    char* output = 0;
+    LockPhysFSMutex(physfsImageMapMutex);
+    int index = FindInPhysFSHashMap(&physfsImageMap, fileName, HashPhysFSString(fileName));
+    if (index != -1) {
+        output = CopyPhysFSString(physfsImageMapPaths[index * 2 + 1]);
+    }
+    UnlockPhysFSMutex(physfsImageMapMutex);
+
+    // Only use the variant when it is mounted.
+    if (output != 0 && !IsPhysFSFile(output)) {
+        MemFree(output);
+        output = 0;
+    }
+    return output;
+}
+
+/**
+ * Loads an image from PhysFS, without looking for a variant in the image map.
+ *
+ * @internal
+ */
+Image LoadPhysFSImage(const char* fileName) {
+    if (IsFileExtension(fileName, ".rimg")) {
+        return LoadPhysFSRawImage(fileName);
+    }
+    double startTime = GetPhysFSCallTime();
+    int bytesRead;
+    unsigned char* fileData = LoadFileDataFromPhysFS(fileName, &bytesRead);
+    double readTime = GetPhysFSCallTime();
+    if (bytesRead == 0) {
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_IMAGE, fileName, 0.0, readTime - startTime, 0.0, 0, 0, true);
+        struct Image output;
+        output.data = 0;
+        output.width = 0;
+        output.height = 0;
+        return output;
+    }
+
+    // Load from the memory.
+    const char* extension = GetFileExtension(fileName);
+    Image image = LoadImageFromMemory(extension, fileData, bytesRead);
+    UnloadFileDataFromPhysFS(fileData);
+    RecordPhysFSCall(PHYSFS_STATS_LOAD_IMAGE, fileName, 0.0, readTime - startTime, GetPhysFSCallTime() - readTime, bytesRead, 0, image.data == 0);
+    return image;
+}
+
+/**
+ * Load an image from PhysFS.
+ *
+ * Images with a transcoded variant in the image map are loaded from the variant instead.
+ *
+ * @param fileName The filename to load from the search paths.
+ *
+ * @return The loaded image on success. An empty Image otherwise.
+ *
+ * @see LoadPhysFSImageMap()
+ */
+Image LoadImageFromPhysFS(const char* fileName) {
+    // Load the transcoded variant when there is one. Variants aren't mapped again, so a map that
+    // leads back to an image can't recurse.
+    char* variant = GetPhysFSImageVariant(fileName);
+    if (variant != 0) {
+        Image image = LoadPhysFSImage(variant);
+        MemFree(variant);
+        if (image.data != 0) {
+            return image;
+        }
+    }
+
+    return LoadPhysFSImage(fileName);
+}
+
+/**
+ * Exports an image to a file in the PhysFS write directory.
+ *
+ * Images saved with the .rimg extension are written in a raw format that loads with a single
+ * copy. Other file types are encoded with ExportImageToMemory().
+ *
+ * @param image The image to export.
+ * @param fileName The file to write.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see LoadImageFromPhysFS()
+ */
+bool ExportImageToPhysFS(Image image, const char* fileName) {
+    if (image.data == 0 || image.width <= 0 || image.height <= 0) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot export an empty image to '%s'", fileName);
+        return false;
+    }
+
+    if (!IsFileExtension(fileName, ".rimg")) {
+        int fileSize = 0;
+        unsigned char* fileData = ExportImageToMemory(image, GetFileExtension(fileName), &fileSize);
+        if (fileData == 0) {
+            TraceLog(LOG_WARNING, "PHYSFS: Failed to encode image for '%s'", fileName);
+            return false;
+        }
+        bool output = SaveFileDataToPhysFS(fileName, fileData, fileSize);
+        MemFree(fileData);
+        return output;
+    }
+
+    // Sum up the size of all the mipmaps.
+    int dataSize = 0;
+    int width = image.width;
+    int height = image.height;
+    for (int i = 0; i < image.mipmaps; i++) {
+        dataSize += GetPixelDataSize(width, height, image.format);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+
+    unsigned char* fileData = (unsigned char*)MemAlloc(PHYSFS_RAW_IMAGE_HEADER_SIZE + dataSize);
+    if (fileData == 0) {
+        return false;
+    }
+    fileData[0] = 'R';
+    fileData[1] = 'I';
+    fileData[2] = 'M';
+    fileData[3] = 'G';
+    WritePhysFSUInt(fileData + 4, (unsigned long long)image.width, 4);
+    WritePhysFSUInt(fileData + 8, (unsigned long long)image.height, 4);
+    WritePhysFSUInt(fileData + 12, (unsigned long long)image.format, 4);
+    WritePhysFSUInt(fileData + 16, (unsigned long long)image.mipmaps, 4);
+    WritePhysFSUInt(fileData + 20, (unsigned long long)dataSize, 4);
+    for (int i = 0; i < dataSize; i++) {
+        fileData[PHYSFS_RAW_IMAGE_HEADER_SIZE + i] = ((unsigned char*)image.data)[i];
+    }
+    bool output = SaveFileDataToPhysFS(fileName, fileData, PHYSFS_RAW_IMAGE_HEADER_SIZE + dataSize);
+    MemFree(fileData);
+    return output;
+}
+
+/**
+ * Loads a map of images to their transcoded variants, as written by the raylib-physfs-transcode tool.
+ *
+ * Each line of the map holds an image path and the path of its variant, separated by a space, both
+ * relative to the map's directory. Afterwards, LoadImageFromPhysFS() loads the variant of any mapped
+ * image instead, as long as the variant is mounted. Loading another map adds to the current one.
+ *
+ * @param fileName The image map, usually raylib-physfs-images.txt.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see UnloadPhysFSImageMap()
+ */
+bool LoadPhysFSImageMap(const char* fileName) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot load image map '%s' before InitPhysFS()", fileName);
+        return false;
+    }
+
+    char* text = LoadFileTextFromPhysFS(fileName);
+    if (text == 0) {
+        return false;
+    }
+
+    // Paths are relative to the map.
+    while (*fileName == '/') {
+        fileName++;
+    }
+    int directoryLength = GetPhysFSPackParentLength(fileName);
+
+    int count = 0;
+    char* next = text;
+    LockPhysFSMutex(physfsImageMapMutex);
+    while (next != 0 && *next != '\0') {
+        char* line = next;
+        next = 0;
+        for (char* c = line; *c != '\0'; c++) {
+            if (*c == '\n') {
+                *c = '\0';
+                next = c + 1;
+                break;
+            }
+        }
+
+        char* image = GetPhysFSManifestToken(&line);
+        char* variant = GetPhysFSManifestToken(&line);
+        if (image == 0 || variant == 0 || image[0] == '#') {
+            continue;
+        }
+        int length = (int)TextLength(variant);
+        if (variant[length - 1] == '\r') {
+            variant[length - 1] = '\0';
+        }
+
+        if (!GrowPhysFSArray((void**)&physfsImageMapPaths, sizeof(char*) * (physfsImageMapCount + 1) * 2)) {
+            break;
+        }
+        char* imagePath = directoryLength == 0 ? CopyPhysFSString(image) : FormatPhysFSString("%.*s/%s", directoryLength, fileName, image);
+        char* variantPath = directoryLength == 0 ? CopyPhysFSString(variant) : FormatPhysFSString("%.*s/%s", directoryLength, fileName, variant);
+        if (imagePath == 0 || variantPath == 0) {
+            MemFree(imagePath);
+            MemFree(variantPath);
+            break;
+        }
+
+        // Replace any earlier variant of the same image.
+        unsigned int hash = HashPhysFSString(imagePath);
+        int index = FindInPhysFSHashMap(&physfsImageMap, imagePath, hash);
+        if (index != -1) {
+            MemFree(imagePath);
+            MemFree(physfsImageMapPaths[index * 2 + 1]);
+            physfsImageMapPaths[index * 2 + 1] = variantPath;
+        } else if (AddToPhysFSHashMap(&physfsImageMap, imagePath, hash, physfsImageMapCount)) {
+            physfsImageMapPaths[physfsImageMapCount * 2] = imagePath;
+            physfsImageMapPaths[physfsImageMapCount * 2 + 1] = variantPath;
+            physfsImageMapCount++;
+        } else {
+            MemFree(imagePath);
+            MemFree(variantPath);
+            break;
+        }
+        count++;
+    }
+    UnlockPhysFSMutex(physfsImageMapMutex);
+    UnloadFileTextFromPhysFS(text);
+
+    TraceLog(LOG_DEBUG, "PHYSFS: Loaded %i images from image map '%s'", count, fileName);
+    return true;
+}
+
+/**
+ * Unloads all image maps, so that LoadImageFromPhysFS() loads images as they are.
+ *
+ * @see LoadPhysFSImageMap()
+ */
+void UnloadPhysFSImageMap() {
+    if (!IsPhysFSReady()) {
+        return;
+    }
+
+    LockPhysFSMutex(physfsImageMapMutex);
+    for (int i = 0; i < physfsImageMapCount * 2; i++) {
+        MemFree(physfsImageMapPaths[i]);
+    }
+    MemFree(physfsImageMapPaths);
+    UnloadPhysFSHashMap(&physfsImageMap);
+    physfsImageMapPaths = 0;
+    physfsImageMapCount = 0;
+    UnlockPhysFSMutex(physfsImageMapMutex);
+}
+
+/**
+ * Load a texture from PhysFS.
+ *
+ * @param fileName The filename to load from the search paths.
+ *
+ * @return The loaded texture on success. An empty texture otherwise.
+ *
+ * @see LoadImageFromPhysFS()
+ */
+Texture2D LoadTextureFromPhysFS(const char* fileName) {
+    Image image = LoadImageFromPhysFS(fileName);
+    if (image.data == 0) {
+        Texture2D output = { 0 };
+        output.id = 0;
+        output.format = 0;
+        output.width = 0;
+        output.height = 0;
+        return output;
+    }
+    Texture2D texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+    return texture;
+}
+
+/**
+ * Loads and decodes the image of the given job.
+ *
+ * @internal
+ */
+void LoadPhysFSJobImage(PhysFSJobData* job) {
+    job->image = LoadImageFromPhysFS(job->fileName);
+    job->dataSize = GetPhysFSFileLength(job->fileName);
+}
+
+/**
+ * Load many images from PhysFS, reading and decoding them across the worker threads.
+ *
+ * Blocks until all images are loaded, ahead of any other asynchronous loads.
+ *
+ * @param fileNames The filenames to load from the search paths.
+ * @param count The number of filenames.
+ * @param images Where to store the loaded images, in the same order as the filenames. Images that fail to load are empty.
+ *
+ * @return The number of images that were loaded successfully.
+ *
+ * @see LoadImageFromPhysFS()
+ * @see LoadTexturesFromPhysFS()
+ */
+int LoadImagesFromPhysFS(const char** fileNames, int count, Image* images) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    int* jobs = (int*)MemAlloc(sizeof(int) * count);
+    if (jobs == 0) {
+        return 0;
+    }
+
+    // Queue all images so that the workers decode them in parallel.
+    for (int i = 0; i < count; i++) {
+        PhysFSJobData* job = IsPhysFSReady() ? (PhysFSJobData*)MemAlloc(sizeof(PhysFSJobData)) : 0;
+        if (job != 0) {
+            job->fileName = CopyPhysFSString(fileNames[i]);
+            job->priority = 0x7FFFFFFF;
+            job->proc = LoadPhysFSJobImage;
+            jobs[i] = QueuePhysFSJob(job);
+            if (jobs[i] == 0) {
+                UnloadPhysFSJob(job);
+            }
+        }
+    }
+
+    // Collect the results, loading anything that could not be queued on this thread.
+    int loaded = 0;
+    for (int i = 0; i < count; i++) {
+        PhysFSJobData* job = jobs[i] != 0 ? TakePhysFSJob(jobs[i]) : 0;
+        if (job != 0) {
+            images[i] = job->image;
+            job->image.data = 0;
+            UnloadPhysFSJob(job);
+        } else {
+            images[i] = LoadImageFromPhysFS(fileNames[i]);
+        }
+        if (images[i].data != 0) {
+            loaded++;
+        }
+    }
+
+    MemFree(jobs);
+    return loaded;
+}
+
+/**
+ * Load many textures from PhysFS.
+ *
+ * The images are read and decoded across the worker threads, while only the upload to the GPU
+ * happens on the calling thread.
+ *
+ * @param fileNames The filenames to load from the search paths.
+ * @param count The number of filenames.
+ * @param textures Where to store the loaded textures, in the same order as the filenames. Textures that fail to load are empty.
+ *
+ * @return The number of textures that were loaded successfully.
+ *
+ * @see LoadImagesFromPhysFS()
+ * @see LoadTextureFromPhysFS()
+ */
+int LoadTexturesFromPhysFS(const char** fileNames, int count, Texture2D* textures) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    Image* images = (Image*)MemAlloc(sizeof(Image) * count);
+    if (images == 0) {
+        return 0;
+    }
+    LoadImagesFromPhysFS(fileNames, count, images);
+
+    int loaded = 0;
+    for (int i = 0; i < count; i++) {
+        if (images[i].data == 0) {
+            Texture2D output = { 0 };
+            textures[i] = output;
+            continue;
+        }
+        textures[i] = LoadTextureFromImage(images[i]);
+        UnloadImage(images[i]);
+        if (textures[i].id != 0) {
+            loaded++;
+        }
+    }
+
+    MemFree(images);
+    return loaded;
+}
+
+/**
+ * Loads text from PhysFS, like LoadFileTextFromPhysFS().
+ *
+ * @param track Whether to track the text for GetPhysFSMemoryStats(), which text that's freed with UnloadFileText() shouldn't be.
+ *
+ * @internal
+ */
+char* LoadPhysFSFileText(const char* fileName, bool track) {
+    double startTime = GetPhysFSCallTime();
+    int bytesRead;
+    unsigned char* data = LoadFileDataFromPhysFS(fileName, &bytesRead);
+    double readTime = GetPhysFSCallTime();
+    if (bytesRead == 0) {
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_FILE_TEXT, fileName, 0.0, readTime - startTime, 0.0, 0, 0, data == 0);
+        return 0;
+    }
+
+    // Copy the data, and append a null terminator.
+    char* text = (char*)MemAlloc(bytesRead + 1);
+    for (int i = 0; i < bytesRead; i++) {
+        text[i] = (char)data[i];
+    }
+    text[bytesRead] = '\0';
+    if (track) {
+        TrackPhysFSAllocation(text, bytesRead + 1, "LoadFileTextFromPhysFS", fileName);
+    }
+
+    // Free the original data, and return the string.
+    UnloadFileDataFromPhysFS(data);
+    RecordPhysFSCall(PHYSFS_STATS_LOAD_FILE_TEXT, fileName, 0.0, readTime - startTime, 0.0, bytesRead, 0, false);
+
+    return text;
+}
+
+/**
+ * Load text data from file (read). Make sure to call UnloadFileTextFromPhysFS() when done.
+ *
+ * @param fileName The file name to load from the PhysFS mount paths.
+ *
+ * @return A '\0' terminated string.
+ *
+ * @see UnloadFileTextFromPhysFS()
+ */
+char* LoadFileTextFromPhysFS(const char *fileName) {
+    return LoadPhysFSFileText(fileName, true);
+}
+
+/**
+ * Load wave data from PhysFS.
+ *
+ * @param fileName The file name to load from the PhysFS mount paths.
+ *
+ * @return The Wave object, or an empty Wave object on failure.
+ *
+ * @see UnloadWave()
+ */
+Wave LoadWaveFromPhysFS(const char* fileName) {
+    double startTime = GetPhysFSCallTime();
+    unsigned int bytesRead;
+    unsigned char* fileData = LoadFileDataFromPhysFS(fileName, &bytesRead);
+    double readTime = GetPhysFSCallTime();
+    if (bytesRead == 0) {
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_WAVE, fileName, 0.0, readTime - startTime, 0.0, 0, 0, true);
+        struct Wave output;
+        output.data = 0;
+        return output;
+    }
+
+    // Load from the memory.
+    const char* extension = GetFileExtension(fileName);
+    Wave wave = LoadWaveFromMemory(extension, fileData, bytesRead);
+    UnloadFileDataFromPhysFS(fileData);
+    RecordPhysFSCall(PHYSFS_STATS_LOAD_WAVE, fileName, 0.0, readTime - startTime, GetPhysFSCallTime() - readTime, bytesRead, 0, wave.data == 0);
+    return wave;
+}
+
+/**
+ * Load music from PhysFS, to be streamed.
+ *
+ * Music from mounted directories, or stored uncompressed in ZIP archives, is streamed straight
+ * from a memory mapping of the file, so only the pages being decoded stay resident. Compressed
+ * entries are loaded into memory first.
+ *
+ * @param fileName The file name to load from the PhysFS mount paths.
+ *
+ * @return The Music object, or an empty Music object on failure. Make sure to use UnloadMusicStreamFromPhysFS() when finished.
+ *
+ * @see UnloadMusicStreamFromPhysFS()
+ * @see MapFileViewFromPhysFS()
+ */
+Music LoadMusicStreamFromPhysFS(const char* fileName) {
+    double startTime = GetPhysFSCallTime();
+    FileView view = MapFileViewFromPhysFS(fileName);
+    double readTime = GetPhysFSCallTime();
+    if (view.size == 0) {
+        UnmapFileView(view);
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_MUSIC, fileName, 0.0, readTime - startTime, 0.0, 0, 0, true);
+        struct Music output;
+        output.ctxData = 0;
+        output.stream.buffer = 0;
+        return output;
+    }
+
+#ifdef RAYLIB_PHYSFS_MMAP
+    // The decoder reads through the file front to back.
+    if (view.mapping != 0) {
+        madvise(view.mapping, (size_t)view.mappingSize, MADV_SEQUENTIAL);
+    }
+#endif
+
+    // Load from the memory.
+    const char* extension = GetFileExtension(fileName);
+    Music music = LoadMusicStreamFromMemory(extension, view.data, view.size);
+    RecordPhysFSCall(PHYSFS_STATS_LOAD_MUSIC, fileName, 0.0, readTime - startTime, GetPhysFSCallTime() - readTime, view.size, 0, music.ctxData == 0);
+
+    // Unload the file data if the music failed to load.
+    if (music.ctxData == (void*)0) {
+        UnmapFileView(view);
+        return music;
+    }
+
+    // The decoder reads from the file data for as long as the music is loaded.
+    LockPhysFSMutex(physfsMusicMutex);
+    PhysFSMusicData* musics = (PhysFSMusicData*)MemRealloc(physfsMusics, sizeof(PhysFSMusicData) * (physfsMusicCount + 1));
+    if (musics == 0) {
+        UnlockPhysFSMutex(physfsMusicMutex);
+        UnloadMusicStream(music);
+        UnmapFileView(view);
+        struct Music output;
+        output.ctxData = 0;
+        output.stream.buffer = 0;
+        return output;
+    }
+    physfsMusics = musics;
+    physfsMusics[physfsMusicCount].music = music;
+    physfsMusics[physfsMusicCount].view = view;
+    physfsMusicCount++;
+    UnlockPhysFSMutex(physfsMusicMutex);
+
+    return music;
+}
+
+/**
+ * Unload music that was loaded with LoadMusicStreamFromPhysFS(), along with its file data.
+ *
+ * This must be used rather than UnloadMusicStream(), which would leave the file data loaded. Music
+ * that was already unloaded, or that ClosePhysFS() unloaded, is skipped.
+ *
+ * @param music The music to unload.
+ *
+ * @see LoadMusicStreamFromPhysFS()
+ */
+void UnloadMusicStreamFromPhysFS(Music music) {
+    if (music.ctxData == 0 || !IsPhysFSReady()) {
+        return;
+    }
+
+    // Only music that's still loaded is unloaded, so unloading twice is safe.
+    LockPhysFSMutex(physfsMusicMutex);
+    for (int i = 0; i < physfsMusicCount; i++) {
+        if (physfsMusics[i].music.ctxData == music.ctxData) {
+            UnloadMusicStream(physfsMusics[i].music);
+            UnmapFileView(physfsMusics[i].view);
+            physfsMusics[i] = physfsMusics[--physfsMusicCount];
+            break;
+        }
+    }
+    UnlockPhysFSMutex(physfsMusicMutex);
+}
+
+/**
+ * Keeps the buffers of all music loaded from PhysFS topped up, until asked to stop.
+ *
+ * @internal
+ */
+PhysFSThreadResult RunPhysFSMusicThread(void* arg) {
+    (void)arg;
+    while (true) {
+        LockPhysFSMutex(physfsMusicMutex);
+        if (physfsMusicThreadStopping) {
+            UnlockPhysFSMutex(physfsMusicMutex);
+            break;
+        }
+        for (int i = 0; i < physfsMusicCount; i++) {
+            UpdateMusicStream(physfsMusics[i].music);
+        }
+        UnlockPhysFSMutex(physfsMusicMutex);
+
+        SleepPhysFSThread(RAYLIB_PHYSFS_MUSIC_THREAD_INTERVAL);
+    }
+    return 0;
+}
+
+/**
+ * Set whether music loaded from PhysFS is decoded on a background thread.
+ *
+ * While enabled, one thread keeps the buffers of all music loaded with LoadMusicStreamFromPhysFS()
+ * topped up, so decoding no longer happens on the calling thread. Use UpdateMusicStreamFromPhysFS(),
+ * StopMusicStreamFromPhysFS() and SeekMusicStreamFromPhysFS() rather than their raylib counterparts
+ * for that music. Since raylib decodes all music through a shared buffer, any other music should
+ * not be updated while the thread is enabled.
+ *
+ * @param enabled True to start the music thread, false to stop it.
+ *
+ * @return True on success, false on failure.
+ *
+ * @see UpdateMusicStreamFromPhysFS()
+ */
+bool SetPhysFSMusicThread(bool enabled) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot set the music thread before InitPhysFS()");
+        return false;
+    }
+
+    if (enabled == physfsMusicThreadRunning) {
+        return true;
+    }
+
+    if (enabled) {
+        physfsMusicThreadStopping = false;
+        if (!CreatePhysFSThread(physfsMusicThread, RunPhysFSMusicThread, 0)) {
+            TraceLog(LOG_WARNING, "PHYSFS: Failed to start the music thread");
+            return false;
+        }
+        physfsMusicThreadRunning = true;
+        TraceLog(LOG_DEBUG, "PHYSFS: Started the music thread");
+        return true;
+    }
+
+    LockPhysFSMutex(physfsMusicMutex);
+    physfsMusicThreadStopping = true;
+    UnlockPhysFSMutex(physfsMusicMutex);
+    JoinPhysFSThread(physfsMusicThread);
+    physfsMusicThreadRunning = false;
+    TraceLog(LOG_DEBUG, "PHYSFS: Stopped the music thread");
+    return true;
+}
+
+/**
+ * Updates the buffers of music loaded from PhysFS.
+ *
+ * When the music thread is enabled, this only passes along the music's looping setting.
+ *
+ * @param music The music to update.
+ *
+ * @see SetPhysFSMusicThread()
+ * @see UpdateMusicStream()
+ */
+void UpdateMusicStreamFromPhysFS(Music music) {
+    if (!IsPhysFSReady()) {
+        return;
+    }
+
+    if (!physfsMusicThreadRunning) {
+        UpdateMusicStream(music);
+        return;
+    }
+
+    LockPhysFSMutex(physfsMusicMutex);
+    for (int i = 0; i < physfsMusicCount; i++) {
+        if (physfsMusics[i].music.ctxData == music.ctxData) {
+            physfsMusics[i].music.looping = music.looping;
+            break;
+        }
+    }
+    UnlockPhysFSMutex(physfsMusicMutex);
+}
+
+/**
+ * Stops music loaded from PhysFS, without racing the music thread.
+ *
+ * @param music The music to stop.
+ *
+ * @see StopMusicStream()
+ */
+void StopMusicStreamFromPhysFS(Music music) {
+    if (!IsPhysFSReady()) {
+        return;
+    }
+
+    LockPhysFSMutex(physfsMusicMutex);
+    StopMusicStream(music);
+    UnlockPhysFSMutex(physfsMusicMutex);
+}
+
+/**
+ * Seeks music loaded from PhysFS to a position, without racing the music thread.
+ *
+ * @param music The music to seek.
+ * @param position The position to seek to, in seconds.
+ *
+ * @see SeekMusicStream()
+ */
+void SeekMusicStreamFromPhysFS(Music music, float position) {
+    if (!IsPhysFSReady()) {
+        return;
+    }
+
+    LockPhysFSMutex(physfsMusicMutex);
+    SeekMusicStream(music, position);
+    UnlockPhysFSMutex(physfsMusicMutex);
+}
+
+/**
+ * Load font from PhysFS.
+ *
+ * @param fileName The file name to load from the PhysFS mount paths.
+ *
+ * @return The Font object, or an empty Font object on failure.
+ *
+ * @see UnloadFont()
+ */
+Font LoadFontFromPhysFS(const char* fileName, int fontSize, int *fontChars, int charsCount) {
+    double startTime = GetPhysFSCallTime();
+    unsigned int bytesRead;
+    unsigned char* fileData = LoadFileDataFromPhysFS(fileName, &bytesRead);
+    double readTime = GetPhysFSCallTime();
+    if (bytesRead == 0) {
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_FONT, fileName, 0.0, readTime - startTime, 0.0, 0, 0, true);
+        struct Font output;
+        output.baseSize = 0;
+        output.glyphCount = 0;
+        output.glyphPadding = 0;
+        output.glyphs = 0;
+        output.recs = 0;
+        return output;
+    }
+
+    // Load from the memory.
+    const char* extension = GetFileExtension(fileName);
+    Font font = LoadFontFromMemory(extension, fileData, bytesRead, fontSize, fontChars, charsCount);
+    UnloadFileDataFromPhysFS(fileData);
+    RecordPhysFSCall(PHYSFS_STATS_LOAD_FONT, fileName, 0.0, readTime - startTime, GetPhysFSCallTime() - readTime, bytesRead, 0, font.glyphs == 0);
+    return font;
+}
+
+/**
+ * Load a Shader from PhysFS.
+ *
+ * @param vsFileName The name of the vs file to load.
+ * @param fsFileName The name of the fs file to load.
+ *
+ * @return The Shader object.
+ *
+ * @see UnloadShader()
+ */
+Shader LoadShaderFromPhysFS(const char *vsFileName, const char *fsFileName) {
+    double startTime = GetPhysFSCallTime();
+    char* vsFile = LoadFileTextFromPhysFS(vsFileName);
+    char* fsFile = LoadFileTextFromPhysFS(fsFileName);
+    double readTime = GetPhysFSCallTime();
+    const char* statsFileName = vsFileName != 0 ? vsFileName : fsFileName;
+    if (vsFile == 0 && fsFile == 0) {
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_SHADER, statsFileName, 0.0, readTime - startTime, 0.0, 0, 0, true);
+        Shader output = { 0 };
+        return output;
+    }
+    Shader output = LoadShaderFromMemory(vsFile, fsFile);
+    RecordPhysFSCall(PHYSFS_STATS_LOAD_SHADER, statsFileName, 0.0, readTime - startTime, GetPhysFSCallTime() - readTime, TextLength(vsFile) + TextLength(fsFile), 0, output.id == 0);
+    if (vsFile != 0) {
+        UnloadFileTextFromPhysFS(vsFile);
+    }
+    if (fsFile != 0) {
+        UnloadFileTextFromPhysFS(fsFile);
+    }
+    return output;
+}
+
+/**
+ * Finds the slot behind the given resource handle.
+ *
+ * @return The slot index, or -1 if the handle is not valid anymore.
+ *
+ * @internal
+ */
+int GetPhysFSResourceSlot(PhysFSResourcePool* pool, int handle) {
+    int index = handle & 0xFFFFF;
+    unsigned int generation = (unsigned int)handle >> 20;
+    if (handle <= 0 || index >= pool->capacity || pool->keys[index] == 0 || pool->generations[index] != generation) {
+        return -1;
+    }
+    return index;
+}
+
+/**
+ * Shares the resource already loaded with the given key, adding a reference to it.
+ *
+ * @return The handle to the resource, or 0 if nothing is loaded with the key.
+ *
+ * @internal
+ */
+int AcquirePhysFSResource(PhysFSResourcePool* pool, const char* key) {
+    int index = FindInPhysFSHashMap(&pool->map, key, HashPhysFSString(key));
+    if (index == -1) {
+        return 0;
+    }
+    pool->refCounts[index]++;
+    return (int)(pool->generations[index] << 20) | index;
+}
+
+/**
+ * Adds a loaded resource to the pool with a single reference.
+ *
+ * @return The handle to the resource, or 0 on failure.
+ *
+ * @internal
+ */
+int AddPhysFSResource(PhysFSResourcePool* pool, const char* key, const void* resource) {
+    // Grow each of the arrays when there are no free slots left.
+    if (pool->firstFree == -1) {
+        if (pool->capacity >= 0xFFFFF) {
+            TraceLog(LOG_WARNING, "PHYSFS: Too many %s resources acquired", pool->typeName);
+            return 0;
+        }
+        int capacity = pool->capacity == 0 ? 16 : pool->capacity * 2;
+        // Arrays that grew before a failure keep their size, as the capacity is left unchanged.
+        if (!GrowPhysFSArray((void**)&pool->resources, pool->resourceSize * capacity) ||
+                !GrowPhysFSArray((void**)&pool->keys, sizeof(char*) * capacity) ||
+                !GrowPhysFSArray((void**)&pool->hashes, sizeof(unsigned int) * capacity) ||
+                !GrowPhysFSArray((void**)&pool->refCounts, sizeof(int) * capacity) ||
+                !GrowPhysFSArray((void**)&pool->generations, sizeof(unsigned int) * capacity) ||
+                !GrowPhysFSArray((void**)&pool->nextFree, sizeof(int) * capacity)) {
+            TraceLog(LOG_WARNING, "PHYSFS: Failed to grow the %s registry", pool->typeName);
+            return 0;
+        }
+
+        for (int i = capacity - 1; i >= pool->capacity; i--) {
+            pool->keys[i] = 0;
+            pool->refCounts[i] = 0;
+            pool->generations[i] = 1;
+            pool->nextFree[i] = pool->firstFree;
+            pool->firstFree = i;
+        }
+        pool->capacity = capacity;
+    }
+
+    int index = pool->firstFree;
+    char* copy = CopyPhysFSString(key);
+    unsigned int hash = HashPhysFSString(key);
+    if (copy == 0 || !AddToPhysFSHashMap(&pool->map, copy, hash, index)) {
+        MemFree(copy);
+        return 0;
+    }
+    pool->firstFree = pool->nextFree[index];
+
+    unsigned char* destination = pool->resources + (long long)index * pool->resourceSize;
+    for (int i = 0; i < pool->resourceSize; i++) {
+        destination[i] = ((const unsigned char*)resource)[i];
+    }
+    pool->keys[index] = copy;
+    pool->hashes[index] = hash;
+    pool->refCounts[index] = 1;
+    pool->count++;
+    return (int)(pool->generations[index] << 20) | index;
+}
+
+/**
+ * Gets the resource behind the given handle.
+ *
+ * @return A pointer to the resource, or 0 if the handle is not valid.
+ *
+ * @internal
+ */
+void* GetPhysFSResource(PhysFSResourcePool* pool, int handle) {
+    int index = GetPhysFSResourceSlot(pool, handle);
+    if (index == -1) {
+        return 0;
+    }
+    return pool->resources + (long long)index * pool->resourceSize;
+}
+
+/**
+ * Removes a reference to the resource behind the given handle.
+ *
+ * @param resource Receives the resource when the last reference was removed, for the caller to unload.
+ *
+ * @return True when the resource should be unloaded, false otherwise.
+ *
+ * @internal
+ */
+bool ReleasePhysFSResource(PhysFSResourcePool* pool, int handle, void* resource) {
+    int index = GetPhysFSResourceSlot(pool, handle);
+    if (index == -1) {
+        if (handle != 0) {
+            TraceLog(LOG_WARNING, "PHYSFS: Released an invalid %s handle", pool->typeName);
+        }
+        return false;
+    }
+    if (--pool->refCounts[index] > 0) {
+        return false;
+    }
+
+    unsigned char* source = pool->resources + (long long)index * pool->resourceSize;
+    for (int i = 0; i < pool->resourceSize; i++) {
+        ((unsigned char*)resource)[i] = source[i];
+    }
+
+    // Free the slot, invalidating any handles still pointing at it.
+    RemoveFromPhysFSHashMap(&pool->map, pool->keys[index], pool->hashes[index]);
+    MemFree(pool->keys[index]);
+    pool->keys[index] = 0;
+    pool->generations[index] = pool->generations[index] >= 0x7FF ? 1 : pool->generations[index] + 1;
+    pool->nextFree[index] = pool->firstFree;
+    pool->firstFree = index;
+    pool->count--;
+    return true;
+}
+
+/**
+ * Frees the given pool. Resources that are still acquired are left loaded, as their context may be gone.
+ *
+ * @internal
+ */
+void UnloadPhysFSResourcePool(PhysFSResourcePool* pool) {
+    if (pool->count > 0) {
+        TraceLog(LOG_WARNING, "PHYSFS: %i %s resources were not released", pool->count, pool->typeName);
+    }
+    for (int i = 0; i < pool->capacity; i++) {
+        MemFree(pool->keys[i]);
+    }
+    MemFree(pool->resources);
+    MemFree(pool->keys);
+    MemFree(pool->hashes);
+    MemFree(pool->refCounts);
+    MemFree(pool->generations);
+    MemFree(pool->nextFree);
+    UnloadPhysFSHashMap(&pool->map);
+    pool->resources = 0;
+    pool->keys = 0;
+    pool->hashes = 0;
+    pool->refCounts = 0;
+    pool->generations = 0;
+    pool->nextFree = 0;
+    pool->count = 0;
+    pool->capacity = 0;
+    pool->firstFree = -1;
+}
+
+/**
+ * Gets the key for the given path in a resource registry.
+ *
+ * @internal
+ */
+const char* GetPhysFSResourceKey(const char* fileName) {
+    if (fileName == 0) {
+        return "";
+    }
+    while (*fileName == '/') {
+        fileName++;
+    }
+    return fileName;
+}
+
+/**
+ * Gets the key for the given font in the font registry.
+ *
+ * @return The key, to be freed with MemFree(), or 0 on failure.
+ *
+ * @internal
+ */
+char* GetPhysFSFontKey(const char* fileName, int fontSize) {
+    return FormatPhysFSString("%s:%i", GetPhysFSResourceKey(fileName), fontSize);
+}
+
+/**
+ * Gets the key for the given pair of shader files in the shader registry.
+ *
+ * @return The key, to be freed with MemFree(), or 0 on failure.
+ *
+ * @internal
+ */
+char* GetPhysFSShaderKey(const char* vsFileName, const char* fsFileName) {
+    return FormatPhysFSString("%s|%s", GetPhysFSResourceKey(vsFileName), GetPhysFSResourceKey(fsFileName));
+}
+
+/**
+ * Loads a texture from PhysFS, sharing it with everything else that acquires the same path.
+ *
+ * The registry is meant to be used from the main thread, like the textures themselves.
+ *
+ * @param fileName The file to load the texture from.
+ *
+ * @return A handle to the texture, or 0 on failure.
+ *
+ * @see GetPhysFSTexture()
+ * @see ReleasePhysFSTexture()
+ */
+int AcquireTextureFromPhysFS(const char* fileName) {
+    const char* key = GetPhysFSResourceKey(fileName);
+    int handle = AcquirePhysFSResource(&physfsTexturePool, key);
+    if (handle != 0) {
+        return handle;
+    }
+
+    Texture2D texture = LoadTextureFromPhysFS(fileName);
+    if (texture.id == 0) {
+        return 0;
+    }
+    handle = AddPhysFSResource(&physfsTexturePool, key, &texture);
+    if (handle == 0) {
+        UnloadTexture(texture);
+    }
+    return handle;
+}
+
+/**
+ * Gets the texture behind the given handle.
+ *
+ * @param texture The handle from AcquireTextureFromPhysFS().
+ *
+ * @return The texture, or an empty texture if the handle is not valid.
+ */
+Texture2D GetPhysFSTexture(int texture) {
+    Texture2D* output = (Texture2D*)GetPhysFSResource(&physfsTexturePool, texture);
+    if (output == 0) {
+        Texture2D empty = { 0 };
+        return empty;
+    }
+    return *output;
+}
+
+/**
+ * Releases a handle from AcquireTextureFromPhysFS(), unloading the texture when no other handles share it.
+ *
+ * @param texture The handle to release.
+ */
+void ReleasePhysFSTexture(int texture) {
+    Texture2D output;
+    if (ReleasePhysFSResource(&physfsTexturePool, texture, &output)) {
+        UnloadTexture(output);
+    }
+}
+
+/**
+ * Loads wave data from PhysFS, sharing it with everything else that acquires the same path.
+ *
+ * @param fileName The file to load the wave from.
+ *
+ * @return A handle to the wave, or 0 on failure.
+ *
+ * @see GetPhysFSWave()
+ * @see ReleasePhysFSWave()
+ */
+int AcquireWaveFromPhysFS(const char* fileName) {
+    const char* key = GetPhysFSResourceKey(fileName);
+    int handle = AcquirePhysFSResource(&physfsWavePool, key);
+    if (handle != 0) {
+        return handle;
+    }
+
+    Wave wave = LoadWaveFromPhysFS(fileName);
+    if (wave.data == 0) {
+        return 0;
+    }
+    handle = AddPhysFSResource(&physfsWavePool, key, &wave);
+    if (handle == 0) {
+        UnloadWave(wave);
+    }
+    return handle;
+}
+
+/**
+ * Gets the wave behind the given handle.
+ *
+ * @param wave The handle from AcquireWaveFromPhysFS().
+ *
+ * @return The wave, or an empty wave if the handle is not valid.
+ */
+Wave GetPhysFSWave(int wave) {
+    Wave* output = (Wave*)GetPhysFSResource(&physfsWavePool, wave);
+    if (output == 0) {
+        Wave empty = { 0 };
+        return empty;
+    }
+    return *output;
+}
+
+/**
+ * Releases a handle from AcquireWaveFromPhysFS(), unloading the wave when no other handles share it.
+ *
+ * @param wave The handle to release.
+ */
+void ReleasePhysFSWave(int wave) {
+    Wave output;
+    if (ReleasePhysFSResource(&physfsWavePool, wave, &output)) {
+        UnloadWave(output);
+    }
+}
+
+/**
+ * Loads a font from PhysFS with the default characters, sharing it with everything else that
+ * acquires the same path at the same size.
+ *
+ * @param fileName The file to load the font from.
+ * @param fontSize The size of the font.
+ *
+ * @return A handle to the font, or 0 on failure.
+ *
+ * @see GetPhysFSFont()
+ * @see ReleasePhysFSFont()
+ */
+int AcquireFontFromPhysFS(const char* fileName, int fontSize) {
+    char* key = GetPhysFSFontKey(fileName, fontSize);
+    if (key == 0) {
+        return 0;
+    }
+    int handle = AcquirePhysFSResource(&physfsFontPool, key);
+    if (handle != 0) {
+        MemFree(key);
+        return handle;
+    }
+
+    Font font = LoadFontFromPhysFS(fileName, fontSize, 0, 0);
+    if (font.glyphs != 0) {
+        handle = AddPhysFSResource(&physfsFontPool, key, &font);
+        if (handle == 0) {
+            UnloadFont(font);
+        }
+    }
+    MemFree(key);
+    return handle;
+}
+
+/**
+ * Gets the font behind the given handle.
+ *
+ * @param font The handle from AcquireFontFromPhysFS().
+ *
+ * @return The font, or an empty font if the handle is not valid.
+ */
+Font GetPhysFSFont(int font) {
+    Font* output = (Font*)GetPhysFSResource(&physfsFontPool, font);
+    if (output == 0) {
+        Font empty = { 0 };
+        return empty;
+    }
+    return *output;
+}
+
+/**
+ * Releases a handle from AcquireFontFromPhysFS(), unloading the font when no other handles share it.
+ *
+ * @param font The handle to release.
+ */
+void ReleasePhysFSFont(int font) {
+    Font output;
+    if (ReleasePhysFSResource(&physfsFontPool, font, &output)) {
+        UnloadFont(output);
+    }
+}
+
+/**
+ * Loads a shader from PhysFS, sharing it with everything else that acquires the same paths.
+ *
+ * @param vsFileName The name of the vs file to load, or 0 for the default.
+ * @param fsFileName The name of the fs file to load, or 0 for the default.
+ *
+ * @return A handle to the shader, or 0 on failure.
+ *
+ * @see GetPhysFSShader()
+ * @see ReleasePhysFSShader()
+ */
+int AcquireShaderFromPhysFS(const char* vsFileName, const char* fsFileName) {
+    char* key = GetPhysFSShaderKey(vsFileName, fsFileName);
+    if (key == 0) {
+        return 0;
+    }
+    int handle = AcquirePhysFSResource(&physfsShaderPool, key);
+    if (handle != 0) {
+        MemFree(key);
+        return handle;
+    }
+
+    Shader shader = LoadShaderFromPhysFS(vsFileName, fsFileName);
+    if (shader.locs != 0) {
+        handle = AddPhysFSResource(&physfsShaderPool, key, &shader);
+        if (handle == 0) {
+            UnloadShader(shader);
+        }
+    }
+    MemFree(key);
+    return handle;
+}
+
+/**
+ * Gets the shader behind the given handle.
+ *
+ * @param shader The handle from AcquireShaderFromPhysFS().
+ *
+ * @return The shader, or an empty shader if the handle is not valid.
+ */
+Shader GetPhysFSShader(int shader) {
+    Shader* output = (Shader*)GetPhysFSResource(&physfsShaderPool, shader);
+    if (output == 0) {
+        Shader empty = { 0 };
+        return empty;
+    }
+    return *output;
+}
+
+/**
+ * Releases a handle from AcquireShaderFromPhysFS(), unloading the shader when no other handles share it.
+ *
+ * @param shader The handle to release.
+ */
+void ReleasePhysFSShader(int shader) {
+    Shader output;
+    if (ReleasePhysFSResource(&physfsShaderPool, shader, &output)) {
+        UnloadShader(output);
+    }
+}
+
+/**
+ * Decodes a wave on a worker thread.
+ *
+ * @internal
+ */
+void LoadPhysFSJobWave(PhysFSJobData* job) {
+    job->wave = LoadWaveFromPhysFS(job->fileName);
+    job->dataSize = GetPhysFSFileLength(job->fileName);
+}
+
+/**
+ * Loads a text file on a worker thread, into the job's data.
  *
  * @internal
  */
-void TracePhysFSError(const char* detail) {
-    PHYSFS_ErrorCode errorCode = PHYSFS_getLastErrorCode();
-    if (errorCode == PHYSFS_ERR_OK) {
-        TraceLog(LOG_WARNING, TextFormat("PHYSFS: %s", detail));
-    } else {
-        const char* errorMessage = PHYSFS_getErrorByCode(errorCode);
-        TraceLog(LOG_WARNING, TextFormat("PHYSFS: %s (%s)", errorMessage, detail));
-    }
+void LoadPhysFSJobText(PhysFSJobData* job) {
+    job->data = (unsigned char*)LoadFileTextFromPhysFS(job->fileName);
+    job->dataSize = job->data != 0 ? (int)TextLength((char*)job->data) : 0;
 }
 
 /**
- * Loads the given file as a byte array from PhysFS (read).
- *
- * @param fileName The file to load.
- * @param bytesRead An integer to save the bytes that were read.
+ * Queues a job running the given function on the given file.
  *
- * @return The file data as a pointer. Make sure to use UnloadFileData() when finished using the file data.
+ * @return The job handle, or 0 on failure.
  *
- * @see UnloadFileData()
+ * @internal
  */
-unsigned char* LoadFileDataFromPhysFS(const char* fileName, int* bytesRead) {
-    if (!FileExistsInPhysFS(fileName)) {
-        TraceLog(LOG_WARNING, TextFormat("PHYSFS: Tried to load unexisting file '%s'", fileName));
-        *bytesRead = 0;
-        return 0;
-    }
-
-    // Open up the file.
-    PHYSFS_File* handle = PHYSFS_openRead(fileName);
-    if (handle == 0) {
-        TracePhysFSError(fileName);
-        *bytesRead = 0;
+int QueuePhysFSAssetJob(const char* fileName, void (*proc)(PhysFSJobData* job), int priority) {
+    if (fileName == 0) {
         return 0;
     }
-
-    // Check to see how large the file is.
-    int size = PHYSFS_fileLength(handle);
-    if (size == -1) {
-        *bytesRead = 0;
-        PHYSFS_close(handle);
-        TraceLog(LOG_WARNING, TextFormat("PHYSFS: Cannot determine size of file '%s'", fileName));
+    PhysFSJobData* job = (PhysFSJobData*)MemAlloc(sizeof(PhysFSJobData));
+    if (job == 0) {
         return 0;
     }
+    job->fileName = CopyPhysFSString(fileName);
+    job->priority = priority;
+    job->proc = proc;
 
-    // Close safely when it's empty.
-    if (size == 0) {
-        PHYSFS_close(handle);
-        *bytesRead = 0;
-        return 0;
+    int handle = QueuePhysFSJob(job);
+    if (handle == 0) {
+        UnloadPhysFSJob(job);
     }
+    return handle;
+}
 
-    // Read the file, return if it's empty.
-    void* buffer = MemAlloc(size);
-    int read = PHYSFS_readBytes(handle, buffer, size);
-    if (read < 0) {
-        *bytesRead = 0;
-        MemFree(buffer);
-        PHYSFS_close(handle);
-        TracePhysFSError(fileName);
-        return 0;
+/**
+ * Gets the registry pool and key for the given asset.
+ *
+ * @param key Where to save the key, to be freed with MemFree(). Set to 0 on failure.
+ *
+ * @internal
+ */
+PhysFSResourcePool* GetPhysFSAssetPool(PhysFSAssetData* asset, char** key) {
+    switch (asset->type) {
+        case PHYSFS_ASSET_TEXTURE:
+            *key = CopyPhysFSString(GetPhysFSResourceKey(asset->fileName));
+            return &physfsTexturePool;
+        case PHYSFS_ASSET_WAVE:
+            *key = CopyPhysFSString(GetPhysFSResourceKey(asset->fileName));
+            return &physfsWavePool;
+        case PHYSFS_ASSET_FONT:
+            *key = GetPhysFSFontKey(asset->fileName, asset->fontSize);
+            return &physfsFontPool;
+        default:
+            *key = GetPhysFSShaderKey(asset->fileName, asset->fsFileName);
+            return &physfsShaderPool;
     }
-
-    // Close the file handle, and return the bytes read and the buffer.
-    PHYSFS_close(handle);
-    *bytesRead = read;
-    return (unsigned char*) buffer;
 }
 
 /**
- * Initialize the PhysFS virtual file system.
+ * Queues the reads and decodes for the given asset, unless the registry already has it.
  *
- * @return True on success, false on failure.
+ * Textures and waves are decoded on the workers. Fonts and shaders need the GPU, so only their
+ * files are read on the workers.
  *
- * @see ClosePhysFS()
+ * @internal
  */
-bool InitPhysFS() {
-    // Initialize PhysFS.
-    if (PHYSFS_init(0) == 0) {
-        TracePhysFSError("InitPhysFS() failed");
-        return false;
+void QueuePhysFSAssetJobs(PhysFSAssetData* asset, int priority) {
+    char* key;
+    PhysFSResourcePool* pool = GetPhysFSAssetPool(asset, &key);
+    bool loaded = key != 0 && FindInPhysFSHashMap(&pool->map, key, HashPhysFSString(key)) != -1;
+    MemFree(key);
+    if (loaded) {
+        return;
     }
 
-    // Set the default write directory, and report success.
-    SetPhysFSWriteDirectory(GetWorkingDirectory());
-    TraceLog(LOG_DEBUG, "PHYSFS: Initialized PhysFS");
-    return true;
+    switch (asset->type) {
+        case PHYSFS_ASSET_TEXTURE:
+            asset->jobs[0] = QueuePhysFSAssetJob(asset->fileName, LoadPhysFSJobImage, priority);
+            break;
+        case PHYSFS_ASSET_WAVE:
+            asset->jobs[0] = QueuePhysFSAssetJob(asset->fileName, LoadPhysFSJobWave, priority);
+            break;
+        case PHYSFS_ASSET_FONT:
+            asset->jobs[0] = QueuePhysFSAssetJob(asset->fileName, LoadPhysFSJobFileData, priority);
+            break;
+        case PHYSFS_ASSET_SHADER:
+            asset->jobs[0] = QueuePhysFSAssetJob(asset->fileName, LoadPhysFSJobText, priority);
+            asset->jobs[1] = QueuePhysFSAssetJob(asset->fsFileName, LoadPhysFSJobText, priority);
+            break;
+    }
 }
 
 /**
- * Initialize the PhysFS virtual file system with the given mount point.
+ * Finishes loading the given asset into the registry, waiting for its jobs and doing any GPU uploads.
  *
- * @return True on success, false on failure.
+ * @return True if the asset is loaded, false otherwise.
  *
- * @see ClosePhysFS()
+ * @internal
  */
-bool InitPhysFSEx(const char* newDir, const char* mountPoint) {
-    if (InitPhysFS()) {
-        return MountPhysFS(newDir, mountPoint);
+bool FinishPhysFSAsset(PhysFSAssetData* asset) {
+    if (asset->handle != 0 || asset->failed) {
+        return asset->handle != 0;
     }
-    return false;
+
+    // Without any jobs, load it on this thread.
+    if (asset->jobs[0] == 0 && asset->jobs[1] == 0) {
+        switch (asset->type) {
+            case PHYSFS_ASSET_TEXTURE:
+                asset->handle = AcquireTextureFromPhysFS(asset->fileName);
+                break;
+            case PHYSFS_ASSET_WAVE:
+                asset->handle = AcquireWaveFromPhysFS(asset->fileName);
+                break;
+            case PHYSFS_ASSET_FONT:
+                asset->handle = AcquireFontFromPhysFS(asset->fileName, asset->fontSize);
+                break;
+            case PHYSFS_ASSET_SHADER:
+                asset->handle = AcquireShaderFromPhysFS(asset->fileName, asset->fsFileName);
+                break;
+        }
+        asset->size = GetPhysFSFileLength(asset->fileName) + GetPhysFSFileLength(asset->fsFileName);
+        asset->failed = asset->handle == 0;
+        return !asset->failed;
+    }
+
+    // Something else may have loaded it in the meantime.
+    char* key;
+    PhysFSResourcePool* pool = GetPhysFSAssetPool(asset, &key);
+    asset->handle = key != 0 ? AcquirePhysFSResource(pool, key) : 0;
+    if (asset->handle != 0 || key == 0) {
+        MemFree(key);
+        for (int i = 0; i < 2; i++) {
+            if (asset->jobs[i] != 0) {
+                CancelPhysFSJob(asset->jobs[i]);
+                asset->jobs[i] = 0;
+            }
+        }
+        asset->size = GetPhysFSFileLength(asset->fileName) + GetPhysFSFileLength(asset->fsFileName);
+        asset->failed = asset->handle == 0;
+        return !asset->failed;
+    }
+
+    PhysFSJobData* job = asset->jobs[0] != 0 ? TakePhysFSJob(asset->jobs[0]) : 0;
+    PhysFSJobData* fsJob = asset->jobs[1] != 0 ? TakePhysFSJob(asset->jobs[1]) : 0;
+    asset->jobs[0] = 0;
+    asset->jobs[1] = 0;
+
+    switch (asset->type) {
+        case PHYSFS_ASSET_TEXTURE:
+            if (job != 0 && job->image.data != 0) {
+                Texture2D texture = LoadTextureFromImage(job->image);
+                if (texture.id != 0) {
+                    asset->handle = AddPhysFSResource(pool, key, &texture);
+                    if (asset->handle == 0) {
+                        UnloadTexture(texture);
+                    }
+                }
+            }
+            break;
+        case PHYSFS_ASSET_WAVE:
+            if (job != 0 && job->wave.data != 0) {
+                asset->handle = AddPhysFSResource(pool, key, &job->wave);
+                if (asset->handle != 0) {
+                    job->wave.data = 0;
+                }
+            }
+            break;
+        case PHYSFS_ASSET_FONT:
+            if (job != 0 && job->data != 0) {
+                Font font = LoadFontFromMemory(GetFileExtension(asset->fileName), job->data, job->dataSize, asset->fontSize, 0, 0);
+                if (font.glyphs != 0) {
+                    asset->handle = AddPhysFSResource(pool, key, &font);
+                    if (asset->handle == 0) {
+                        UnloadFont(font);
+                    }
+                }
+            }
+            break;
+        case PHYSFS_ASSET_SHADER: {
+            char* vsText = job != 0 ? (char*)job->data : 0;
+            char* fsText = fsJob != 0 ? (char*)fsJob->data : 0;
+            if (vsText != 0 || fsText != 0) {
+                Shader shader = LoadShaderFromMemory(vsText, fsText);
+                if (shader.locs != 0) {
+                    asset->handle = AddPhysFSResource(pool, key, &shader);
+                    if (asset->handle == 0) {
+                        UnloadShader(shader);
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    if (job != 0) {
+        asset->size += job->dataSize;
+        UnloadPhysFSJob(job);
+    }
+    if (fsJob != 0) {
+        asset->size += fsJob->dataSize;
+        UnloadPhysFSJob(fsJob);
+    }
+    MemFree(key);
+    asset->failed = asset->handle == 0;
+    return !asset->failed;
 }
 
 /**
- * Check if PhysFS has been initialized successfully.
+ * Checks whether the given asset can be finished without waiting on the workers.
  *
- * @return True if PhysFS is initialized, false otherwise.
- *
- * @see InitPhysFS()
+ * @internal
  */
-bool IsPhysFSReady() {
-    return PHYSFS_isInit() != 0;
+bool IsPhysFSAssetReady(PhysFSAssetData* asset) {
+    for (int i = 0; i < 2; i++) {
+        if (asset->jobs[i] != 0 && !IsPhysFSJobDone(asset->jobs[i])) {
+            return false;
+        }
+    }
+    return true;
 }
 
 /**
- * Mounts the given directory, at the given mount point.
- *
- * @param newDir Directory or archive to add to the path, in platform-dependent notation.
- * @param mountPoint Location in the interpolated tree that this archive will be "mounted", in platform-independent notation. NULL or "" is equivalent to "/".
+ * Cancels any jobs for the given asset, releases it from the registry, and frees its paths.
  *
- * @return True on success, false on failure.
- *
- * @see UnmountPhysFS()
+ * @internal
  */
-bool MountPhysFS(const char* newDir, const char* mountPoint) {
-    if (PHYSFS_mount(newDir, mountPoint, 1) == 0) {
-        TracePhysFSError(mountPoint);
-        return false;
+void UnloadPhysFSAsset(PhysFSAssetData* asset) {
+    for (int i = 0; i < 2; i++) {
+        if (asset->jobs[i] != 0) {
+            CancelPhysFSJob(asset->jobs[i]);
+        }
     }
-
-    TraceLog(LOG_DEBUG, "PHYSFS: Mounted '%s' at '%s'", newDir, mountPoint);
-    return true;
+    switch (asset->type) {
+        case PHYSFS_ASSET_TEXTURE:
+            ReleasePhysFSTexture(asset->handle);
+            break;
+        case PHYSFS_ASSET_WAVE:
+            ReleasePhysFSWave(asset->handle);
+            break;
+        case PHYSFS_ASSET_FONT:
+            ReleasePhysFSFont(asset->handle);
+            break;
+        case PHYSFS_ASSET_SHADER:
+            ReleasePhysFSShader(asset->handle);
+            break;
+    }
+    MemFree(asset->fileName);
+    MemFree(asset->fsFileName);
 }
 
 /**
- * Mounts the given file data as a mount point in PhysFS.
+ * Parses an asset from a manifest line.
  *
- * @param fileData The archive data as a file buffer.
- * @param dataSize The size of the file buffer.
- * @param newDir A filename that can represent the file data. Has to be unique. For example: data.zip
- * @param mountPoint The location in the tree that the archive will be mounted.
+ * @param type The type of the asset, the first token on the line.
+ * @param line The rest of the line.
+ * @param asset Receives the asset.
  *
- * @return True on success, false on failure.
+ * @return True on success, false if the line is not valid.
  *
- * @see MountPhysFS()
+ * @internal
  */
-bool MountPhysFSFromMemory(const unsigned char *fileData, int dataSize, const char* newDir, const char* mountPoint) {
-    if (dataSize <= 0) {
-        TraceLog(LOG_WARNING, "PHYSFS: Cannot mount a data size of 0");
+bool ParsePhysFSAsset(const char* type, char* line, PhysFSAssetData* asset) {
+    char* fileName = GetPhysFSManifestToken(&line);
+    char* argument = GetPhysFSManifestToken(&line);
+    if (fileName == 0) {
         return false;
     }
 
-    if (PHYSFS_mountMemory(fileData, dataSize, 0, newDir, mountPoint, 1) == 0) {
-        TracePhysFSError(TextFormat("Failed to mount '%s' at '%s'", newDir, mountPoint));
+    if (TextIsEqual(type, "texture")) {
+        asset->type = PHYSFS_ASSET_TEXTURE;
+    } else if (TextIsEqual(type, "wave")) {
+        asset->type = PHYSFS_ASSET_WAVE;
+    } else if (TextIsEqual(type, "font")) {
+        asset->type = PHYSFS_ASSET_FONT;
+        asset->fontSize = argument != 0 ? TextToInteger(argument) : 0;
+        if (asset->fontSize <= 0) {
+            return false;
+        }
+    } else if (TextIsEqual(type, "shader")) {
+        asset->type = PHYSFS_ASSET_SHADER;
+        if (argument == 0) {
+            return false;
+        }
+    } else {
         return false;
     }
 
-    TraceLog(LOG_DEBUG, "PHYSFS: Mounted memory '%s' at '%s'", newDir, mountPoint);
+    if (asset->type == PHYSFS_ASSET_SHADER) {
+        asset->fileName = TextIsEqual(fileName, "-") ? 0 : CopyPhysFSString(fileName);
+        asset->fsFileName = TextIsEqual(argument, "-") ? 0 : CopyPhysFSString(argument);
+    } else {
+        asset->fileName = CopyPhysFSString(fileName);
+    }
     return true;
 }
 
 /**
- * Unmounts the given directory or archive.
+ * Parses the given group of assets out of a manifest file.
  *
- * @param oldDir The directory that was supplied to MountPhysFS's newDir.
+ * A manifest is a text file with groups in brackets, each followed by one asset per line. Blank
+ * lines, and lines starting with #, are skipped. Paths can't contain spaces.
  *
- * @return True on success, false on failure.
+ *     [level1]
+ *     texture assets/level1/tiles.png
+ *     wave assets/level1/jump.wav
+ *     font assets/fonts/title.ttf 32
+ *     shader assets/shaders/water.vs assets/shaders/water.fs
  *
- * @see MountPhysFS()
+ * Shaders take - in place of a file, to use the default.
+ *
+ * @return The group, or one without a name on failure.
+ *
+ * @internal
  */
-bool UnmountPhysFS(const char* oldDir) {
-    if (PHYSFS_unmount(oldDir) == 0) {
-        TraceLog(LOG_WARNING, "PHYSFS: Failed to unmount directory '%s'", oldDir);
-        return false;
+PhysFSAssetGroupData LoadPhysFSAssetGroupManifest(const char* manifest, const char* group) {
+    PhysFSAssetGroupData output = { 0 };
+    char* text = LoadFileTextFromPhysFS(manifest);
+    if (text == 0) {
+        TraceLog(LOG_WARNING, "PHYSFS: Failed to load asset manifest '%s'", manifest);
+        return output;
     }
 
-    TraceLog(LOG_DEBUG, "PHYSFS: Unmounted '%s'", oldDir);
-    return true;
+    bool found = false;
+    bool inGroup = false;
+    int lineNumber = 0;
+    char* next = text;
+    while (next != 0) {
+        char* line = next;
+        next = 0;
+        for (char* c = line; *c != '\0'; c++) {
+            if (*c == '\n') {
+                *c = '\0';
+                next = c + 1;
+                break;
+            }
+        }
+        lineNumber++;
+
+        int length = (int)TextLength(line);
+        if (length > 0 && line[length - 1] == '\r') {
+            line[--length] = '\0';
+        }
+
+        char* type = GetPhysFSManifestToken(&line);
+        if (type == 0 || type[0] == '#') {
+            continue;
+        }
+
+        // Group headers.
+        if (type[0] == '[') {
+            int typeLength = (int)TextLength(type);
+            if (typeLength > 2 && type[typeLength - 1] == ']') {
+                type[typeLength - 1] = '\0';
+                inGroup = TextIsEqual(type + 1, group);
+                found = found || inGroup;
+            } else {
+                TraceLog(LOG_WARNING, "PHYSFS: Invalid group on line %i of '%s'", lineNumber, manifest);
+                inGroup = false;
+            }
+            continue;
+        }
+        if (!inGroup) {
+            continue;
+        }
+
+        PhysFSAssetData asset = { 0 };
+        if (!ParsePhysFSAsset(type, line, &asset)) {
+            TraceLog(LOG_WARNING, "PHYSFS: Invalid asset on line %i of '%s'", lineNumber, manifest);
+            continue;
+        }
+
+        PhysFSAssetData* assets = (PhysFSAssetData*)MemRealloc(output.assets, sizeof(PhysFSAssetData) * (output.assetCount + 1));
+        if (assets == 0) {
+            UnloadPhysFSAsset(&asset);
+            continue;
+        }
+        output.assets = assets;
+        output.assets[output.assetCount++] = asset;
+    }
+    UnloadFileTextFromPhysFS(text);
+
+    if (!found) {
+        TraceLog(LOG_WARNING, "PHYSFS: Asset group '%s' not found in '%s'", group, manifest);
+        return output;
+    }
+    output.name = CopyPhysFSString(group);
+    return output;
 }
 
 /**
- * Determine if a file exists in the search path.
- *
- * @param fileName Filename in platform-independent notation.
+ * Finds the asset group with the given name.
  *
- * @return True if the file exists, false otherwise.
+ * @return The group, or 0 if it is not loaded.
  *
- * @see DirectoryExistsInPhysFS()
+ * @internal
  */
-bool FileExistsInPhysFS(const char* fileName) {
-    PHYSFS_Stat stat;
-    if (PHYSFS_stat(fileName, &stat) == 0) {
-        return false;
+PhysFSAssetGroupData* GetPhysFSAssetGroup(const char* group) {
+    for (int i = 0; i < physfsAssetGroupCount; i++) {
+        if (TextIsEqual(physfsAssetGroups[i].name, group)) {
+            return &physfsAssetGroups[i];
+        }
     }
-    return stat.filetype == PHYSFS_FILETYPE_REGULAR;
+    return 0;
 }
 
 /**
- * Determine if a directory exists in the search path.
+ * Adds the given group to the loaded asset groups.
  *
- * @param dirPath Directory in platform-independent notation.
- *
- * @return True if the directory exists, false otherwise.
+ * @return The added group, or 0 on failure.
  *
- * @see FileExistsInPhysFS()
+ * @internal
  */
-bool DirectoryExistsInPhysFS(const char* dirPath) {
-    PHYSFS_Stat stat;
-    if (PHYSFS_stat(dirPath, &stat) == 0) {
-        return false;
+PhysFSAssetGroupData* AddPhysFSAssetGroup(PhysFSAssetGroupData data) {
+    PhysFSAssetGroupData* groups = (PhysFSAssetGroupData*)MemRealloc(physfsAssetGroups, sizeof(PhysFSAssetGroupData) * (physfsAssetGroupCount + 1));
+    if (groups == 0) {
+        return 0;
     }
-    return stat.filetype == PHYSFS_FILETYPE_DIRECTORY;
+    physfsAssetGroups = groups;
+    physfsAssetGroups[physfsAssetGroupCount] = data;
+    return &physfsAssetGroups[physfsAssetGroupCount++];
 }
 
 /**
- * Load an image from PhysFS.
+ * Parses the given group from the manifest, and queues the reads and decodes for all of its assets.
  *
- * @param fileName The filename to load from the search paths.
+ * @return The group, or 0 on failure.
  *
- * @return The loaded image on success. An empty Image otherwise.
+ * @internal
  */
-Image LoadImageFromPhysFS(const char* fileName) {
-    int bytesRead;
-    unsigned char* fileData = LoadFileDataFromPhysFS(fileName, &bytesRead);
-    if (bytesRead == 0) {
-        struct Image output;
-        output.data = 0;
-        output.width = 0;
-        output.height = 0;
-        return output;
+PhysFSAssetGroupData* QueuePhysFSAssetGroup(const char* manifest, const char* group, int priority) {
+    PhysFSAssetGroupData* existing = GetPhysFSAssetGroup(group);
+    if (existing != 0) {
+        return existing;
     }
 
-    // Load from the memory.
-    const char* extension = GetFileExtension(fileName);
-    Image image = LoadImageFromMemory(extension, fileData, bytesRead);
-    UnloadFileData(fileData);
-    return image;
+    PhysFSAssetGroupData data = LoadPhysFSAssetGroupManifest(manifest, group);
+    if (data.name == 0) {
+        return 0;
+    }
+    PhysFSAssetGroupData* output = AddPhysFSAssetGroup(data);
+    if (output == 0) {
+        for (int i = 0; i < data.assetCount; i++) {
+            UnloadPhysFSAsset(&data.assets[i]);
+        }
+        MemFree(data.assets);
+        MemFree(data.name);
+        return 0;
+    }
+
+    for (int i = 0; i < output->assetCount; i++) {
+        QueuePhysFSAssetJobs(&output->assets[i], priority);
+    }
+    return output;
 }
 
 /**
- * Load a texture from PhysFS.
+ * Starts reading and decoding a group of assets on the worker threads, without waiting for them.
  *
- * @param fileName The filename to load from the search paths.
+ * This lets the next level's assets load in the background while the current one plays. Call
+ * LoadPhysFSAssetGroup() with the same group to finish loading it.
  *
- * @return The loaded texture on success. An empty texture otherwise.
+ * @param manifest The path to the manifest describing the group.
+ * @param group The name of the group to preload.
  *
- * @see LoadImageFromPhysFS()
+ * @return True if the group was found, false otherwise.
+ *
+ * @see LoadPhysFSAssetGroup()
  */
-Texture2D LoadTextureFromPhysFS(const char* fileName) {
-    Image image = LoadImageFromPhysFS(fileName);
-    if (image.data == 0) {
-        Texture2D output = { 0 };
-        output.id = 0;
-        output.format = 0;
-        output.width = 0;
-        output.height = 0;
-        return output;
+bool PreloadPhysFSAssetGroup(const char* manifest, const char* group) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot preload asset group '%s' before InitPhysFS()", group);
+        return false;
     }
-    Texture2D texture = LoadTextureFromImage(image);
-    UnloadImage(image);
-    return texture;
+
+    // Let regular asynchronous loads go first.
+    return QueuePhysFSAssetGroup(manifest, group, -1) != 0;
 }
 
 /**
- * Load text data from file (read). Make sure to call UnloadFileText() when done.
+ * Loads all assets of a group from a manifest, and adds them to the registry.
  *
- * @param fileName The file name to load from the PhysFS mount paths.
+ * Textures and waves are read and decoded on the worker threads in parallel, while fonts and
+ * shaders have their files read there. The GPU uploads happen on the calling thread. Get the
+ * loaded assets with AcquireTextureFromPhysFS() and friends, which share them with the group.
+ * Groups that were already preloaded or queued are finished without reading the manifest again,
+ * and their assets that are still queued go ahead of other jobs.
  *
- * @return A '\0' terminated string.
+ * @param manifest The path to the manifest describing the group.
+ * @param group The name of the group to load.
  *
- * @see UnloadFileText()
+ * @return True if all assets in the group loaded, false otherwise.
+ *
+ * @see PreloadPhysFSAssetGroup()
+ * @see UnloadPhysFSAssetGroup()
  */
-char* LoadFileTextFromPhysFS(const char *fileName) {
-    int bytesRead;
-    unsigned char* data = LoadFileDataFromPhysFS(fileName, &bytesRead);
-    if (bytesRead == 0) {
-        return 0;
+bool LoadPhysFSAssetGroup(const char* manifest, const char* group) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot load asset group '%s' before InitPhysFS()", group);
+        return false;
     }
 
-    // Copy the data, and append a null terminator.
-    char* text = (char*)MemAlloc(bytesRead + 1);
-    for (int i = 0; i < bytesRead; i++) {
-        text[i] = (char)data[i];
+    PhysFSAssetGroupData* data = QueuePhysFSAssetGroup(manifest, group, 0x7FFFFFFF);
+    if (data == 0) {
+        return false;
     }
-    text[bytesRead] = '\0';
 
-    // Free the original data, and return the string.
-    MemFree(data);
+    // Preloaded assets that are still queued are needed now, so they go ahead of everything else.
+    for (int i = 0; i < data->assetCount; i++) {
+        for (int j = 0; j < 2; j++) {
+            if (data->assets[i].jobs[j] != 0) {
+                RaisePhysFSJobPriority(data->assets[i].jobs[j], 0x7FFFFFFF);
+            }
+        }
+    }
 
-    return text;
+    // Finish in order, as the workers take the assets in order.
+    bool output = true;
+    for (int i = 0; i < data->assetCount; i++) {
+        if (!FinishPhysFSAsset(&data->assets[i])) {
+            const char* fileName = data->assets[i].fileName != 0 ? data->assets[i].fileName : "-";
+            TraceLog(LOG_WARNING, "PHYSFS: Failed to load '%s' from asset group '%s'", fileName, group);
+            output = false;
+        }
+    }
+    return output;
 }
 
 /**
- * Load wave data from PhysFS.
+ * Releases all assets in a group loaded with LoadPhysFSAssetGroup() or PreloadPhysFSAssetGroup().
  *
- * @param fileName The file name to load from the PhysFS mount paths.
- *
- * @return The Wave object, or an empty Wave object on failure.
+ * Assets are unloaded unless they were acquired elsewhere too.
  *
- * @see UnloadWave()
- */
-Wave LoadWaveFromPhysFS(const char* fileName) {
-    unsigned int bytesRead;
-    unsigned char* fileData = LoadFileDataFromPhysFS(fileName, &bytesRead);
-    if (bytesRead == 0) {
-        struct Wave output;
-        output.data = 0;
-        return output;
+ * @param group The name of the group to unload.
+ */
+void UnloadPhysFSAssetGroup(const char* group) {
+    PhysFSAssetGroupData* data = GetPhysFSAssetGroup(group);
+    if (data == 0) {
+        return;
     }
 
-    // Load from the memory.
-    const char* extension = GetFileExtension(fileName);
-    Wave wave = LoadWaveFromMemory(extension, fileData, bytesRead);
-    UnloadFileData(fileData);
-    return wave;
+    for (int i = 0; i < data->assetCount; i++) {
+        UnloadPhysFSAsset(&data->assets[i]);
+    }
+    MemFree(data->assets);
+    MemFree(data->name);
+    *data = physfsAssetGroups[--physfsAssetGroupCount];
+    if (physfsAssetGroupCount == 0) {
+        MemFree(physfsAssetGroups);
+        physfsAssetGroups = 0;
+    }
 }
 
 /**
- * Load module music from PhysFS.
+ * Queues a single asset into a group, to be loaded by UpdatePhysFSLoader() or LoadPhysFSAssetGroup().
  *
- * @param fileName The file name to load from the PhysFS mount paths.
+ * The asset is described like a line in an asset group manifest. Its file is read and decoded on
+ * the worker threads right away.
  *
- * @return The Music object, or an empty Music object on failure.
+ * @code
+ * QueuePhysFSAsset("level1", "texture assets/level1/tiles.png");
+ * QueuePhysFSAsset("level1", "font assets/fonts/title.ttf 32");
+ * @endcode
  *
- * @see UnloadMusic()
+ * @param group The name of the group to add the asset to, which is created if needed.
+ * @param asset The type and path of the asset.
+ *
+ * @return True if the asset was queued, false otherwise.
+ *
+ * @see UpdatePhysFSLoader()
+ * @see UnloadPhysFSAssetGroup()
  */
-Music LoadMusicStreamFromPhysFS(const char* fileName) {
-    unsigned int bytesRead;
-    unsigned char* fileData = LoadFileDataFromPhysFS(fileName, &bytesRead);
-    if (bytesRead == 0) {
-        struct Music output;
-        output.ctxData = 0;
-        output.stream.buffer = 0;
-        return output;
+bool QueuePhysFSAsset(const char* group, const char* asset) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot queue '%s' before InitPhysFS()", asset);
+        return false;
     }
 
-    // Load from the memory.
-    const char* extension = GetFileExtension(fileName);
-    Music music = LoadMusicStreamFromMemory(extension, fileData, bytesRead);
+    PhysFSAssetData data = { 0 };
+    char* line = CopyPhysFSString(asset);
+    char* rest = line;
+    char* type = line != 0 ? GetPhysFSManifestToken(&rest) : 0;
+    bool valid = type != 0 && ParsePhysFSAsset(type, rest, &data);
+    MemFree(line);
+    if (!valid) {
+        TraceLog(LOG_WARNING, "PHYSFS: Invalid asset '%s'", asset);
+        UnloadPhysFSAsset(&data);
+        return false;
+    }
 
-    // Unload the file data if the music failed to load.
-    if (music.ctxData == (void*)0) {
-        UnloadFileData(fileData);
+    PhysFSAssetGroupData* groupData = GetPhysFSAssetGroup(group);
+    if (groupData == 0) {
+        PhysFSAssetGroupData newGroup = { 0 };
+        newGroup.name = CopyPhysFSString(group);
+        groupData = newGroup.name != 0 ? AddPhysFSAssetGroup(newGroup) : 0;
+        if (groupData == 0) {
+            MemFree(newGroup.name);
+            UnloadPhysFSAsset(&data);
+            return false;
+        }
     }
 
-    return music;
+    PhysFSAssetData* assets = (PhysFSAssetData*)MemRealloc(groupData->assets, sizeof(PhysFSAssetData) * (groupData->assetCount + 1));
+    if (assets == 0) {
+        UnloadPhysFSAsset(&data);
+        return false;
+    }
+    groupData->assets = assets;
+    QueuePhysFSAssetJobs(&data, 0);
+    groupData->assets[groupData->assetCount++] = data;
+    return true;
 }
 
 /**
- * Load font from PhysFS.
+ * Finishes loading the assets in all asset groups whose files the workers have read and decoded,
+ * stopping once the time budget is spent.
  *
- * @param fileName The file name to load from the PhysFS mount paths.
+ * Call it every frame while a loading screen is up, so that GPU uploads are spread across frames
+ * rather than freezing the game. At least one asset is finished per call, if any are ready.
  *
- * @return The Font object, or an empty Font object on failure.
+ * @code
+ * PreloadPhysFSAssetGroup("manifest.txt", "level1");
+ * while (!UpdatePhysFSLoader(8.0f)) {
+ *     PhysFSLoaderProgress progress = GetPhysFSLoaderProgress();
+ *     DrawLoadingScreen((float)progress.loadedCount / progress.assetCount);
+ * }
+ * @endcode
  *
- * @see UnloadFont()
+ * @param maxMilliseconds The time to spend finishing assets.
+ *
+ * @return True when no assets are left loading, false otherwise.
+ *
+ * @see GetPhysFSLoaderProgress()
+ * @see QueuePhysFSAsset()
+ * @see PreloadPhysFSAssetGroup()
  */
-Font LoadFontFromPhysFS(const char* fileName, int fontSize, int *fontChars, int charsCount) {
-    unsigned int bytesRead;
-    unsigned char* fileData = LoadFileDataFromPhysFS(fileName, &bytesRead);
-    if (bytesRead == 0) {
-        struct Font output;
-        output.baseSize = 0;
-        output.glyphCount = 0;
-        output.glyphPadding = 0;
-        output.glyphs = 0;
-        output.recs = 0;
-        return output;
+bool UpdatePhysFSLoader(float maxMilliseconds) {
+    double start = GetPhysFSTime();
+    bool finishedAny = false;
+    bool done = true;
+    for (int i = 0; i < physfsAssetGroupCount; i++) {
+        PhysFSAssetGroupData* group = &physfsAssetGroups[i];
+        for (int j = 0; j < group->assetCount; j++) {
+            PhysFSAssetData* asset = &group->assets[j];
+            if (asset->handle != 0 || asset->failed) {
+                continue;
+            }
+            if (!IsPhysFSAssetReady(asset) || (finishedAny && GetPhysFSTime() - start >= maxMilliseconds)) {
+                done = false;
+                continue;
+            }
+            if (!FinishPhysFSAsset(asset)) {
+                TraceLog(LOG_WARNING, "PHYSFS: Failed to load '%s' from asset group '%s'", asset->fileName != 0 ? asset->fileName : "-", group->name);
+            }
+            finishedAny = true;
+        }
     }
-
-    // Load from the memory.
-    const char* extension = GetFileExtension(fileName);
-    Font font = LoadFontFromMemory(extension, fileData, bytesRead, fontSize, fontChars, charsCount);
-    UnloadFileData(fileData);
-    return font;
+    return done;
 }
 
 /**
- * Load a Shader from PhysFS.
+ * Gets how many assets in all asset groups have finished loading.
  *
- * @param vsFileName The name of the vs file to load.
- * @param fsFileName The name of the fs file to load.
- *
- * @return The Shader object.
+ * @return The loader progress.
  *
- * @see UnloadShader()
+ * @see UpdatePhysFSLoader()
  */
-Shader LoadShaderFromPhysFS(const char *vsFileName, const char *fsFileName) {
-    char* vsFile = LoadFileTextFromPhysFS(vsFileName);
-    char* fsFile = LoadFileTextFromPhysFS(fsFileName);
-    if (vsFile == 0 && fsFile == 0) {
-        Shader output = { 0 };
-        return output;
-    }
-    Shader output = LoadShaderFromMemory(vsFile, fsFile);
-    if (vsFile != 0) {
-        UnloadFileText(vsFile);
-    }
-    if (fsFile != 0) {
-        UnloadFileText(fsFile);
+PhysFSLoaderProgress GetPhysFSLoaderProgress() {
+    PhysFSLoaderProgress output = { 0 };
+    for (int i = 0; i < physfsAssetGroupCount; i++) {
+        for (int j = 0; j < physfsAssetGroups[i].assetCount; j++) {
+            PhysFSAssetData* asset = &physfsAssetGroups[i].assets[j];
+            output.assetCount++;
+            if (asset->handle != 0) {
+                output.loadedCount++;
+                output.bytesLoaded += asset->size;
+            } else if (asset->failed) {
+                output.failedCount++;
+            }
+        }
     }
     return output;
 }
@@ -534,20 +8597,28 @@ bool SaveFileDataToPhysFS(const char* fileName, void* data, int bytesToWrite) {
     }
 
     // Open the file.
+    double startTime = GetPhysFSCallTime();
     PHYSFS_File* handle = PHYSFS_openWrite(fileName);
     if (handle == 0) {
         TracePhysFSError(fileName);
+        RecordPhysFSCall(PHYSFS_STATS_SAVE_FILE_DATA, fileName, GetPhysFSCallTime() - startTime, 0.0, 0.0, 0, 0, true);
         return false;
     }
+    double openTime = GetPhysFSCallTime();
 
     // Write the data to the file handle.
     if (PHYSFS_writeBytes(handle, data, bytesToWrite) < 0) {
         PHYSFS_close(handle);
         TracePhysFSError(fileName);
+        RecordPhysFSCall(PHYSFS_STATS_SAVE_FILE_DATA, fileName, openTime - startTime, GetPhysFSCallTime() - openTime, 0.0, 0, 0, true);
         return false;
     }
 
     PHYSFS_close(handle);
+    RecordPhysFSCall(PHYSFS_STATS_SAVE_FILE_DATA, fileName, openTime - startTime, GetPhysFSCallTime() - openTime, 0.0, 0, bytesToWrite, false);
+    InvalidatePhysFSCache(fileName);
+    UpdatePhysFSIndexPath(fileName);
+    InvalidatePhysFSPathIds();
     return true;
 }
 
@@ -566,14 +8637,18 @@ bool SaveFileTextToPhysFS(const char* fileName, char* text) {
 /**
  * Gets a list of files in the given directory in PhysFS.
  *
- * Make sure to clear the loaded list by using UnloadDirectoryFiles().
+ * Make sure to clear the loaded list by using UnloadDirectoryFilesFromPhysFS().
  *
- * @see UnloadDirectoryFiles()
+ * @see UnloadDirectoryFilesFromPhysFS()
  */
 FilePathList LoadDirectoryFilesFromPhysFS(const char* dirPath) {
-    // Make sure the directory exists.
+    double startTime = GetPhysFSCallTime();
+
+    // Make sure the directory exists, with everything that's lazily mounted within it.
+    OpenPhysFSLazyMounts(dirPath, true);
     if (!DirectoryExistsInPhysFS(dirPath)) {
         TraceLog(LOG_WARNING, "PHYSFS: Can't get files from non-existant directory (%s)", dirPath);
+        RecordPhysFSCall(PHYSFS_STATS_LOAD_DIRECTORY_FILES, dirPath, GetPhysFSCallTime() - startTime, 0.0, 0.0, 0, 0, true);
         FilePathList out;
         out.capacity = 0;
         out.count = 0;
@@ -589,15 +8664,237 @@ FilePathList LoadDirectoryFilesFromPhysFS(const char* dirPath) {
 
     // Find out how many files there were.
     output.count = 0;
+    long long size = sizeof(char*);
     for (char** i = output.paths; *i != 0; i++) {
         output.count++;
+        size += sizeof(char*) + TextLength(*i) + 1;
     }
     output.capacity = output.count;
+    TrackPhysFSAllocation(output.paths, size, "LoadDirectoryFilesFromPhysFS", dirPath);
+    RecordPhysFSCall(PHYSFS_STATS_LOAD_DIRECTORY_FILES, dirPath, 0.0, GetPhysFSCallTime() - startTime, 0.0, 0, 0, false);
 
     // Output the count and the list.
     return output;
 }
 
+/**
+ * Checks whether a path matches a glob pattern, where '*' matches any run of characters and '?' any one character.
+ *
+ * @internal
+ */
+bool IsPhysFSGlobMatch(const char* pattern, int patternLength, const char* text) {
+    int position = 0;
+    int star = -1;
+    const char* starText = 0;
+    while (*text != '\0') {
+        if (position < patternLength && pattern[position] == '*') {
+            star = position++;
+            starText = text;
+        } else if (position < patternLength && (pattern[position] == '?' || pattern[position] == *text)) {
+            position++;
+            text++;
+        } else if (star != -1) {
+            // Let the last '*' take one more character.
+            position = star + 1;
+            text = ++starText;
+        } else {
+            return false;
+        }
+    }
+    while (position < patternLength && pattern[position] == '*') {
+        position++;
+    }
+    return position == patternLength;
+}
+
+/**
+ * Checks whether a file or directory passes the filter of LoadDirectoryFilesFromPhysFSEx().
+ *
+ * @param relativePath The path within the directory being listed.
+ *
+ * @internal
+ */
+bool IsPhysFSFilterMatch(const char* filter, const char* relativePath, bool isDirectory) {
+    if (filter == 0 || filter[0] == '\0') {
+        return true;
+    }
+
+    int pathLength = (int)TextLength(relativePath);
+    const char* item = filter;
+    while (*item != '\0') {
+        int length = 0;
+        while (item[length] != '\0' && item[length] != ';') {
+            length++;
+        }
+
+        bool glob = false;
+        for (int i = 0; i < length; i++) {
+            glob = glob || item[i] == '*' || item[i] == '?';
+        }
+        if (length == 3 && strncmp(item, "DIR", 3) == 0) {
+            if (isDirectory) {
+                return true;
+            }
+        } else if (isDirectory || length == 0) {
+            // Extensions and patterns only match files.
+        } else if (glob) {
+            if (IsPhysFSGlobMatch(item, length, relativePath)) {
+                return true;
+            }
+        } else if (length <= pathLength) {
+            // Extensions match regardless of case, like IsFileExtension().
+            bool match = true;
+            for (int i = 0; i < length && match; i++) {
+                char a = relativePath[pathLength - length + i];
+                char b = item[i];
+                match = (a >= 'A' && a <= 'Z' ? a + 32 : a) == (b >= 'A' && b <= 'Z' ? b + 32 : b);
+            }
+            if (match) {
+                return true;
+            }
+        }
+        item += item[length] == ';' ? length + 1 : length;
+    }
+    return false;
+}
+
+/**
+ * Adds a file or directory to a list from LoadDirectoryFilesFromPhysFSEx().
+ *
+ * @return True on success, false on failure.
+ *
+ * @internal
+ */
+bool AddPhysFSFileInfo(PhysFSFileInfoList* list, const char* path, const PHYSFS_Stat* stat) {
+    if (list->count == list->capacity) {
+        unsigned int capacity = list->capacity == 0 ? 64 : list->capacity * 2;
+        if (!GrowPhysFSArray((void**)&list->files, (int)(sizeof(PhysFSFileInfo) * capacity))) {
+            return false;
+        }
+        list->capacity = capacity;
+    }
+    PhysFSFileInfo* file = &list->files[list->count];
+    file->path = CopyPhysFSString(path);
+    if (file->path == 0) {
+        return false;
+    }
+    file->isDirectory = stat->filetype == PHYSFS_FILETYPE_DIRECTORY;
+    file->size = file->isDirectory || stat->filesize < 0 ? 0 : (long long)stat->filesize;
+    file->modTime = (long)stat->modtime;
+    list->count++;
+    return true;
+}
+
+/**
+ * Adds the files within a directory to a list from LoadDirectoryFilesFromPhysFSEx(), through PhysFS.
+ *
+ * @param prefixLength The length of the directory being listed, and the slash following it.
+ *
+ * @return True on success, false on failure.
+ *
+ * @internal
+ */
+bool AddPhysFSDirectoryFileInfo(PhysFSFileInfoList* list, const char* dirPath, int prefixLength, const char* filter, bool recursive) {
+    char** names = PHYSFS_enumerateFiles(dirPath);
+    if (names == 0) {
+        return false;
+    }
+    bool output = true;
+    for (char** name = names; output && *name != 0; name++) {
+        char* path = dirPath[0] == '\0' ? CopyPhysFSString(*name) : FormatPhysFSString("%s/%s", dirPath, *name);
+        PHYSFS_Stat stat;
+        output = path != 0;
+        if (output && GetPhysFSPathStat(path, &stat)) {
+            bool isDirectory = stat.filetype == PHYSFS_FILETYPE_DIRECTORY;
+            if (IsPhysFSFilterMatch(filter, path + prefixLength, isDirectory)) {
+                output = AddPhysFSFileInfo(list, path, &stat);
+            }
+            if (output && isDirectory && recursive) {
+                output = AddPhysFSDirectoryFileInfo(list, path, prefixLength, filter, recursive);
+            }
+        }
+        MemFree(path);
+    }
+    PHYSFS_freeList(names);
+    return output;
+}
+
+/**
+ * Compares files by their paths, for sorting.
+ *
+ * @internal
+ */
+int ComparePhysFSFileInfo(const void* a, const void* b) {
+    return strcmp(((const PhysFSFileInfo*)a)->path, ((const PhysFSFileInfo*)b)->path);
+}
+
+/**
+ * Gets the files in the given directory in PhysFS, along with their types, sizes and modification times.
+ *
+ * Paths are full paths in PhysFS, so they can be loaded as they are, and the list is sorted by
+ * path. The directory is walked once, taking each path's information from the same lookup that
+ * finds it. With SetPhysFSIndexing() enabled, that information comes from the index, so the mounts
+ * are only asked for the names in each directory that's walked.
+ *
+ * The filter is a list of items separated by semicolons. Extensions, like ".png", match files with
+ * that extension regardless of case. Patterns, like "textures/hero*.png", match files by their path
+ * within the directory, where '*' matches any run of characters, slashes included, and '?' any
+ * one character. "DIR" matches directories. Without a filter, everything is listed.
+ *
+ * Make sure to clear the loaded list by using UnloadDirectoryFilesFromPhysFSEx().
+ *
+ * @param dirPath The directory in PhysFS to list.
+ * @param filter The files to list, like ".png;.wav", "textures/hero*.png" or "DIR". Can be 0 to list everything.
+ * @param recursive Whether to list the files within subdirectories too.
+ *
+ * @return The files that were found, or an empty list if the directory doesn't exist.
+ *
+ * @see UnloadDirectoryFilesFromPhysFSEx()
+ * @see LoadDirectoryFilesFromPhysFS()
+ */
+PhysFSFileInfoList LoadDirectoryFilesFromPhysFSEx(const char* dirPath, const char* filter, bool recursive) {
+    PhysFSFileInfoList output = { 0 };
+    OpenPhysFSLazyMounts(dirPath, true);
+    if (!DirectoryExistsInPhysFS(dirPath)) {
+        TraceLog(LOG_WARNING, "PHYSFS: Can't get files from non-existant directory (%s)", dirPath);
+        return output;
+    }
+
+    // List paths the way the index keeps them, without leading or trailing slashes.
+    char* path = CopyPhysFSString(dirPath);
+    if (path == 0) {
+        return output;
+    }
+    char* start = path;
+    while (*start == '/') {
+        start++;
+    }
+    int length = (int)TextLength(start);
+    while (length > 0 && start[length - 1] == '/') {
+        start[--length] = '\0';
+    }
+
+    bool success = AddPhysFSDirectoryFileInfo(&output, start, length > 0 ? length + 1 : 0, filter, recursive);
+    MemFree(path);
+
+    if (!success) {
+        TraceLog(LOG_WARNING, "PHYSFS: Failed to list the files in '%s'", dirPath);
+        UnloadDirectoryFilesFromPhysFSEx(output);
+        PhysFSFileInfoList empty = { 0 };
+        return empty;
+    }
+    if (output.count > 1) {
+        qsort(output.files, output.count, sizeof(PhysFSFileInfo), ComparePhysFSFileInfo);
+    }
+
+    long long size = (long long)sizeof(PhysFSFileInfo) * output.capacity;
+    for (unsigned int i = 0; i < output.count; i++) {
+        size += TextLength(output.files[i].path) + 1;
+    }
+    TrackPhysFSAllocation(output.files, size, "LoadDirectoryFilesFromPhysFSEx", dirPath);
+    return output;
+}
+
 /**
  * Get file modification time (last write time) from a file in PhysFS.
  *
@@ -609,7 +8906,7 @@ FilePathList LoadDirectoryFilesFromPhysFS(const char* dirPath) {
  */
 long GetFileModTimeFromPhysFS(const char* fileName) {
     PHYSFS_Stat stat;
-    if (PHYSFS_stat(fileName, &stat) == 0) {
+    if (!GetPhysFSPathStat(fileName, &stat)) {
         TraceLog(LOG_WARNING, "PHYSFS: Cannot get mod time of file (%s)", fileName);
         return -1;
     }
@@ -617,32 +8914,349 @@ long GetFileModTimeFromPhysFS(const char* fileName) {
     return stat.modtime;
 }
 
+/**
+ * Interns the given path, for the functions that take a path id instead of a path.
+ *
+ * Looking a path id up skips hashing and copying the path, and what the path resolves to is kept
+ * until something is mounted, unmounted or saved through raylib-physfs, so repeated lookups of the
+ * same paths, like those of a streaming system each frame, don't reach PhysFS at all. Changes made
+ * through PhysFS directly aren't noticed. Ids are kept until ClosePhysFS().
+ *
+ * @param fileName The path to intern. The file doesn't need to exist yet.
+ *
+ * @return The id of the path, the same for the same path, or 0 on failure.
+ *
+ * @see FileExistsInPhysFSById()
+ * @see LoadFileDataFromPhysFSById()
+ * @see GetFileModTimeFromPhysFSById()
+ */
+int GetPhysFSPathId(const char* fileName) {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot get a path id before InitPhysFS()");
+        return 0;
+    }
+    if (fileName == 0) {
+        return 0;
+    }
+
+    while (*fileName == '/') {
+        fileName++;
+    }
+    unsigned int hash = HashPhysFSString(fileName);
+    LockPhysFSMutex(physfsPathIdMutex);
+    int index = FindInPhysFSHashMap(&physfsPathIdMap, fileName, hash);
+    if (index != -1) {
+        UnlockPhysFSMutex(physfsPathIdMutex);
+        return index + 1;
+    }
+
+    // Lookups read the ids without the interning mutex, so growing them takes all of their locks.
+    LockPhysFSPathIds();
+    if (physfsPathIdCount == physfsPathIdCapacity) {
+        int capacity = physfsPathIdCapacity == 0 ? 256 : physfsPathIdCapacity * 2;
+        if (!GrowPhysFSArray((void**)&physfsPathIds, sizeof(PhysFSPathId) * capacity)) {
+            UnlockPhysFSPathIds();
+            UnlockPhysFSMutex(physfsPathIdMutex);
+            return 0;
+        }
+        physfsPathIdCapacity = capacity;
+    }
+    char* path = CopyPhysFSString(fileName);
+    if (path == 0 || !AddToPhysFSHashMap(&physfsPathIdMap, path, hash, physfsPathIdCount)) {
+        UnlockPhysFSPathIds();
+        UnlockPhysFSMutex(physfsPathIdMutex);
+        MemFree(path);
+        return 0;
+    }
+    PhysFSPathId entry = { 0 };
+    entry.path = path;
+    physfsPathIds[physfsPathIdCount++] = entry;
+    int pathId = physfsPathIdCount;
+    UnlockPhysFSPathIds();
+    UnlockPhysFSMutex(physfsPathIdMutex);
+    return pathId;
+}
+
+/**
+ * Determine if the file with the given path id exists in the search path.
+ *
+ * @param pathId The id of the path, from GetPhysFSPathId().
+ *
+ * @return True if the file exists, false otherwise.
+ *
+ * @see FileExistsInPhysFS()
+ */
+bool FileExistsInPhysFSById(int pathId) {
+    PHYSFS_Stat stat;
+    const char* fileName;
+    if (!GetPhysFSPathIdStat(pathId, &stat, &fileName)) {
+        return false;
+    }
+    return stat.filetype == PHYSFS_FILETYPE_REGULAR;
+}
+
+/**
+ * Loads the file with the given path id as a byte array from PhysFS (read).
+ *
+ * Files that are known not to exist fail without reaching PhysFS. Other files are loaded like
+ * LoadFileDataFromPhysFS() does, including from the cache, but without looking them up or asking
+ * for their size again.
+ *
+ * @param pathId The id of the path, from GetPhysFSPathId().
+ * @param bytesRead An integer to save the bytes that were read.
+ *
+ * @return The file data as a pointer. Make sure to use UnloadFileDataFromPhysFS() when finished using the file data.
+ *
+ * @see LoadFileDataFromPhysFS()
+ */
+unsigned char* LoadFileDataFromPhysFSById(int pathId, int* bytesRead) {
+    PHYSFS_Stat stat;
+    const char* fileName;
+    if (!GetPhysFSPathIdStat(pathId, &stat, &fileName) || stat.filetype != PHYSFS_FILETYPE_REGULAR) {
+        *bytesRead = 0;
+        if (fileName != 0) {
+            double startTime = GetPhysFSRequestTime();
+            RecordPhysFSAccess(fileName);
+            TraceLog(LOG_WARNING, "PHYSFS: Tried to load unexisting file '%s'", fileName);
+            RecordPhysFSCall(PHYSFS_STATS_LOAD_FILE_DATA, fileName, 0.0, 0.0, 0.0, 0, 0, true);
+            RecordPhysFSRequest(PHYSFS_STATS_LOAD_FILE_DATA, fileName, startTime, 0, true);
+        }
+        return 0;
+    }
+
+    // What the id resolved to is known, so the file isn't looked up again.
+    return LoadPhysFSFileData(fileName, bytesRead, &stat, true);
+}
+
+/**
+ * Get file modification time (last write time) from the file with the given path id.
+ *
+ * @param pathId The id of the path, from GetPhysFSPathId().
+ *
+ * @return The modification time (last write time) of the given file. -1 on failure.
+ *
+ * @see GetFileModTimeFromPhysFS()
+ */
+long GetFileModTimeFromPhysFSById(int pathId) {
+    PHYSFS_Stat stat;
+    const char* fileName;
+    if (!GetPhysFSPathIdStat(pathId, &stat, &fileName)) {
+        TraceLog(LOG_WARNING, "PHYSFS: Cannot get mod time of file (%s)", fileName != 0 ? fileName : "unknown path id");
+        return -1;
+    }
+
+    return stat.modtime;
+}
+
 /**
  * Close the PhysFS virtual file system.
  *
+ * Music that's still loaded from PhysFS is unloaded, so it must not be played or updated afterwards.
+ *
  * @return True on success, false on failure.
  */
 bool ClosePhysFS() {
+    if (!IsPhysFSReady()) {
+        TraceLog(LOG_WARNING, "PHYSFS: ClosePhysFS() called before InitPhysFS()");
+        return false;
+    }
+
+    // Stop the workers before anything they may be reading goes away.
+    StopPhysFSWorkers();
+    DestroyPhysFSCondition(physfsJobDone);
+    DestroyPhysFSCondition(physfsJobQueued);
+    DestroyPhysFSMutex(physfsJobMutex);
+
+    // Unload any music that's still loaded, while its file data is still around.
+    SetPhysFSMusicThread(false);
+    if (physfsMusicCount > 0) {
+        TraceLog(LOG_WARNING, "PHYSFS: Unloading %i music streams that were not unloaded with UnloadMusicStreamFromPhysFS()", physfsMusicCount);
+    }
+    for (int i = 0; i < physfsMusicCount; i++) {
+        UnloadMusicStream(physfsMusics[i].music);
+        UnmapFileView(physfsMusics[i].view);
+    }
+    MemFree(physfsMusics);
+    physfsMusics = 0;
+    physfsMusicCount = 0;
+    DestroyPhysFSMutex(physfsMusicMutex);
+
+    // Free the cache, including anything file views still read from.
+    for (int i = 0; i < physfsCacheEntryCount; i++) {
+        MemFree(physfsCacheEntries[i].fileName);
+        MemFree(physfsCacheEntries[i].data);
+    }
+    MemFree(physfsCacheEntries);
+    UnloadPhysFSHashMap(&physfsCacheMap);
+    physfsCacheEntries = 0;
+    physfsCacheEntryCount = 0;
+    physfsCacheEntryFree = -1;
+    physfsCacheFirst = -1;
+    physfsCacheLast = -1;
+    PhysFSCacheStats stats = { 0 };
+    physfsCacheStats = stats;
+    DestroyPhysFSMutex(physfsCacheMutex);
+
+    UnloadPhysFSIndex();
+    physfsIndexing = 0;
+    physfsIndexSnapshotKeyValid = false;
+    MemFree(physfsIndexSnapshotDirectory);
+    physfsIndexSnapshotDirectory = 0;
+    DestroyPhysFSMutex(physfsIndexMutex);
+
+    for (int i = 0; i < physfsLazyMountCount; i++) {
+        MemFree(physfsLazyMounts[i].newDir);
+        MemFree(physfsLazyMounts[i].mountPoint);
+    }
+    MemFree(physfsLazyMounts);
+    physfsLazyMounts = 0;
+    physfsLazyMountCount = 0;
+    DestroyPhysFSCondition(physfsLazyOpened);
+    DestroyPhysFSMutex(physfsLazyMutex);
+
+    for (int i = 0; i < physfsPathIdCount; i++) {
+        MemFree(physfsPathIds[i].path);
+    }
+    MemFree(physfsPathIds);
+    UnloadPhysFSHashMap(&physfsPathIdMap);
+    physfsPathIds = 0;
+    physfsPathIdCount = 0;
+    physfsPathIdCapacity = 0;
+    for (int i = 0; i < PHYSFS_PATH_ID_LOCKS; i++) {
+        DestroyPhysFSMutex(physfsPathIdLocks[i]);
+    }
+    DestroyPhysFSMutex(physfsPathIdMutex);
+
+    ClearPhysFSAccessOrder();
+    physfsAccessRecording = 0;
+    DestroyPhysFSMutex(physfsAccessMutex);
+
+    ClearPhysFSIORecording();
+    physfsIORecording = 0;
+    DestroyPhysFSMutex(physfsIOMutex);
+
+    UnloadPhysFSImageMap();
+    DestroyPhysFSMutex(physfsImageMapMutex);
+
+#ifdef RAYLIB_PHYSFS_STATS
+    // Threads notice the new generation on their next call, and start over.
+    while (physfsStatsThreads != 0) {
+        PhysFSStatsThread* next = physfsStatsThreads->next;
+        DestroyPhysFSMutex(physfsStatsThreads->mutex);
+        MemFree(physfsStatsThreads);
+        physfsStatsThreads = next;
+    }
+    DestroyPhysFSMutex(physfsStatsMutex);
+#endif
+
+#ifdef RAYLIB_PHYSFS_TRACE
+    while (physfsTraceThreads != 0) {
+        PhysFSTraceThread* next = physfsTraceThreads->next;
+        MemFree(physfsTraceThreads);
+        physfsTraceThreads = next;
+    }
+    physfsTraceThreadCount = 0;
+    DestroyPhysFSMutex(physfsTraceMutex);
+#endif
+
+    // Forget about asset groups that were not unloaded, and resources still acquired through the registry.
+    if (physfsAssetGroupCount > 0) {
+        TraceLog(LOG_WARNING, "PHYSFS: %i asset groups were not unloaded with UnloadPhysFSAssetGroup()", physfsAssetGroupCount);
+    }
+    for (int i = 0; i < physfsAssetGroupCount; i++) {
+        for (int j = 0; j < physfsAssetGroups[i].assetCount; j++) {
+            MemFree(physfsAssetGroups[i].assets[j].fileName);
+            MemFree(physfsAssetGroups[i].assets[j].fsFileName);
+        }
+        MemFree(physfsAssetGroups[i].assets);
+        MemFree(physfsAssetGroups[i].name);
+    }
+    MemFree(physfsAssetGroups);
+    physfsAssetGroups = 0;
+    physfsAssetGroupCount = 0;
+    UnloadPhysFSResourcePool(&physfsTexturePool);
+    UnloadPhysFSResourcePool(&physfsWavePool);
+    UnloadPhysFSResourcePool(&physfsFontPool);
+    UnloadPhysFSResourcePool(&physfsShaderPool);
+
+#ifdef RAYLIB_PHYSFS_TRACK_MEMORY
+    // Report the buffers that were never unloaded.
+    if (physfsMemoryStats.buffers > 0) {
+        TraceLog(LOG_WARNING, "PHYSFS: %i buffers holding %lli bytes were not unloaded", physfsMemoryStats.buffers, physfsMemoryStats.bytes);
+    }
+    for (int i = 0; i < physfsAllocationCapacity; i++) {
+        if (physfsAllocations[i].data != 0) {
+            TraceLog(LOG_WARNING, "PHYSFS:     %lli bytes from %s('%s')", physfsAllocations[i].size, physfsAllocations[i].api, physfsAllocations[i].fileName);
+            MemFree(physfsAllocations[i].fileName);
+        }
+    }
+    MemFree(physfsAllocations);
+    physfsAllocations = 0;
+    physfsAllocationCapacity = 0;
+    PhysFSMemoryStats memoryStats = { 0 };
+    physfsMemoryStats = memoryStats;
+    DestroyPhysFSMutex(physfsMemoryMutex);
+#endif
+
     if (PHYSFS_deinit() == 0) {
         TracePhysFSError("ClosePhysFS() unsuccessful");
         return false;
     }
+
+    // All packs have been closed by now.
+    DestroyPhysFSMutex(physfsPackMutex);
+
+#ifdef RAYLIB_PHYSFS_MMAP
+    // All mapped archives have been unmounted by now.
+    MemFree(physfsMappedArchives);
+    physfsMappedArchives = 0;
+    physfsMappedArchiveCount = 0;
+    DestroyPhysFSMutex(physfsMappedArchiveMutex);
+    while (physfsZips != 0) {
+        PhysFSZipData* zip = physfsZips;
+        physfsZips = zip->next;
+        UnloadPhysFSZipData(zip);
+    }
+    DestroyPhysFSMutex(physfsZipMutex);
+#endif
+
     TraceLog(LOG_DEBUG, "PHYSFS: Closed successfully");
     return true;
 }
 
+/**
+ * Loads file data for raylib, which frees it with UnloadFileData(), so it isn't tracked.
+ *
+ * @internal
+ */
+unsigned char* LoadPhysFSCallbackFileData(const char* fileName, int* bytesRead) {
+    return LoadPhysFSFileData(fileName, bytesRead, 0, false);
+}
+
+/**
+ * Loads text for raylib, which frees it with UnloadFileText(), so it isn't tracked.
+ *
+ * @internal
+ */
+char* LoadPhysFSCallbackFileText(const char* fileName) {
+    return LoadPhysFSFileText(fileName, false);
+}
+
 /**
  * Sets the raylib file saver/loader callbacks to use PhysFS.
  *
+ * Data that raylib loads through them isn't counted by GetPhysFSMemoryStats(), as raylib frees it
+ * with UnloadFileData() and UnloadFileText().
+ *
  * @see SetLoadFileDataCallback()
  * @see SetSaveFileDataCallback()
  * @see SetLoadFileTextCallback()
  * @see SetSaveFileTextCallback()
  */
 void SetPhysFSCallbacks() {
-    SetLoadFileDataCallback(LoadFileDataFromPhysFS);
+    SetLoadFileDataCallback(LoadPhysFSCallbackFileData);
     SetSaveFileDataCallback(SaveFileDataToPhysFS);
-    SetLoadFileTextCallback(LoadFileTextFromPhysFS);
+    SetLoadFileTextCallback(LoadPhysFSCallbackFileText);
     SetSaveFileTextCallback(SaveFileTextToPhysFS);
 }
 
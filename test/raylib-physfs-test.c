@@ -4,6 +4,276 @@
 #define RAYLIB_PHYSFS_IMPLEMENTATION
 #include "raylib-physfs.h"
 
+// A PhysFS archiver for "*.testjobs" archives. Reading its "hold" file holds the worker until it's
+// released, and reading its one letter files records the order they're read in.
+static PhysFSMutex testJobMutex;
+static PhysFSCondition testJobCondition;
+static int testJobsBlocked = 0;
+static int testJobsReleased = 0;
+static char testJobOrder[16];
+static int testJobOrderCount = 0;
+
+static const char testJobLetters[] = "abcdefghs";
+static const char testJobManifest[] = "[jobs]\nwave jobs/s.wav\n";
+static const unsigned char testJobWave[48] = {
+    'R', 'I', 'F', 'F', 40, 0, 0, 0, 'W', 'A', 'V', 'E',
+    'f', 'm', 't', ' ', 16, 0, 0, 0, 1, 0, 1, 0, 0x44, 0xAC, 0x00, 0x00, 0x88, 0x58, 0x01, 0x00, 2, 0, 16, 0,
+    'd', 'a', 't', 'a', 4, 0, 0, 0, 0, 0, 0, 0
+};
+
+typedef struct TestJobFile {
+    const unsigned char* data;
+    long long size;
+    long long position;
+    char letter;                        // What reading it records, 0 for nothing
+    bool hold;
+} TestJobFile;
+
+static bool GetTestJobFile(const char* name, TestJobFile* file) {
+    file->position = 0;
+    file->letter = 0;
+    file->hold = TextIsEqual(name, "hold");
+    if (file->hold) {
+        file->data = (const unsigned char*)"H";
+        file->size = 1;
+    } else if (TextIsEqual(name, "manifest.txt")) {
+        file->data = (const unsigned char*)testJobManifest;
+        file->size = (long long)TextLength(testJobManifest);
+    } else if (TextIsEqual(name, "s.wav")) {
+        file->data = testJobWave;
+        file->size = sizeof(testJobWave);
+        file->letter = 's';
+    } else if (TextLength(name) == 1 && name[0] >= 'a' && name[0] <= 'h') {
+        file->data = (const unsigned char*)testJobLetters + (name[0] - 'a');
+        file->size = 1;
+        file->letter = name[0];
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static PHYSFS_Io* CreateTestJobIo(const TestJobFile* file);
+
+static PHYSFS_sint64 ReadTestJobIo(PHYSFS_Io* io, void* buffer, PHYSFS_uint64 length) {
+    TestJobFile* file = (TestJobFile*)io->opaque;
+    if (file->position == 0 && length > 0) {
+        LockPhysFSMutex(testJobMutex);
+        if (file->hold) {
+            int ticket = testJobsBlocked++;
+            BroadcastPhysFSCondition(testJobCondition);
+            while (testJobsReleased <= ticket) {
+                WaitPhysFSCondition(testJobCondition, testJobMutex);
+            }
+        } else if (file->letter != 0 && testJobOrderCount < (int)sizeof(testJobOrder) - 1) {
+            testJobOrder[testJobOrderCount++] = file->letter;
+            testJobOrder[testJobOrderCount] = '\0';
+        }
+        UnlockPhysFSMutex(testJobMutex);
+    }
+    long long remaining = file->size - file->position;
+    long long count = (long long)length < remaining ? (long long)length : remaining;
+    for (long long i = 0; i < count; i++) {
+        ((unsigned char*)buffer)[i] = file->data[file->position + i];
+    }
+    file->position += count;
+    return count;
+}
+
+static PHYSFS_sint64 WriteTestJobIo(PHYSFS_Io* io, const void* buffer, PHYSFS_uint64 length) {
+    (void)io;
+    (void)buffer;
+    (void)length;
+    PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+    return -1;
+}
+
+static int SeekTestJobIo(PHYSFS_Io* io, PHYSFS_uint64 offset) {
+    TestJobFile* file = (TestJobFile*)io->opaque;
+    if ((long long)offset > file->size) {
+        PHYSFS_setErrorCode(PHYSFS_ERR_PAST_EOF);
+        return 0;
+    }
+    file->position = (long long)offset;
+    return 1;
+}
+
+static PHYSFS_sint64 TellTestJobIo(PHYSFS_Io* io) {
+    return ((TestJobFile*)io->opaque)->position;
+}
+
+static PHYSFS_sint64 GetTestJobIoLength(PHYSFS_Io* io) {
+    return ((TestJobFile*)io->opaque)->size;
+}
+
+static PHYSFS_Io* DuplicateTestJobIo(PHYSFS_Io* io) {
+    TestJobFile file = *(TestJobFile*)io->opaque;
+    file.position = 0;
+    return CreateTestJobIo(&file);
+}
+
+static int FlushTestJobIo(PHYSFS_Io* io) {
+    (void)io;
+    return 1;
+}
+
+static void DestroyTestJobIo(PHYSFS_Io* io) {
+    MemFree(io->opaque);
+    MemFree(io);
+}
+
+static PHYSFS_Io* CreateTestJobIo(const TestJobFile* file) {
+    PHYSFS_Io* io = (PHYSFS_Io*)MemAlloc(sizeof(PHYSFS_Io));
+    TestJobFile* opaque = (TestJobFile*)MemAlloc(sizeof(TestJobFile));
+    if (io == 0 || opaque == 0) {
+        MemFree(io);
+        MemFree(opaque);
+        PHYSFS_setErrorCode(PHYSFS_ERR_OUT_OF_MEMORY);
+        return 0;
+    }
+    *opaque = *file;
+    io->version = 0;
+    io->opaque = opaque;
+    io->read = ReadTestJobIo;
+    io->write = WriteTestJobIo;
+    io->seek = SeekTestJobIo;
+    io->tell = TellTestJobIo;
+    io->length = GetTestJobIoLength;
+    io->duplicate = DuplicateTestJobIo;
+    io->flush = FlushTestJobIo;
+    io->destroy = DestroyTestJobIo;
+    return io;
+}
+
+static void* OpenTestJobArchive(PHYSFS_Io* io, const char* name, int forWrite, int* claimed) {
+    if (!IsFileExtension(name, ".testjobs")) {
+        return 0;
+    }
+    *claimed = 1;
+    if (forWrite) {
+        PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+        return 0;
+    }
+    return io;
+}
+
+static PHYSFS_EnumerateCallbackResult EnumerateTestJobArchive(void* opaque, const char* dirName, PHYSFS_EnumerateCallback callback, const char* origDir, void* callbackData) {
+    (void)opaque;
+    (void)dirName;
+    (void)callback;
+    (void)origDir;
+    (void)callbackData;
+    return PHYSFS_ENUM_OK;
+}
+
+static PHYSFS_Io* OpenReadTestJobArchive(void* opaque, const char* name) {
+    (void)opaque;
+    TestJobFile file;
+    if (!GetTestJobFile(name, &file)) {
+        PHYSFS_setErrorCode(PHYSFS_ERR_NOT_FOUND);
+        return 0;
+    }
+    return CreateTestJobIo(&file);
+}
+
+static PHYSFS_Io* OpenWriteTestJobArchive(void* opaque, const char* name) {
+    (void)opaque;
+    (void)name;
+    PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+    return 0;
+}
+
+static int ModifyTestJobArchive(void* opaque, const char* name) {
+    (void)opaque;
+    (void)name;
+    PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+    return 0;
+}
+
+static int StatTestJobArchive(void* opaque, const char* name, PHYSFS_Stat* stat) {
+    (void)opaque;
+    TestJobFile file = { 0 };
+    bool root = name[0] == '\0';
+    if (!root && !GetTestJobFile(name, &file)) {
+        PHYSFS_setErrorCode(PHYSFS_ERR_NOT_FOUND);
+        return 0;
+    }
+    stat->filesize = root ? 0 : file.size;
+    stat->modtime = 0;
+    stat->createtime = 0;
+    stat->accesstime = 0;
+    stat->filetype = root ? PHYSFS_FILETYPE_DIRECTORY : PHYSFS_FILETYPE_REGULAR;
+    stat->readonly = 1;
+    return 1;
+}
+
+static void CloseTestJobArchive(void* opaque) {
+    PHYSFS_Io* io = (PHYSFS_Io*)opaque;
+    io->destroy(io);
+}
+
+static const PHYSFS_Archiver testJobArchiver = {
+    0,
+    { "testjobs", "raylib-physfs test jobs", "raylib-physfs", "https://github.com/RobLoach/raylib-physfs", 0 },
+    OpenTestJobArchive,
+    EnumerateTestJobArchive,
+    OpenReadTestJobArchive,
+    OpenWriteTestJobArchive,
+    OpenWriteTestJobArchive,
+    ModifyTestJobArchive,
+    ModifyTestJobArchive,
+    StatTestJobArchive,
+    CloseTestJobArchive
+};
+
+static void ReleaseTestJobs(int count) {
+    LockPhysFSMutex(testJobMutex);
+    testJobsReleased = count;
+    BroadcastPhysFSCondition(testJobCondition);
+    UnlockPhysFSMutex(testJobMutex);
+}
+
+static void HoldTestWorkers(int* blockers) {
+    testJobsBlocked = 0;
+    testJobsReleased = 0;
+    testJobOrderCount = 0;
+    testJobOrder[0] = '\0';
+    for (int i = 0; i < RAYLIB_PHYSFS_WORKER_COUNT; i++) {
+        blockers[i] = LoadFileDataFromPhysFSAsync("jobs/hold", 100);
+        AssertNotEqual(blockers[i], 0);
+    }
+    LockPhysFSMutex(testJobMutex);
+    while (testJobsBlocked < RAYLIB_PHYSFS_WORKER_COUNT) {
+        WaitPhysFSCondition(testJobCondition, testJobMutex);
+    }
+    UnlockPhysFSMutex(testJobMutex);
+}
+
+static void FreeTestWorkers(int* blockers) {
+    ReleaseTestJobs(RAYLIB_PHYSFS_WORKER_COUNT);
+    for (int i = 0; i < RAYLIB_PHYSFS_WORKER_COUNT; i++) {
+        int bytesRead = 0;
+        UnloadFileDataFromPhysFS(WaitPhysFSJob(blockers[i], &bytesRead));
+    }
+}
+
+static PhysFSThreadResult ReleaseTestJobLater(void* arg) {
+    (void)arg;
+    // Give LoadPhysFSAssetGroup() time to raise the group's jobs before letting a worker go.
+    SleepPhysFSThread(100);
+    ReleaseTestJobs(1);
+    return 0;
+}
+
+static PhysFSThreadResult MountTestMappedArchive(void* arg) {
+    for (int i = 0; i < 100; i++) {
+        if (MountPhysFSMapped((const char*)arg, "mapped-thread", false)) {
+            UnmountPhysFS((const char*)arg);
+        }
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
     // Initialization
     SetTraceLogLevel(LOG_ALL);
@@ -27,6 +297,99 @@ int main(int argc, char *argv[]) {
     // MountPhysFS()
     Assert(MountPhysFS("resources", "assets"));
 
+    // MountPhysFSMapped()
+    {
+        Assert(MountPhysFSMapped("resources/archive.zip", "mapped", false));
+        char* text = LoadFileTextFromPhysFS("mapped/deflated.txt");
+        AssertNotEqual(text, 0);
+        AssertEqual(TextLength(text), 14 * 64);
+        UnloadFileTextFromPhysFS(text);
+        Assert(UnmountPhysFS("resources/archive.zip"));
+
+        AssertNot(MountPhysFSMapped("resources/MissingArchive.zip", "mapped", true));
+
+        // Archives can be mapped and unmapped from several threads at once.
+        int archiveSize = 0;
+        unsigned char* archive = LoadFileData("resources/archive.zip", &archiveSize);
+        Assert(SaveFileData("mapped-copy.zip", archive, archiveSize));
+        UnloadFileData(archive);
+        PhysFSThread mounter;
+        Assert(CreatePhysFSThread(mounter, MountTestMappedArchive, (void*)"mapped-copy.zip"));
+        MountTestMappedArchive((void*)"resources/archive.zip");
+        JoinPhysFSThread(mounter);
+        AssertNot(FileExistsInPhysFS("mapped-thread/stored.txt"));
+        remove("mapped-copy.zip");
+    }
+
+    // MountPhysFSLazy()
+    {
+        Assert(MountPhysFSLazy("resources/archive.zip", "lazy/archive"));
+        AssertNot(MountPhysFSLazy("resources/MissingArchive.zip", "lazy/missing"));
+        AssertEqual(PHYSFS_getMountPoint("resources/archive.zip"), 0);
+        Assert(FileExistsInPhysFS("assets/text.txt"));
+        AssertNot(FileExistsInPhysFS("lazyfile.txt"));
+        AssertEqual(PHYSFS_getMountPoint("resources/archive.zip"), 0);
+
+        // The directories leading to the mount point exist without mounting it.
+        Assert(DirectoryExistsInPhysFS("lazy"));
+        Assert(DirectoryExistsInPhysFS("/lazy/"));
+        AssertNot(FileExistsInPhysFS("lazy"));
+        AssertEqual(PHYSFS_getMountPoint("resources/archive.zip"), 0);
+
+        // Looking up a path within the mount point mounts it.
+        Assert(FileExistsInPhysFS("lazy/archive/stored.txt"));
+        AssertNotEqual(PHYSFS_getMountPoint("resources/archive.zip"), 0);
+        Assert(UnmountPhysFS("resources/archive.zip"));
+
+        // Lazy mounts that were never used unmount without being mounted.
+        Assert(MountPhysFSLazy("resources/archive.zip", "/lazy/archive/"));
+        Assert(UnmountPhysFS("resources/archive.zip"));
+        AssertNot(DirectoryExistsInPhysFS("lazy"));
+        AssertEqual(PHYSFS_getMountPoint("resources/archive.zip"), 0);
+
+        // Loads on the worker threads that all need it wait for one of them to mount it.
+        Assert(MountPhysFSLazy("resources/archive.zip", "lazy/archive"));
+        int jobs[4];
+        for (int i = 0; i < 4; i++) {
+            jobs[i] = LoadFileDataFromPhysFSAsync("lazy/archive/stored.txt", 0);
+        }
+        for (int i = 0; i < 4; i++) {
+            int bytesRead = 0;
+            unsigned char* data = WaitPhysFSJob(jobs[i], &bytesRead);
+            AssertEqual(bytesRead, 13);
+            UnloadFileDataFromPhysFS(data);
+        }
+        Assert(UnmountPhysFS("resources/archive.zip"));
+
+        // Lazy mounts keep their place in the search path, ahead of mounts over them registered later.
+        Assert(PHYSFS_mkdir("lazy-order/archive"));
+        Assert(SaveFileTextToPhysFS("lazy-order/archive/stored.txt", "Later"));
+        Assert(SaveFileTextToPhysFS("lazy-order/later.txt", "Later"));
+        Assert(MountPhysFSLazy("resources/archive.zip", "order/archive"));
+        Assert(MountPhysFSLazy("lazy-order", "order"));
+        Assert(FileExistsInPhysFS("order/later.txt"));
+        AssertNotEqual(PHYSFS_getMountPoint("resources/archive.zip"), 0);
+        int bytesRead = 0;
+        unsigned char* data = LoadFileDataFromPhysFS("order/archive/stored.txt", &bytesRead);
+        AssertEqual(bytesRead, 13);
+        UnloadFileDataFromPhysFS(data);
+        Assert(UnmountPhysFS("lazy-order"));
+        Assert(UnmountPhysFS("resources/archive.zip"));
+
+        Assert(MountPhysFSLazy("resources/archive.zip", "order/archive"));
+        Assert(MountPhysFS("lazy-order", "order"));
+        AssertNotEqual(PHYSFS_getMountPoint("resources/archive.zip"), 0);
+        data = LoadFileDataFromPhysFS("order/archive/stored.txt", &bytesRead);
+        AssertEqual(bytesRead, 13);
+        UnloadFileDataFromPhysFS(data);
+        Assert(UnmountPhysFS("lazy-order"));
+        Assert(UnmountPhysFS("resources/archive.zip"));
+        PHYSFS_delete("lazy-order/archive/stored.txt");
+        PHYSFS_delete("lazy-order/archive");
+        PHYSFS_delete("lazy-order/later.txt");
+        PHYSFS_delete("lazy-order");
+    }
+
     // FileExistsInPhysFS()
     Assert(FileExistsInPhysFS("assets/text.txt"));
     AssertNot(FileExistsInPhysFS("MissingFile.txt"));
@@ -41,18 +404,179 @@ int main(int argc, char *argv[]) {
         unsigned char* fileData = LoadFileDataFromPhysFS("assets/text.txt", &bytesRead);
         Assert(fileData);
         Assert(bytesRead > 0);
-        UnloadFileData(fileData);
+        UnloadFileDataFromPhysFS(fileData);
 
         unsigned char* missingFileData = LoadFileDataFromPhysFS("MissingFile.txt", &bytesRead);
         AssertEqual(missingFileData, 0);
     }
 
+    // GetPhysFSPathId()
+    {
+        int textId = GetPhysFSPathId("assets/text.txt");
+        AssertNotEqual(textId, 0);
+        AssertEqual(GetPhysFSPathId("/assets/text.txt"), textId);
+        Assert(FileExistsInPhysFSById(textId));
+        Assert(FileExistsInPhysFSById(textId));
+        AssertEqual(GetFileModTimeFromPhysFSById(textId), GetFileModTimeFromPhysFS("assets/text.txt"));
+        int bytesRead = 0;
+        unsigned char* fileData = LoadFileDataFromPhysFSById(textId, &bytesRead);
+        AssertNotEqual(fileData, 0);
+        AssertEqual(bytesRead, 14);
+        UnloadFileDataFromPhysFS(fileData);
+
+        // Ids are looked up again once something is mounted or unmounted.
+        int storedId = GetPhysFSPathId("archive/stored.txt");
+        AssertNotEqual(storedId, textId);
+        AssertNot(FileExistsInPhysFSById(storedId));
+        AssertEqual(LoadFileDataFromPhysFSById(storedId, &bytesRead), 0);
+        AssertEqual(bytesRead, 0);
+        AssertEqual(GetFileModTimeFromPhysFSById(storedId), -1);
+        Assert(MountPhysFS("resources/archive.zip", "archive"));
+        Assert(FileExistsInPhysFSById(storedId));
+        fileData = LoadFileDataFromPhysFSById(storedId, &bytesRead);
+        AssertEqual(bytesRead, 13);
+        UnloadFileDataFromPhysFS(fileData);
+        Assert(UnmountPhysFS("resources/archive.zip"));
+        AssertNot(FileExistsInPhysFSById(storedId));
+
+        AssertNot(FileExistsInPhysFSById(GetPhysFSPathId("assets")));
+        AssertNot(FileExistsInPhysFSById(0));
+        AssertNot(FileExistsInPhysFSById(1000000));
+
+        // Ids keep resolving as more paths are interned.
+        for (int i = 0; i < 300; i++) {
+            int missingId = GetPhysFSPathId(TextFormat("assets/missing-%i.txt", i));
+            AssertNotEqual(missingId, 0);
+            AssertNot(FileExistsInPhysFSById(missingId));
+        }
+        AssertEqual(GetPhysFSPathId("assets/text.txt"), textId);
+        fileData = LoadFileDataFromPhysFSById(textId, &bytesRead);
+        AssertEqual(bytesRead, 14);
+        AssertEqual(fileData[0], 'H');
+        UnloadFileDataFromPhysFS(fileData);
+    }
+
+    // MapFileViewFromPhysFS()
+    {
+        FileView view = MapFileViewFromPhysFS("assets/text.txt");
+        AssertNotEqual(view.data, 0);
+        AssertEqual(view.size, 14);
+        AssertEqual(view.data[7], 'W');
+#ifdef RAYLIB_PHYSFS_MMAP
+        AssertNotEqual(view.mapping, 0);
+#endif
+        UnmapFileView(view);
+
+        // Stored entries are mapped, while compressed entries are copied.
+        Assert(MountPhysFS("resources/archive.zip", "archive"));
+        FileView stored = MapFileViewFromPhysFS("archive/stored.txt");
+        AssertEqual(stored.size, 13);
+        AssertEqual(stored.data[7], 'W');
+#ifdef RAYLIB_PHYSFS_MMAP
+        AssertNotEqual(stored.mapping, 0);
+#endif
+        UnmapFileView(stored);
+
+        FileView deflated = MapFileViewFromPhysFS("archive/deflated.txt");
+        AssertEqual(deflated.size, 14 * 64);
+        AssertEqual(deflated.data[7], 'W');
+        AssertEqual(deflated.mapping, 0);
+        UnmapFileView(deflated);
+        Assert(UnmountPhysFS("resources/archive.zip"));
+
+        // Archives mounted straight through PhysFS have their entries read on first use, and kept.
+        Assert(PHYSFS_mount("resources/archive.zip", "archive", 1));
+        for (int i = 0; i < 2; i++) {
+            stored = MapFileViewFromPhysFS("archive/stored.txt");
+            AssertEqual(stored.size, 13);
+            AssertEqual(stored.data[12], '!');
+#ifdef RAYLIB_PHYSFS_MMAP
+            AssertNotEqual(stored.mapping, 0);
+#endif
+            UnmapFileView(stored);
+        }
+        Assert(UnmountPhysFS("resources/archive.zip"));
+
+        FileView missingView = MapFileViewFromPhysFS("MissingFile.txt");
+        AssertEqual(missingView.data, 0);
+
+        // Empty files have a view with no contents, unlike missing files.
+        PHYSFS_close(PHYSFS_openWrite("empty.txt"));
+        Assert(MountPhysFS(GetWorkingDirectory(), "written"));
+        FileView empty = MapFileViewFromPhysFS("written/empty.txt");
+        AssertNotEqual(empty.data, 0);
+        AssertEqual(empty.size, 0);
+        UnmapFileView(empty);
+        Assert(UnmountPhysFS(GetWorkingDirectory()));
+        PHYSFS_delete("empty.txt");
+    }
+
+    // LoadFileDataFromPhysFSAsync()
+    {
+        int job = LoadFileDataFromPhysFSAsync("assets/text.txt", 0);
+        AssertNotEqual(job, 0);
+        while (!IsPhysFSJobDone(job)) {
+            WaitTime(0.001);
+        }
+        int bytesRead = 0;
+        unsigned char* fileData = WaitPhysFSJob(job, &bytesRead);
+        AssertNotEqual(fileData, 0);
+        AssertEqual(bytesRead, 14);
+        UnloadFileDataFromPhysFS(fileData);
+
+        // The handle is no longer valid once waited on.
+        AssertNot(IsPhysFSJobDone(job));
+        AssertEqual(WaitPhysFSJob(job, &bytesRead), 0);
+
+        // Higher priorities run first. All the workers are held, and then one is let go to run the rest one at a time.
+        InitPhysFSMutex(testJobMutex);
+        InitPhysFSCondition(testJobCondition);
+        Assert(PHYSFS_registerArchiver(&testJobArchiver));
+        Assert(MountPhysFSFromMemory((const unsigned char*)"jobs", 4, "jobs.testjobs", "jobs"));
+        int blockers[RAYLIB_PHYSFS_WORKER_COUNT];
+        HoldTestWorkers(blockers);
+        int jobs[8];
+        for (int i = 0; i < 8; i++) {
+            jobs[i] = LoadFileDataFromPhysFSAsync(TextFormat("jobs/%c", 'a' + i), i % 2 == 0 ? i : -i);
+            AssertNotEqual(jobs[i], 0);
+        }
+        ReleaseTestJobs(1);
+        for (int i = 0; i < 8; i++) {
+            fileData = WaitPhysFSJob(jobs[i], &bytesRead);
+            AssertEqual(bytesRead, 1);
+            AssertEqual(fileData[0], 'a' + i);
+            UnloadFileDataFromPhysFS(fileData);
+        }
+        FreeTestWorkers(blockers);
+        Assert(TextIsEqual(testJobOrder, "gecabdfh"));
+        Assert(UnmountPhysFS("jobs.testjobs"));
+
+        // Queued jobs can be cancelled.
+        for (int i = 0; i < 8; i++) {
+            jobs[i] = LoadFileDataFromPhysFSAsync("assets/image.png", i);
+            AssertNotEqual(jobs[i], 0);
+        }
+        Assert(CancelPhysFSJob(jobs[0]));
+        AssertNot(CancelPhysFSJob(jobs[0]));
+        for (int i = 1; i < 8; i++) {
+            fileData = WaitPhysFSJob(jobs[i], &bytesRead);
+            AssertNotEqual(fileData, 0);
+            UnloadFileDataFromPhysFS(fileData);
+        }
+
+        int missingJob = LoadFileDataFromPhysFSAsync("MissingFile.txt", 0);
+        AssertNotEqual(missingJob, 0);
+        AssertEqual(WaitPhysFSJob(missingJob, &bytesRead), 0);
+        AssertEqual(bytesRead, 0);
+    }
+
     // SaveFileDataToPhysFS()
     {
         Assert(SaveFileDataToPhysFS("resources/SaveFileDataToPhysFS.txt", "Hello", 5));
         unsigned int bytesRead = 0;
         unsigned char* fileData = LoadFileData("resources/SaveFileDataToPhysFS.txt", &bytesRead);
         AssertEqual(bytesRead, 5);
+        PHYSFS_delete("resources/SaveFileDataToPhysFS.txt");
     }
 
     // SaveFileTextToPhysFS()
@@ -63,27 +587,563 @@ int main(int argc, char *argv[]) {
         UnloadFileText(fileText);
     }
 
+    // ExportPhysFSPack()
+    {
+        Assert(ExportPhysFSPack("assets", "test.rpak"));
+        Assert(MountPhysFS("test.rpak", "pack"));
+        Assert(FileExistsInPhysFS("pack/text.txt"));
+        Assert(DirectoryExistsInPhysFS("pack"));
+        AssertNot(FileExistsInPhysFS("pack/MissingFile.txt"));
+
+        // Every file matches the original, whether stored or compressed.
+        FilePathList files = LoadDirectoryFilesFromPhysFS("pack");
+        Assert(files.count > 4);
+        for (unsigned int i = 0; i < files.count; i++) {
+            int packedSize = 0;
+            int originalSize = 0;
+            unsigned char* packed = LoadFileDataFromPhysFS(TextFormat("pack/%s", files.paths[i]), &packedSize);
+            unsigned char* original = LoadFileDataFromPhysFS(TextFormat("assets/%s", files.paths[i]), &originalSize);
+            AssertEqual(packedSize, originalSize);
+            for (int j = 0; j < packedSize; j++) {
+                AssertEqual(packed[j], original[j]);
+            }
+            UnloadFileDataFromPhysFS(packed);
+            UnloadFileDataFromPhysFS(original);
+        }
+        UnloadDirectoryFilesFromPhysFS(files);
+
+        // Uncompressed entries are mapped in place.
+        FileView view = MapFileViewFromPhysFS("pack/text.txt");
+        AssertEqual(view.size, 14);
+        AssertEqual(view.data[7], 'W');
+#ifdef RAYLIB_PHYSFS_MMAP
+        AssertNotEqual(view.mapping, 0);
+#endif
+        UnmapFileView(view);
+        Assert(UnmountPhysFS("test.rpak"));
+        PHYSFS_delete("test.rpak");
+
+        // Files too large to decompress at once are stored, and read back whole.
+        int largeSize = 64 * 1024 * 1024 + 1;
+        unsigned char* large = (unsigned char*)MemAlloc(largeSize);
+        large[largeSize - 1] = 'Z';
+        Assert(PHYSFS_mkdir("pack-large"));
+        Assert(SaveFileDataToPhysFS("pack-large/large.bin", large, largeSize));
+        Assert(MountPhysFS("pack-large", "large"));
+        Assert(ExportPhysFSPack("large", "test-large.rpak"));
+        Assert(UnmountPhysFS("pack-large"));
+        Assert(MountPhysFS("test-large.rpak", "packed-large"));
+        int packedLargeSize = 0;
+        unsigned char* packedLarge = LoadFileDataFromPhysFS("packed-large/large.bin", &packedLargeSize);
+        AssertEqual(packedLargeSize, largeSize);
+        Assert(packedLarge != 0 && memcmp(packedLarge, large, largeSize) == 0);
+        UnloadFileDataFromPhysFS(packedLarge);
+        MemFree(large);
+        Assert(UnmountPhysFS("test-large.rpak"));
+        PHYSFS_delete("pack-large/large.bin");
+        PHYSFS_delete("pack-large");
+        PHYSFS_delete("test-large.rpak");
+
+        // Nested directories keep files with the same name apart.
+        Assert(PHYSFS_mkdir("pack-tree/a/deep"));
+        Assert(PHYSFS_mkdir("pack-tree/b"));
+        Assert(SaveFileTextToPhysFS("pack-tree/same.txt", "top"));
+        Assert(SaveFileTextToPhysFS("pack-tree/a/same.txt", "a"));
+        Assert(SaveFileTextToPhysFS("pack-tree/a/deep/same.txt", "deep"));
+        Assert(SaveFileTextToPhysFS("pack-tree/b/same.txt", "b"));
+        Assert(MountPhysFS("pack-tree", "tree"));
+        Assert(ExportPhysFSPack("tree", "test-tree.rpak"));
+        Assert(UnmountPhysFS("pack-tree"));
+        Assert(MountPhysFS("test-tree.rpak", "nested"));
+
+        Assert(DirectoryExistsInPhysFS("nested/a"));
+        AssertNot(FileExistsInPhysFS("nested/a"));
+        Assert(DirectoryExistsInPhysFS("nested/a/deep"));
+        AssertNot(FileExistsInPhysFS("nested/a/deep"));
+        Assert(FileExistsInPhysFS("nested/a/deep/same.txt"));
+        AssertNot(DirectoryExistsInPhysFS("nested/a/deep/same.txt"));
+        AssertNot(FileExistsInPhysFS("nested/b/deep/same.txt"));
+        AssertNot(FileExistsInPhysFS("nested/deep/same.txt"));
+        AssertNot(FileExistsInPhysFS("nested/a/b/same.txt"));
+        AssertNot(DirectoryExistsInPhysFS("nested/b/deep"));
+
+        const char* nestedPaths[] = { "nested/same.txt", "nested/a/same.txt", "nested/a/deep/same.txt", "nested/b/same.txt" };
+        const char* nestedTexts[] = { "top", "a", "deep", "b" };
+        for (int i = 0; i < 4; i++) {
+            char* nestedText = LoadFileTextFromPhysFS(nestedPaths[i]);
+            Assert(TextIsEqual(nestedText, nestedTexts[i]));
+            UnloadFileTextFromPhysFS(nestedText);
+        }
+
+        // Listing a directory gives only what is directly in it.
+        const char* nestedDirs[] = { "nested", "nested/a", "nested/a/deep", "nested/b" };
+        const unsigned int nestedCounts[] = { 3, 2, 1, 1 };
+        for (int i = 0; i < 4; i++) {
+            FilePathList nestedFiles = LoadDirectoryFilesFromPhysFS(nestedDirs[i]);
+            AssertEqual(nestedFiles.count, nestedCounts[i]);
+            bool hasSame = false;
+            for (unsigned int j = 0; j < nestedFiles.count; j++) {
+                hasSame = hasSame || TextIsEqual(nestedFiles.paths[j], "same.txt");
+            }
+            Assert(hasSame);
+            UnloadDirectoryFilesFromPhysFS(nestedFiles);
+        }
+        Assert(UnmountPhysFS("test-tree.rpak"));
+
+        PHYSFS_delete("pack-tree/a/deep/same.txt");
+        PHYSFS_delete("pack-tree/a/deep");
+        PHYSFS_delete("pack-tree/a/same.txt");
+        PHYSFS_delete("pack-tree/a");
+        PHYSFS_delete("pack-tree/b/same.txt");
+        PHYSFS_delete("pack-tree/b");
+        PHYSFS_delete("pack-tree/same.txt");
+        PHYSFS_delete("pack-tree");
+        PHYSFS_delete("test-tree.rpak");
+    }
+
+    // ExportPhysFSPackEx()
+    {
+        // ZIP archives, with media stored as it is.
+        Assert(ExportPhysFSPackEx("assets", "test.zip", ".png;.wav"));
+        Assert(MountPhysFS("test.zip", "zip"));
+        char* text = LoadFileTextFromPhysFS("zip/text.txt");
+        Assert(TextIsEqual(text, "Hello, World!\n"));
+        UnloadFileTextFromPhysFS(text);
+
+        FileView view = MapFileViewFromPhysFS("zip/image.png");
+        AssertEqual(view.size, GetFileLength("resources/image.png"));
+#ifdef RAYLIB_PHYSFS_MMAP
+        AssertNotEqual(view.mapping, 0);
+#endif
+        UnmapFileView(view);
+        Assert(UnmountPhysFS("test.zip"));
+
+        // Packing the same files gives the same archive.
+        Assert(ExportPhysFSPackEx("assets", "test-again.zip", ".png;.wav"));
+        int size = 0;
+        int sizeAgain = 0;
+        unsigned char* data = LoadFileData("test.zip", &size);
+        unsigned char* dataAgain = LoadFileData("test-again.zip", &sizeAgain);
+        AssertEqual(size, sizeAgain);
+        for (int i = 0; i < size; i++) {
+            AssertEqual(data[i], dataAgain[i]);
+        }
+        UnloadFileData(data);
+        UnloadFileData(dataAgain);
+        remove("test.zip");
+        remove("test-again.zip");
+    }
+
+    // SetPhysFSAccessRecording()
+    {
+        SetPhysFSAccessRecording(true);
+        int bytesRead = 0;
+        UnloadFileDataFromPhysFS(LoadFileDataFromPhysFS("assets/sound.wav", &bytesRead));
+        UnloadFileDataFromPhysFS(LoadFileDataFromPhysFS("/assets/text.txt", &bytesRead));
+        UnloadFileDataFromPhysFS(LoadFileDataFromPhysFS("assets/sound.wav", &bytesRead));
+        SetPhysFSAccessRecording(false);
+        UnloadFileDataFromPhysFS(LoadFileDataFromPhysFS("assets/image.png", &bytesRead));
+
+        // ExportPhysFSAccessOrder()
+        Assert(ExportPhysFSAccessOrder("access-order.txt"));
+        char* accessOrder = LoadFileText("access-order.txt");
+        Assert(TextIsEqual(accessOrder, "assets/sound.wav\nassets/text.txt\n"));
+
+        // Packs lay out accessed files first.
+        Assert(ExportPhysFSPackPro("assets", "test-order.zip", 0, accessOrder));
+        UnloadFileText(accessOrder);
+        int size = 0;
+        unsigned char* data = LoadFileData("test-order.zip", &size);
+        AssertEqual(data[26], 9);
+        for (int i = 0; i < 9; i++) {
+            AssertEqual(data[30 + i], "sound.wav"[i]);
+        }
+        UnloadFileData(data);
+        remove("access-order.txt");
+        remove("test-order.zip");
+    }
+
+    // GetPhysFSMemoryStats()
+    {
+        PhysFSMemoryStats before = GetPhysFSMemoryStats();
+        int bytesRead = 0;
+        unsigned char* data = LoadFileDataFromPhysFS("assets/text.txt", &bytesRead);
+        char* text = LoadFileTextFromPhysFS("assets/text.txt");
+        FilePathList files = LoadDirectoryFilesFromPhysFS("assets");
+        PhysFSMemoryStats loaded = GetPhysFSMemoryStats();
+#ifdef RAYLIB_PHYSFS_TRACK_MEMORY
+        AssertEqual(loaded.buffers, before.buffers + 3);
+        Assert(loaded.bytes > before.bytes + 14 + 15);
+        Assert(loaded.peakBytes >= loaded.bytes);
+        AssertEqual(loaded.totalBuffers, before.totalBuffers + 4);
+#else
+        AssertEqual(loaded.buffers, 0);
+#endif
+
+        // UnloadFileDataFromPhysFS()
+        UnloadFileDataFromPhysFS(data);
+        UnloadFileTextFromPhysFS(text);
+        UnloadDirectoryFilesFromPhysFS(files);
+        PhysFSMemoryStats unloaded = GetPhysFSMemoryStats();
+        AssertEqual(unloaded.buffers, before.buffers);
+        AssertEqual(unloaded.bytes, before.bytes);
+    }
+
+    // SetPhysFSIndexing()
+    {
+        long modTime = GetFileModTimeFromPhysFS("assets/text.txt");
+        SetPhysFSIndexing(true);
+        Assert(FileExistsInPhysFS("assets/text.txt"));
+        Assert(FileExistsInPhysFS("/assets/text.txt"));
+        AssertNot(FileExistsInPhysFS("assets/missing.txt"));
+        AssertNot(FileExistsInPhysFS("assets"));
+        Assert(DirectoryExistsInPhysFS("assets"));
+        AssertNot(DirectoryExistsInPhysFS("assets/text.txt"));
+        AssertEqual(GetFileModTimeFromPhysFS("assets/text.txt"), modTime);
+
+        // Mounting and unmounting updates the index.
+        Assert(MountPhysFS("resources/archive.zip", "indexed/archive"));
+        Assert(DirectoryExistsInPhysFS("indexed"));
+        Assert(FileExistsInPhysFS("indexed/archive/stored.txt"));
+        int bytesRead = 0;
+        unsigned char* data = LoadFileDataFromPhysFS("indexed/archive/stored.txt", &bytesRead);
+        AssertEqual(bytesRead, 13);
+        UnloadFileDataFromPhysFS(data);
+        Assert(UnmountPhysFS("resources/archive.zip"));
+        AssertNot(FileExistsInPhysFS("indexed/archive/stored.txt"));
+        AssertNot(DirectoryExistsInPhysFS("indexed"));
+        Assert(FileExistsInPhysFS("assets/text.txt"));
+
+        // Saved files are indexed where the write directory is mounted.
+        Assert(MountPhysFS(GetWorkingDirectory(), "written"));
+        AssertNot(FileExistsInPhysFS("written/indexed.txt"));
+        Assert(SaveFileDataToPhysFS("indexed.txt", "Index", 5));
+        Assert(FileExistsInPhysFS("written/indexed.txt"));
+        Assert(UnmountPhysFS(GetWorkingDirectory()));
+        SetPhysFSIndexing(false);
+        PHYSFS_delete("indexed.txt");
+    }
+
+    // SetPhysFSIndexSnapshotDirectory()
+    {
+        // Snapshots are taken when indexing starts with nothing mounted.
+        Assert(ExportPhysFSPack("assets", "snapshot-changed.zip"));
+        Assert(UnmountPhysFS("resources"));
+        int archiveSize = 0;
+        unsigned char* archive = LoadFileData("resources/archive.zip", &archiveSize);
+        Assert(SaveFileData("snapshot.zip", archive, archiveSize));
+        UnloadFileData(archive);
+        SetPhysFSIndexSnapshotDirectory(GetWorkingDirectory());
+        SetPhysFSIndexing(true);
+        Assert(MountPhysFS("snapshot.zip", "snapshot"));
+        Assert(DirectoryExistsInPhysFS("snapshot"));
+        Assert(FileExistsInPhysFS("snapshot/stored.txt"));
+        AssertNot(FileExistsInPhysFS("snapshot/missing.txt"));
+        Assert(UnmountPhysFS("snapshot.zip"));
+        AssertNot(FileExistsInPhysFS("snapshot/stored.txt"));
+
+        // Mounting again after the unmount is snapshotted too.
+        Assert(MountPhysFS("snapshot.zip", "snapshot"));
+        Assert(FileExistsInPhysFS("snapshot/stored.txt"));
+        Assert(UnmountPhysFS("snapshot.zip"));
+        SetPhysFSIndexing(false);
+
+        // Rename a path in the saved snapshot, so that mounting again shows whether it was read.
+        bool saved = false;
+        FilePathList files = LoadDirectoryFiles(GetWorkingDirectory());
+        for (unsigned int i = 0; i < files.count; i++) {
+            if (!IsFileExtension(files.paths[i], ".rpidx")) {
+                continue;
+            }
+            int size = 0;
+            unsigned char* data = LoadFileData(files.paths[i], &size);
+            for (int j = 0; j + 11 <= size; j++) {
+                if (TextIsEqual((const char*)data + j, "stored.txt")) {
+                    data[j + 9] = 'u';
+                    saved = true;
+                }
+            }
+            Assert(SaveFileData(files.paths[i], data, size));
+            UnloadFileData(data);
+        }
+        UnloadDirectoryFiles(files);
+        Assert(saved);
+
+        SetPhysFSIndexing(true);
+        Assert(MountPhysFS("snapshot.zip", "snapshot"));
+        Assert(FileExistsInPhysFS("snapshot/stored.txu"));
+        AssertNot(FileExistsInPhysFS("snapshot/stored.txt"));
+        Assert(UnmountPhysFS("snapshot.zip"));
+        Assert(MountPhysFS("snapshot.zip", "snapshot"));
+        Assert(FileExistsInPhysFS("snapshot/stored.txu"));
+        Assert(UnmountPhysFS("snapshot.zip"));
+        SetPhysFSIndexing(false);
+
+        // Changing the archive's size or modification time makes it indexed again.
+        int changedSize = 0;
+        unsigned char* changed = LoadFileData("snapshot-changed.zip", &changedSize);
+        AssertNotEqual(changedSize, archiveSize);
+        Assert(SaveFileData("snapshot.zip", changed, changedSize));
+        UnloadFileData(changed);
+        SetPhysFSIndexing(true);
+        Assert(MountPhysFS("snapshot.zip", "snapshot"));
+        Assert(FileExistsInPhysFS("snapshot/text.txt"));
+        AssertNot(FileExistsInPhysFS("snapshot/stored.txu"));
+        Assert(UnmountPhysFS("snapshot.zip"));
+        SetPhysFSIndexing(false);
+
+        files = LoadDirectoryFiles(GetWorkingDirectory());
+        for (unsigned int i = 0; i < files.count; i++) {
+            if (IsFileExtension(files.paths[i], ".rpidx")) {
+                remove(files.paths[i]);
+            }
+        }
+        UnloadDirectoryFiles(files);
+        remove("snapshot.zip");
+        remove("snapshot-changed.zip");
+        SetPhysFSIndexSnapshotDirectory(0);
+        Assert(MountPhysFS("resources", "assets"));
+    }
+
+    // SetPhysFSIORecording()
+    {
+        SetPhysFSIORecording(true);
+        int bytesRead = 0;
+        UnloadFileDataFromPhysFS(LoadFileDataFromPhysFS("assets/text.txt", &bytesRead));
+        UnloadFileDataFromPhysFS(LoadFileDataFromPhysFS("/assets/text.txt", &bytesRead));
+        AssertEqual(LoadFileDataFromPhysFS("assets/missing.txt", &bytesRead), 0);
+        SetPhysFSIORecording(false);
+        UnloadFileDataFromPhysFS(LoadFileDataFromPhysFS("assets/sound.wav", &bytesRead));
+
+        // ExportPhysFSIORecording()
+        Assert(ExportPhysFSIORecording("io-recording.rpio"));
+
+        // LoadPhysFSIORecording()
+        Assert(MountPhysFS(GetWorkingDirectory(), "recordings"));
+        PhysFSIORecording recording = LoadPhysFSIORecording("recordings/io-recording.rpio");
+        AssertEqual(recording.pathCount, 2);
+        AssertEqual(recording.requestCount, 3);
+        Assert(TextIsEqual(recording.paths[0], "assets/text.txt"));
+        AssertEqual(recording.requests[1].path, 0);
+        AssertEqual(recording.requests[1].size, 14);
+        AssertEqual(recording.requests[1].api, PHYSFS_STATS_LOAD_FILE_DATA);
+        Assert(recording.requests[1].time >= recording.requests[0].time);
+        Assert(recording.requests[2].failed);
+        UnloadPhysFSIORecording(recording);
+
+        // Truncated recordings don't load, even partway through a path.
+        int size = 0;
+        unsigned char* data = LoadFileData("io-recording.rpio", &size);
+        Assert(SaveFileDataToPhysFS("io-truncated.rpio", data, 16 + 2 + 5));
+        UnloadFileData(data);
+        recording = LoadPhysFSIORecording("recordings/io-truncated.rpio");
+        AssertEqual(recording.pathCount, 0);
+        AssertEqual(recording.paths, 0);
+        UnloadPhysFSIORecording(recording);
+        Assert(UnmountPhysFS(GetWorkingDirectory()));
+        PHYSFS_delete("io-recording.rpio");
+        PHYSFS_delete("io-truncated.rpio");
+    }
+
+    // GetPhysFSStats()
+    {
+        ResetPhysFSStats();
+        int bytesRead = 0;
+        UnloadFileDataFromPhysFS(LoadFileDataFromPhysFS("assets/text.txt", &bytesRead));
+        AssertEqual(LoadFileDataFromPhysFS("assets/missing.txt", &bytesRead), 0);
+        Assert(SaveFileDataToPhysFS("stats.txt", "Stats", 5));
+        UnloadWave(LoadWaveFromPhysFS("assets/sound.wav"));
+
+        PhysFSStats stats = GetPhysFSStats();
+#ifdef RAYLIB_PHYSFS_STATS
+        PhysFSStatsCounters* loads = &stats.apis[PHYSFS_STATS_LOAD_FILE_DATA];
+        AssertEqual(loads->calls, 3);
+        AssertEqual(loads->failures, 1);
+        AssertEqual(stats.apis[PHYSFS_STATS_SAVE_FILE_DATA].bytesWritten, 5);
+        AssertEqual(stats.apis[PHYSFS_STATS_LOAD_WAVE].calls, 1);
+        AssertEqual(stats.apis[PHYSFS_STATS_LOAD_WAVE].bytesRead, loads->bytesRead - 14);
+
+        // Without indexing, only the save counts against a mount.
+        AssertEqual(stats.mountCount, 1);
+        AssertEqual(stats.mounts[0].counters.bytesWritten, 5);
+        AssertEqual(stats.slowestCount, 5);
+        for (int i = 1; i < stats.slowestCount; i++) {
+            Assert(stats.slowest[i - 1].milliseconds >= stats.slowest[i].milliseconds);
+        }
+
+        // Existence checks, text and directory listings are counted too.
+        ResetPhysFSStats();
+        Assert(FileExistsInPhysFS("assets/text.txt"));
+        UnloadFileTextFromPhysFS(LoadFileTextFromPhysFS("assets/text.txt"));
+        UnloadDirectoryFilesFromPhysFS(LoadDirectoryFilesFromPhysFS("assets"));
+        stats = GetPhysFSStats();
+        AssertEqual(stats.apis[PHYSFS_STATS_FILE_EXISTS].calls, 1);
+        AssertEqual(stats.apis[PHYSFS_STATS_LOAD_FILE_TEXT].bytesRead, 14);
+        AssertEqual(stats.apis[PHYSFS_STATS_LOAD_DIRECTORY_FILES].calls, 1);
+        AssertEqual(stats.apis[PHYSFS_STATS_LOAD_FILE_DATA].calls, 1);
+
+        // Reads count against the mount the index resolves them to.
+        SetPhysFSIndexing(true);
+        ResetPhysFSStats();
+        UnloadFileDataFromPhysFS(LoadFileDataFromPhysFS("assets/text.txt", &bytesRead));
+        stats = GetPhysFSStats();
+        AssertEqual(stats.mountCount, 1);
+        Assert(TextIsEqual(stats.mounts[0].mount, "resources"));
+        AssertEqual(stats.mounts[0].counters.bytesRead, 14);
+        SetPhysFSIndexing(false);
+
+        // ResetPhysFSStats()
+        ResetPhysFSStats();
+        AssertEqual(GetPhysFSStats().apis[PHYSFS_STATS_LOAD_FILE_DATA].calls, 0);
+#else
+        AssertEqual(stats.apis[PHYSFS_STATS_LOAD_FILE_DATA].calls, 0);
+#endif
+        PHYSFS_delete("stats.txt");
+    }
+
+    // ExportPhysFSTrace()
+    {
+        ClearPhysFSTrace();
+        UnloadWave(LoadWaveFromPhysFS("assets/sound.wav"));
+#ifdef RAYLIB_PHYSFS_TRACE
+        // Long paths are cut before a character that doesn't fit, rather than part way through it.
+        char longPath[129];
+        for (int i = 0; i < 126; i++) {
+            longPath[i] = 'a';
+        }
+        longPath[126] = (char)0xC3;
+        longPath[127] = (char)0xA9;
+        longPath[128] = '\0';
+        int bytesRead = 0;
+        AssertEqual(LoadFileDataFromPhysFS(longPath, &bytesRead), 0);
+
+        Assert(ExportPhysFSTrace("trace.json"));
+        char* trace = LoadFileText("trace.json");
+        AssertNotEqual(trace, 0);
+        Assert(TextFindIndex(trace, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+        AssertNotEqual(TextFindIndex(trace, "\"name\":\"LoadWaveFromPhysFS\""), -1);
+        AssertNotEqual(TextFindIndex(trace, "\"name\":\"LoadFileDataFromPhysFS\""), -1);
+        AssertNotEqual(TextFindIndex(trace, "\"path\":\"assets/sound.wav\""), -1);
+        AssertNotEqual(TextFindIndex(trace, "\"name\":\"decode\""), -1);
+        AssertEqual(TextFindIndex(trace, "text.txt"), -1);
+        AssertNotEqual(TextFindIndex(trace, TextFormat("\"path\":\"%.126s\"", longPath)), -1);
+        UnloadFileText(trace);
+        PHYSFS_delete("trace.json");
+#else
+        AssertNot(ExportPhysFSTrace("trace.json"));
+#endif
+    }
+
+    // SetPhysFSCacheSize()
+    {
+        SetPhysFSCacheSize(1024);
+        int bytesRead = 0;
+        unsigned char* fileData = LoadFileDataFromPhysFS("assets/text.txt", &bytesRead);
+        UnloadFileDataFromPhysFS(fileData);
+        fileData = LoadFileDataFromPhysFS("assets/text.txt", &bytesRead);
+        AssertNotEqual(fileData, 0);
+        AssertEqual(bytesRead, 14);
+        UnloadFileDataFromPhysFS(fileData);
+
+        PhysFSCacheStats stats = GetPhysFSCacheStats();
+        AssertEqual(stats.hits, 1);
+        AssertEqual(stats.misses, 1);
+        AssertEqual(stats.count, 1);
+        AssertEqual(stats.size, 14);
+
+        // Views read the cached data, and keep it alive after it is evicted.
+        FileView view = MapFileViewFromPhysFS("assets/text.txt");
+        AssertNotEqual(view.cacheEntry, 0);
+        ClearPhysFSCache();
+        AssertEqual(GetPhysFSCacheStats().count, 0);
+        AssertEqual(view.data[0], 'H');
+        UnmapFileView(view);
+
+        // Saving a file drops it from the cache.
+        char* fileText = LoadFileTextFromPhysFS("assets/SaveFileTextToPhysFS.txt");
+        UnloadFileTextFromPhysFS(fileText);
+        Assert(SaveFileTextToPhysFS("resources/SaveFileTextToPhysFS.txt", "Hello Cache"));
+        fileText = LoadFileTextFromPhysFS("assets/SaveFileTextToPhysFS.txt");
+        Assert(TextIsEqual(fileText, "Hello Cache"));
+        UnloadFileTextFromPhysFS(fileText);
+        PHYSFS_delete("resources/SaveFileTextToPhysFS.txt");
+
+        SetPhysFSCacheSize(0);
+        AssertEqual(GetPhysFSCacheStats().size, 0);
+    }
+
     // LoadDirectoryFilesFromPhysFS()
     {
         FilePathList files = LoadDirectoryFilesFromPhysFS("assets");
         bool textFileFound = false;
         Assert(files.count > 4);
         TraceLog(LOG_INFO, "LoadDirectoryFilesFromPhysFS: Files in assets: %i", files.count);
-        for (int i = 0; i < files.count; i++) {
+        for (unsigned int i = 0; i < files.count; i++) {
             if (TextIsEqual(GetFileName(files.paths[i]), "text.txt")) {
                 textFileFound = true;
             }
         }
-        UnloadDirectoryFiles(files);
+        UnloadDirectoryFilesFromPhysFS(files);
         Assert(textFileFound, "LoadDirectoryFilesFromPhysFS() could not find text.txt");
     }
 
+    // LoadDirectoryFilesFromPhysFSEx()
+    {
+        Assert(MountPhysFS("resources/archive.zip", "assets/nested/archive"));
+        for (int indexing = 0; indexing < 2; indexing++) {
+            SetPhysFSIndexing(indexing == 1);
+            PhysFSFileInfoList files = LoadDirectoryFilesFromPhysFSEx("assets", ".TXT", true);
+            bool textFileFound = false;
+            bool nestedFileFound = false;
+            for (unsigned int i = 0; i < files.count; i++) {
+                AssertNot(files.files[i].isDirectory);
+                Assert(IsFileExtension(files.files[i].path, ".txt"));
+                if (TextIsEqual(files.files[i].path, "assets/text.txt")) {
+                    textFileFound = true;
+                    AssertEqual(files.files[i].size, GetFileLength("resources/text.txt"));
+                    AssertEqual(files.files[i].modTime, GetFileModTimeFromPhysFS("assets/text.txt"));
+                }
+                if (TextIsEqual(files.files[i].path, "assets/nested/archive/stored.txt")) {
+                    nestedFileFound = true;
+                    AssertEqual(files.files[i].size, 13);
+                }
+                if (i > 0) {
+                    Assert(strcmp(files.files[i - 1].path, files.files[i].path) < 0);
+                }
+            }
+            UnloadDirectoryFilesFromPhysFSEx(files);
+            Assert(textFileFound);
+            Assert(nestedFileFound);
+
+            // Patterns match paths within the directory, and "DIR" matches directories.
+            files = LoadDirectoryFilesFromPhysFSEx("/assets/nested/", "archive/s*.txt;DIR", true);
+            AssertEqual(files.count, 2);
+            if (files.count == 2) {
+                Assert(TextIsEqual(files.files[0].path, "assets/nested/archive"));
+                Assert(files.files[0].isDirectory);
+                Assert(TextIsEqual(files.files[1].path, "assets/nested/archive/stored.txt"));
+            }
+            UnloadDirectoryFilesFromPhysFSEx(files);
+
+            // Without recursion, only the directory itself is listed.
+            files = LoadDirectoryFilesFromPhysFSEx("assets/nested", 0, false);
+            AssertEqual(files.count, 1);
+            UnloadDirectoryFilesFromPhysFSEx(files);
+
+            files = LoadDirectoryFilesFromPhysFSEx("assets/missing", 0, true);
+            AssertEqual(files.count, 0);
+            AssertEqual(files.files, 0);
+        }
+        SetPhysFSIndexing(false);
+        Assert(UnmountPhysFS("resources/archive.zip"));
+    }
+
     // LoadFileTextFromPhysFS()
     {
         char* fileText = LoadFileTextFromPhysFS("assets/text.txt");
         AssertNotEqual(fileText, 0);
         Assert(TextIsEqual(TextSubtext(fileText, 7, 5), "World")); // Hello, World!
-        UnloadFileText(fileText);
+        UnloadFileTextFromPhysFS(fileText);
 
         char* missingText = LoadFileTextFromPhysFS("MissingText.txt");
         AssertEqual(missingText, 0);
@@ -105,6 +1165,63 @@ int main(int argc, char *argv[]) {
         AssertEqual(missingImage.data, 0);
     }
 
+    // LoadImagesFromPhysFS()
+    {
+        const char* fileNames[] = { "assets/image.png", "MissingFile.png", "assets/image.png" };
+        Image images[3];
+        AssertEqual(LoadImagesFromPhysFS(fileNames, 3, images), 2);
+        AssertImage(images[0]);
+        AssertEqual(images[1].data, 0);
+        AssertImage(images[2]);
+
+        Image loadedImage = LoadImage("resources/image.png");
+        AssertImageSame(images[0], loadedImage);
+        AssertImageSame(images[2], loadedImage);
+        UnloadImage(loadedImage);
+        UnloadImage(images[0]);
+        UnloadImage(images[2]);
+    }
+
+    // ExportImageToPhysFS()
+    {
+        Image image = LoadImageFromPhysFS("assets/image.png");
+        Assert(ExportImageToPhysFS(image, "resources/ExportImageToPhysFS.rimg"));
+        Image raw = LoadImageFromPhysFS("assets/ExportImageToPhysFS.rimg");
+        AssertImage(raw);
+        AssertImageSame(image, raw);
+        UnloadImage(raw);
+
+        // LoadPhysFSImageMap()
+        Assert(SaveFileTextToPhysFS("resources/LoadPhysFSImageMap.txt", "MissingFile.png ExportImageToPhysFS.rimg\n"));
+        Assert(LoadPhysFSImageMap("assets/LoadPhysFSImageMap.txt"));
+        Image mapped = LoadImageFromPhysFS("assets/MissingFile.png");
+        AssertImageSame(image, mapped);
+        UnloadImage(mapped);
+        UnloadPhysFSImageMap();
+
+        // Maps that lead back to an image load it without following the map again.
+        Assert(SaveFileTextToPhysFS("resources/LoadPhysFSImageMap.txt", "image.png ExportImageToPhysFS.rimg\nExportImageToPhysFS.rimg image.png\n"));
+        Assert(LoadPhysFSImageMap("assets/LoadPhysFSImageMap.txt"));
+        mapped = LoadImageFromPhysFS("assets/image.png");
+        AssertImageSame(image, mapped);
+        UnloadImage(mapped);
+        mapped = LoadImageFromPhysFS("assets/ExportImageToPhysFS.rimg");
+        AssertImageSame(image, mapped);
+        UnloadImage(mapped);
+        UnloadPhysFSImageMap();
+        Assert(SaveFileTextToPhysFS("resources/LoadPhysFSImageMap.txt", "image.png image.png\n"));
+        Assert(LoadPhysFSImageMap("assets/LoadPhysFSImageMap.txt"));
+        mapped = LoadImageFromPhysFS("assets/image.png");
+        AssertImageSame(image, mapped);
+        UnloadImage(mapped);
+        UnloadPhysFSImageMap();
+        AssertEqual(LoadImageFromPhysFS("assets/MissingFile.png").data, 0);
+        AssertNot(LoadPhysFSImageMap("MissingFile.txt"));
+        UnloadImage(image);
+        PHYSFS_delete("resources/ExportImageToPhysFS.rimg");
+        PHYSFS_delete("resources/LoadPhysFSImageMap.txt");
+    }
+
     // LoadWaveFromPhysFS()
     {
         Wave wave = LoadWaveFromPhysFS("assets/sound.wav");
@@ -115,6 +1232,202 @@ int main(int argc, char *argv[]) {
         AssertEqual(missingWave.data, 0);
     }
 
+    // AcquireWaveFromPhysFS()
+    {
+        int wave = AcquireWaveFromPhysFS("assets/sound.wav");
+        AssertNotEqual(wave, 0);
+        AssertEqual(AcquireWaveFromPhysFS("/assets/sound.wav"), wave);
+        AssertNotEqual(GetPhysFSWave(wave).data, 0);
+
+        // The wave stays loaded until its last handle is released.
+        ReleasePhysFSWave(wave);
+        AssertNotEqual(GetPhysFSWave(wave).data, 0);
+        ReleasePhysFSWave(wave);
+        AssertEqual(GetPhysFSWave(wave).data, 0);
+
+        // Stale handles don't reach the slot's next wave.
+        int reloaded = AcquireWaveFromPhysFS("assets/sound.wav");
+        AssertNotEqual(reloaded, wave);
+        AssertEqual(GetPhysFSWave(wave).data, 0);
+        ReleasePhysFSWave(reloaded);
+
+        AssertEqual(AcquireWaveFromPhysFS("MissingFile.wav"), 0);
+    }
+
+    // AcquireTextureFromPhysFS(), AcquireFontFromPhysFS(), AcquireShaderFromPhysFS()
+    {
+        AssertEqual(AcquireTextureFromPhysFS("MissingFile.png"), 0);
+        AssertEqual(AcquireFontFromPhysFS("MissingFile.ttf", 20), 0);
+        AssertEqual(AcquireShaderFromPhysFS("MissingFile.vs", "MissingFile.fs"), 0);
+        AssertEqual(GetPhysFSTexture(12345).id, 0);
+        AssertEqual(GetPhysFSFont(12345).glyphs, 0);
+        AssertEqual(GetPhysFSShader(12345).id, 0);
+        ReleasePhysFSTexture(12345);
+        ReleasePhysFSFont(12345);
+        ReleasePhysFSShader(12345);
+
+        // Loading textures needs a graphics context, which headless runs don't have.
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        InitWindow(64, 64, "raylib-physfs-test");
+        if (IsWindowReady()) {
+            int texture = AcquireTextureFromPhysFS("assets/image.png");
+            AssertNotEqual(texture, 0);
+            AssertEqual(AcquireTextureFromPhysFS("/assets/image.png"), texture);
+            AssertNotEqual(GetPhysFSTexture(texture).id, 0);
+
+            // The texture stays loaded until its last handle is released.
+            ReleasePhysFSTexture(texture);
+            AssertNotEqual(GetPhysFSTexture(texture).id, 0);
+            ReleasePhysFSTexture(texture);
+            AssertEqual(GetPhysFSTexture(texture).id, 0);
+
+            int reloaded = AcquireTextureFromPhysFS("assets/image.png");
+            AssertNotEqual(reloaded, texture);
+            ReleasePhysFSTexture(reloaded);
+            CloseWindow();
+        } else {
+            TraceLog(LOG_INFO, "TEST: Skipped the texture handle tests without a window");
+        }
+    }
+
+    // LoadPhysFSAssetGroup()
+    {
+        // Loading a preloaded group moves its assets that are still queued ahead of other jobs.
+        Assert(MountPhysFSFromMemory((const unsigned char*)"jobs", 4, "jobs.testjobs", "jobs"));
+        int blockers[RAYLIB_PHYSFS_WORKER_COUNT];
+        HoldTestWorkers(blockers);
+        int watcher = LoadFileDataFromPhysFSAsync("jobs/a", 0);
+        AssertNotEqual(watcher, 0);
+        Assert(PreloadPhysFSAssetGroup("jobs/manifest.txt", "jobs"));
+        PhysFSThread releaser;
+        Assert(CreatePhysFSThread(releaser, ReleaseTestJobLater, 0));
+        Assert(LoadPhysFSAssetGroup("jobs/manifest.txt", "jobs"));
+        JoinPhysFSThread(releaser);
+        FreeTestWorkers(blockers);
+        int bytesRead = 0;
+        UnloadFileDataFromPhysFS(WaitPhysFSJob(watcher, &bytesRead));
+        Assert(TextIsEqual(testJobOrder, "sa"));
+        UnloadPhysFSAssetGroup("jobs");
+        Assert(UnmountPhysFS("jobs.testjobs"));
+
+        Assert(PreloadPhysFSAssetGroup("assets/manifest.txt", "sounds"));
+        Assert(LoadPhysFSAssetGroup("assets/manifest.txt", "sounds"));
+
+        // The group's wave is shared through the registry.
+        int wave = AcquireWaveFromPhysFS("assets/sound.wav");
+        AssertNotEqual(wave, 0);
+        ReleasePhysFSWave(wave);
+        AssertNotEqual(GetPhysFSWave(wave).data, 0);
+        UnloadPhysFSAssetGroup("sounds");
+        AssertEqual(GetPhysFSWave(wave).data, 0);
+
+        AssertNot(LoadPhysFSAssetGroup("assets/manifest.txt", "missing"));
+        UnloadPhysFSAssetGroup("missing");
+        AssertNot(LoadPhysFSAssetGroup("assets/manifest.txt", "MissingGroup"));
+        AssertNot(LoadPhysFSAssetGroup("MissingFile.txt", "sounds"));
+    }
+
+    // UpdatePhysFSLoader()
+    {
+        Assert(QueuePhysFSAsset("loading", "wave assets/sound.wav"));
+        Assert(QueuePhysFSAsset("loading", "wave assets/MissingFile.wav"));
+        AssertNot(QueuePhysFSAsset("loading", "model assets/sound.wav"));
+        AssertEqual(GetPhysFSLoaderProgress().assetCount, 2);
+        while (!UpdatePhysFSLoader(1.0f)) {
+            WaitTime(0.001);
+        }
+
+        PhysFSLoaderProgress progress = GetPhysFSLoaderProgress();
+        AssertEqual(progress.loadedCount, 1);
+        AssertEqual(progress.failedCount, 1);
+        AssertEqual(progress.bytesLoaded, GetFileLength("resources/sound.wav"));
+        UnloadPhysFSAssetGroup("loading");
+        AssertEqual(GetPhysFSLoaderProgress().assetCount, 0);
+        Assert(UpdatePhysFSLoader(1.0f));
+    }
+
+    // LoadMusicStreamFromPhysFS()
+    {
+        Music missingMusic = LoadMusicStreamFromPhysFS("MissingFile.mp3");
+        AssertEqual(missingMusic.ctxData, 0);
+        UnloadMusicStreamFromPhysFS(missingMusic);
+
+        // Music decodes from a view of its file, mapped when it's stored as it is, and copied when it's compressed.
+        // Half a second of silence compresses well, so that it's compressed in the archive that's allowed to.
+        static unsigned char soundData[44 + 44100] = {
+            'R', 'I', 'F', 'F', 0x68, 0xAC, 0x00, 0x00, 'W', 'A', 'V', 'E',
+            'f', 'm', 't', ' ', 16, 0, 0, 0, 1, 0, 1, 0, 0x44, 0xAC, 0x00, 0x00, 0x88, 0x58, 0x01, 0x00, 2, 0, 16, 0,
+            'd', 'a', 't', 'a', 0x44, 0xAC, 0x00, 0x00
+        };
+        Assert(PHYSFS_mkdir("music-tree"));
+        Assert(SaveFileDataToPhysFS("music-tree/silence.wav", soundData, sizeof(soundData)));
+        Assert(MountPhysFS("music-tree", "music/source"));
+        Assert(ExportPhysFSPackEx("music/source", "music-stored.zip", ".wav"));
+        Assert(ExportPhysFSPack("music/source", "music-deflated.zip"));
+        Assert(UnmountPhysFS("music-tree"));
+        Assert(MountPhysFS("music-stored.zip", "music/stored"));
+        Assert(MountPhysFS("music-deflated.zip", "music/deflated"));
+        const char* musicFiles[2] = { "music/stored/silence.wav", "music/deflated/silence.wav" };
+        for (int i = 0; i < 2; i++) {
+            Music music = LoadMusicStreamFromPhysFS(musicFiles[i]);
+            AssertNotEqual(music.ctxData, 0);
+            AssertEqual(music.frameCount, 22050);
+            FileView view = MapFileViewFromPhysFS(musicFiles[i]);
+            AssertEqual(view.size, (int)sizeof(soundData));
+            for (int j = 0; j < view.size; j++) {
+                AssertEqual(view.data[j], soundData[j]);
+            }
+#ifdef RAYLIB_PHYSFS_MMAP
+            if (i == 0) {
+                AssertNotEqual(view.mapping, 0);
+            } else {
+                AssertEqual(view.mapping, 0);
+            }
+#endif
+            UnmapFileView(view);
+
+            // Unloading twice only unloads the music once.
+            UnloadMusicStreamFromPhysFS(music);
+            UnloadMusicStreamFromPhysFS(music);
+        }
+        Assert(UnmountPhysFS("music-stored.zip"));
+        Assert(UnmountPhysFS("music-deflated.zip"));
+        PHYSFS_delete("music-tree/silence.wav");
+        PHYSFS_delete("music-tree");
+        PHYSFS_delete("music-stored.zip");
+        PHYSFS_delete("music-deflated.zip");
+
+        // SetPhysFSMusicThread()
+        InitAudioDevice();
+        Music music = LoadMusicStreamFromPhysFS("assets/sound.wav");
+        AssertNotEqual(music.ctxData, 0);
+        PlayMusicStream(music);
+        Assert(SetPhysFSMusicThread(true));
+        Assert(SetPhysFSMusicThread(true));
+        UpdateMusicStreamFromPhysFS(missingMusic);
+
+        // The thread updates its own copy of the music, which takes the looping setting from the update.
+        music.looping = false;
+        UpdateMusicStreamFromPhysFS(music);
+        if (IsAudioDeviceReady()) {
+            // With nothing else updating it, the music only stops at its end when the thread updates it.
+            for (int i = 0; i < 5000 && IsMusicStreamPlaying(music); i++) {
+                WaitTime(0.001);
+            }
+            AssertNot(IsMusicStreamPlaying(music));
+        } else {
+            TraceLog(LOG_INFO, "TEST: Skipped playing music through the music thread without an audio device");
+        }
+        SeekMusicStreamFromPhysFS(music, 0.1f);
+        StopMusicStreamFromPhysFS(music);
+
+        // Music can be unloaded while the thread is running.
+        UnloadMusicStreamFromPhysFS(music);
+        Assert(SetPhysFSMusicThread(false));
+        Assert(SetPhysFSMusicThread(false));
+        CloseAudioDevice();
+    }
+
     // LoadShaderFromPhysFS()
     {
         Shader missingShader = LoadShaderFromPhysFS("MissingFile.txt", "MissingFile.txt");
@@ -129,19 +1442,61 @@ int main(int argc, char *argv[]) {
     Assert(SetPhysFSWriteDirectory("resources"));
     AssertNot(SetPhysFSWriteDirectory("MissingDirectory"));
 
+    // Views of cached files can be unmapped after closing.
+    SetPhysFSCacheSize(1024);
+    int cachedSize = 0;
+    UnloadFileDataFromPhysFS(LoadFileDataFromPhysFS("assets/text.txt", &cachedSize));
+    FileView cachedView = MapFileViewFromPhysFS("assets/text.txt");
+    AssertNotEqual(cachedView.cacheEntry, 0);
+
     // UnmountPhysFS()
     Assert(UnmountPhysFS("resources"));
     AssertNot(UnmountPhysFS("MissingDirectory"));
 
     // SetPhysFSCallbacks()
     SetPhysFSCallbacks();
+    {
+        // raylib frees what it loads through the callbacks itself.
+        Assert(MountPhysFS("resources", "assets"));
+        int bytesRead = 0;
+        unsigned char* fileData = LoadFileData("assets/text.txt", &bytesRead);
+        Assert(fileData);
+        Assert(bytesRead > 0);
+        char* text = LoadFileText("assets/text.txt");
+        Assert(text);
+        AssertEqual((int)TextLength(text), bytesRead);
+        UnloadFileText(text);
+        UnloadFileData(fileData);
+        Assert(UnmountPhysFS("resources"));
+    }
 
     // GetPerfDirectory
     const char* perfDir = GetPerfDirectory("RobLoach", "raylib-physfs-test");
     AssertNotEqual(perfDir, 0);
 
+#ifdef RAYLIB_PHYSFS_TRACK_MEMORY
+    // Everything loaded from PhysFS was unloaded through PhysFS.
+    AssertEqual(GetPhysFSMemoryStats().buffers, 0);
+#endif
+
     // ClosePhysFS()
-    Assert(ClosePhysFS());
+    {
+        // Music that's still loaded is unloaded by ClosePhysFS(), along with the music thread.
+        Assert(MountPhysFS("resources", "assets"));
+        Music music = LoadMusicStreamFromPhysFS("assets/sound.wav");
+        AssertNotEqual(music.ctxData, 0);
+        Assert(SetPhysFSMusicThread(true));
+        Assert(ClosePhysFS());
+        UnloadMusicStreamFromPhysFS(music);
+        StopMusicStreamFromPhysFS(music);
+        UpdateMusicStreamFromPhysFS(music);
+    }
+
+    // UnmapFileView()
+    UnmapFileView(cachedView);
+
+    DestroyPhysFSCondition(testJobCondition);
+    DestroyPhysFSMutex(testJobMutex);
 
     TraceLog(LOG_INFO, "================================");
     TraceLog(LOG_INFO, "raylib-physfs-test succesful");
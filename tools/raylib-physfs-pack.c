@@ -0,0 +1,93 @@
+/*******************************************************************************************
+*
+*   raylib-physfs-pack - Packs a directory into a ZIP archive or a .rpak pack
+*
+*   Files are compressed across the worker threads, and written sorted by path with fixed
+*   timestamps, so that packing the same files always gives the same archive. Archives ending
+*   with .zip are ZIP archives, others are packs that mount with the pack archiver. Given an
+*   access order saved with ExportPhysFSAccessOrder(), the files it names are laid out first, in
+*   the order they were loaded.
+*
+*   Usage: raylib-physfs-pack <input> <output> [--store-media] [--store <extensions>] [--order <file>]
+*
+*   This tool has been created using raylib-physfs 0.0.2 (https://github.com/RobLoach/raylib-physfs)
+*   raylib-physfs is licensed under an unmodified zlib/libpng license (View raylib-physfs.h for details)
+*
+*   Copyright (c) 2021 Rob Loach (@RobLoach)
+*
+********************************************************************************************/
+
+#include <stdio.h>
+
+#include "raylib.h"
+
+// Compress on more cores than a game would load on.
+#ifndef RAYLIB_PHYSFS_WORKER_COUNT
+#define RAYLIB_PHYSFS_WORKER_COUNT 16
+#endif
+
+#define RAYLIB_PHYSFS_IMPLEMENTATION
+#include "raylib-physfs.h"
+
+// Formats that are already compressed, and gain little from another pass.
+#define MEDIA_EXTENSIONS ".ogg;.mp3;.flac;.qoa;.png;.jpg;.jpeg;.qoi;.zip;.rpak"
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Usage: raylib-physfs-pack <input> <output> [--store-media] [--store <extensions>] [--order <file>]\n");
+        printf("\n");
+        printf("  <input>               The directory or archive to pack\n");
+        printf("  <output>              The archive to write, either a .zip or a .rpak\n");
+        printf("  --store-media         Store already compressed media (%s) uncompressed\n", MEDIA_EXTENSIONS);
+        printf("  --store <extensions>  Store files with the given extensions, like \".ogg;.png\", uncompressed\n");
+        printf("  --order <file>        Lay files out in the access order saved by ExportPhysFSAccessOrder()\n");
+        return 1;
+    }
+
+    const char* storedExtensions = 0;
+    char* accessOrder = 0;
+    for (int i = 3; i < argc; i++) {
+        if (TextIsEqual(argv[i], "--store-media")) {
+            storedExtensions = MEDIA_EXTENSIONS;
+        } else if (TextIsEqual(argv[i], "--store") && i + 1 < argc) {
+            storedExtensions = argv[++i];
+        } else if (TextIsEqual(argv[i], "--order") && i + 1 < argc && accessOrder == 0) {
+            accessOrder = LoadFileText(argv[++i]);
+            if (accessOrder == 0) {
+                printf("Failed to load access order: %s\n", argv[i]);
+                return 1;
+            }
+        } else {
+            printf("Unknown option: %s\n", argv[i]);
+            UnloadFileText(accessOrder);
+            return 1;
+        }
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    if (!InitPhysFS()) {
+        UnloadFileText(accessOrder);
+        return 1;
+    }
+
+    // Write the archive next to where it was asked for.
+    const char* output = argv[2];
+    char outputDirectory[1024];
+    snprintf(outputDirectory, sizeof(outputDirectory), "%s", GetDirectoryPath(output));
+    if (outputDirectory[0] == '\0') {
+        snprintf(outputDirectory, sizeof(outputDirectory), ".");
+    }
+
+    bool success = MountPhysFS(argv[1], "") &&
+        SetPhysFSWriteDirectory(outputDirectory) &&
+        ExportPhysFSPackPro("", GetFileName(output), storedExtensions, accessOrder);
+    ClosePhysFS();
+    UnloadFileText(accessOrder);
+
+    if (!success) {
+        printf("Failed to pack '%s' into '%s'\n", argv[1], output);
+        return 1;
+    }
+    printf("Packed '%s' into '%s'\n", argv[1], output);
+    return 0;
+}
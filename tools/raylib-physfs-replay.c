@@ -0,0 +1,210 @@
+/*******************************************************************************************
+*
+*   raylib-physfs-replay - Replays recorded read requests against a set of mounts
+*
+*   Loads the read requests saved with ExportPhysFSIORecording(), mounts the given directories
+*   and archives, and issues the same requests in the same order, to compare archive layouts and
+*   cache settings against the requests a real session made. Requests are issued back to back,
+*   or at the times they were recorded at with --realtime. The latency of each request is printed
+*   with --requests, followed by a summary, each as a line of JSON.
+*
+*   Usage: raylib-physfs-replay <recording> <mount>[=<mount point>]... [--cache <bytes>] [--realtime] [--requests]
+*
+*   This tool has been created using raylib-physfs 0.0.2 (https://github.com/RobLoach/raylib-physfs)
+*   raylib-physfs is licensed under an unmodified zlib/libpng license (View raylib-physfs.h for details)
+*
+*   Copyright (c) 2021 Rob Loach (@RobLoach)
+*
+********************************************************************************************/
+
+#include <stdio.h>
+
+#include "raylib.h"
+
+#define RAYLIB_PHYSFS_IMPLEMENTATION
+#include "raylib-physfs.h"
+
+// Where the recording's directory is mounted while it's loaded.
+#define RECORDING_MOUNT_POINT "raylib-physfs-replay"
+
+/**
+ * Compares two latencies, for sorting them.
+ */
+static int CompareLatencies(const void* a, const void* b) {
+    double first = *(const double*)a;
+    double second = *(const double*)b;
+    return (first > second) - (first < second);
+}
+
+/**
+ * Gets the given percentile of sorted latencies.
+ */
+static double GetPercentile(const double* latencies, int count, double percentile) {
+    return latencies[(int)(percentile / 100.0 * (count - 1) + 0.5)];
+}
+
+/**
+ * Escapes a path for a JSON string, like ExportPhysFSTrace() does.
+ */
+static const char* EscapePath(const char* path, char* output, int size) {
+    int length = 0;
+    for (int i = 0; path[i] != '\0' && length < size - 2; i++) {
+        char c = path[i];
+        if (c == '"' || c == '\\') {
+            output[length++] = '\\';
+        } else if ((unsigned char)c < 0x20) {
+            c = '?';
+        }
+        output[length++] = c;
+    }
+    output[length] = '\0';
+    return output;
+}
+
+/**
+ * Issues a read request, returning how many bytes were read.
+ */
+static long long ReplayRequest(const char* fileName, PhysFSIORequest* request) {
+    // Map views like the recording did, and touch each page so that it's read.
+    if (request->api == PHYSFS_STATS_MAP_FILE_VIEW) {
+        FileView view = MapFileViewFromPhysFS(fileName);
+        volatile unsigned char sum = 0;
+        for (int i = 0; i < view.size; i += 4096) {
+            sum += view.data[i];
+        }
+        long long size = view.size;
+        UnmapFileView(view);
+        return size;
+    }
+
+    // Whole files go through the loader, with its cache.
+    if (request->offset == 0) {
+        int bytesRead = 0;
+        unsigned char* data = LoadFileDataFromPhysFS(fileName, &bytesRead);
+        UnloadFileDataFromPhysFS(data);
+        return bytesRead;
+    }
+
+    PHYSFS_File* file = PHYSFS_openRead(fileName);
+    if (file == 0) {
+        return 0;
+    }
+    long long size = 0;
+    unsigned char* data = (unsigned char*)MemAlloc((unsigned int)request->size + 1);
+    if (data != 0 && PHYSFS_seek(file, (PHYSFS_uint64)request->offset) != 0) {
+        size = PHYSFS_readBytes(file, data, (PHYSFS_uint64)request->size);
+    }
+    MemFree(data);
+    PHYSFS_close(file);
+    return size;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Usage: raylib-physfs-replay <recording> <mount>[=<mount point>]... [--cache <bytes>] [--realtime] [--requests]\n");
+        printf("\n");
+        printf("  <recording>     The read requests saved with ExportPhysFSIORecording()\n");
+        printf("  <mount>         A directory or archive to mount, at the root or the given mount point\n");
+        printf("  --cache <bytes> Cache loaded files with SetPhysFSCacheSize()\n");
+        printf("  --realtime      Issue requests at the times they were recorded at, rather than back to back\n");
+        printf("  --requests      Print the latency of each request\n");
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    if (!InitPhysFS()) {
+        return 1;
+    }
+
+    // Load the recording through its directory.
+    char recordingDirectory[1024];
+    snprintf(recordingDirectory, sizeof(recordingDirectory), "%s", GetDirectoryPath(argv[1]));
+    if (recordingDirectory[0] == '\0') {
+        snprintf(recordingDirectory, sizeof(recordingDirectory), ".");
+    }
+    PhysFSIORecording recording = { 0 };
+    if (MountPhysFS(recordingDirectory, RECORDING_MOUNT_POINT)) {
+        recording = LoadPhysFSIORecording(TextFormat("%s/%s", RECORDING_MOUNT_POINT, GetFileName(argv[1])));
+        UnmountPhysFS(recordingDirectory);
+    }
+    if (recording.requestCount == 0) {
+        printf("Failed to load recorded requests from '%s'\n", argv[1]);
+        UnloadPhysFSIORecording(recording);
+        ClosePhysFS();
+        return 1;
+    }
+
+    bool realtime = false;
+    bool printRequests = false;
+    for (int i = 2; i < argc; i++) {
+        if (TextIsEqual(argv[i], "--cache") && i + 1 < argc) {
+            SetPhysFSCacheSize(atoll(argv[++i]));
+        } else if (TextIsEqual(argv[i], "--realtime")) {
+            realtime = true;
+        } else if (TextIsEqual(argv[i], "--requests")) {
+            printRequests = true;
+        } else {
+            // Mount at the root, or at the mount point after the '='.
+            char mount[1024];
+            snprintf(mount, sizeof(mount), "%s", argv[i]);
+            char* mountPoint = strchr(mount, '=');
+            if (mountPoint != 0) {
+                *mountPoint++ = '\0';
+            }
+            if (!MountPhysFS(mount, mountPoint != 0 ? mountPoint : "")) {
+                printf("Failed to mount '%s'\n", mount);
+                UnloadPhysFSIORecording(recording);
+                ClosePhysFS();
+                return 1;
+            }
+        }
+    }
+
+    double* latencies = (double*)MemAlloc(sizeof(double) * recording.requestCount);
+    long long bytes = 0;
+    int mismatches = 0;
+    double latency = 0.0;
+    double recordedLatency = 0.0;
+    double startTime = GetPhysFSTime();
+    for (int i = 0; i < recording.requestCount; i++) {
+        PhysFSIORequest* request = &recording.requests[i];
+        const char* fileName = recording.paths[request->path];
+        if (realtime) {
+            double wait = startTime + request->time - GetPhysFSTime();
+            if (wait > 0.0) {
+                WaitTime(wait / 1000.0);
+            }
+        }
+
+        double requestTime = GetPhysFSTime();
+        long long size = ReplayRequest(fileName, request);
+        latencies[i] = GetPhysFSTime() - requestTime;
+        bytes += size;
+        latency += latencies[i];
+        recordedLatency += request->milliseconds;
+
+        // Requests that read something other than what was recorded point at a different mount setup.
+        bool mismatch = request->failed ? size > 0 : size != request->size;
+        if (mismatch) {
+            mismatches++;
+        }
+        if (printRequests) {
+            char escapedPath[2048];
+            printf("{\"request\":%i,\"path\":\"%s\",\"offset\":%lld,\"size\":%lld,\"recorded_ms\":%.3f,\"replayed_ms\":%.3f,\"mismatch\":%s}\n",
+                i, EscapePath(fileName, escapedPath, sizeof(escapedPath)), request->offset, size, request->milliseconds, latencies[i], mismatch ? "true" : "false");
+        }
+    }
+    double total = GetPhysFSTime() - startTime;
+
+    qsort(latencies, recording.requestCount, sizeof(double), CompareLatencies);
+    printf("{\"requests\":%i,\"files\":%i,\"bytes\":%lld,\"mismatches\":%i,\"total_ms\":%.3f,\"latency_ms\":%.3f,\"recorded_latency_ms\":%.3f,"
+        "\"p50_ms\":%.3f,\"p90_ms\":%.3f,\"p99_ms\":%.3f,\"max_ms\":%.3f}\n",
+        recording.requestCount, recording.pathCount, bytes, mismatches, total, latency, recordedLatency,
+        GetPercentile(latencies, recording.requestCount, 50.0), GetPercentile(latencies, recording.requestCount, 90.0),
+        GetPercentile(latencies, recording.requestCount, 99.0), latencies[recording.requestCount - 1]);
+
+    MemFree(latencies);
+    UnloadPhysFSIORecording(recording);
+    ClosePhysFS();
+    return mismatches > 0 ? 1 : 0;
+}
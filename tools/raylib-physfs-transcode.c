@@ -0,0 +1,129 @@
+/*******************************************************************************************
+*
+*   raylib-physfs-transcode - Transcodes images into formats that are fast to decode
+*
+*   Walks a directory or archive, and writes every PNG, JPG, BMP and TGA image next to its
+*   path in the output directory as a raw .rimg image, or as a .qoi image with --qoi. The
+*   mapping from the original images to their variants is written to raylib-physfs-images.txt,
+*   which LoadPhysFSImageMap() reads so that LoadImageFromPhysFS("foo.png") loads the variant.
+*
+*   Usage: raylib-physfs-transcode <input> <output> [--qoi]
+*
+*   This tool has been created using raylib-physfs 0.0.2 (https://github.com/RobLoach/raylib-physfs)
+*   raylib-physfs is licensed under an unmodified zlib/libpng license (View raylib-physfs.h for details)
+*
+*   Copyright (c) 2021 Rob Loach (@RobLoach)
+*
+********************************************************************************************/
+
+#include <stdio.h>
+
+#include "raylib.h"
+
+#define RAYLIB_PHYSFS_IMPLEMENTATION
+#include "raylib-physfs.h"
+
+#define IMAGE_MAP_FILE "raylib-physfs-images.txt"
+
+static bool useQoi = false;
+static int imageCount = 0;
+static int failedCount = 0;
+
+/**
+ * Transcodes the given image, and appends it to the image map.
+ */
+static void TranscodeImage(const char* fileName, PHYSFS_File* imageMap) {
+    Image image = LoadImageFromPhysFS(fileName);
+    if (image.data == 0) {
+        TraceLog(LOG_WARNING, "TRANSCODE: Failed to load '%s'", fileName);
+        failedCount++;
+        return;
+    }
+
+    // QOI only holds 8-bit RGB and RGBA pixels.
+    if (useQoi && image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8 && image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    }
+
+    char variant[1024];
+    snprintf(variant, sizeof(variant), "%s%s", fileName, useQoi ? ".qoi" : ".rimg");
+
+    // Create the parent directories in the output.
+    const char* directory = GetDirectoryPath(fileName);
+    if (directory[0] != '\0' && !TextIsEqual(directory, ".") && !TextIsEqual(directory, "/")) {
+        PHYSFS_mkdir(directory);
+    }
+
+    if (!ExportImageToPhysFS(image, variant)) {
+        TraceLog(LOG_WARNING, "TRANSCODE: Failed to write '%s'", variant);
+        UnloadImage(image);
+        failedCount++;
+        return;
+    }
+    UnloadImage(image);
+
+    const char* line = TextFormat("%s %s\n", fileName, variant);
+    PHYSFS_writeBytes(imageMap, line, TextLength(line));
+    TraceLog(LOG_INFO, "TRANSCODE: %s -> %s", fileName, variant);
+    imageCount++;
+}
+
+/**
+ * Transcodes all the images in the given directory, and its subdirectories.
+ */
+static void TranscodeDirectory(const char* dirPath, PHYSFS_File* imageMap) {
+    FilePathList files = LoadDirectoryFilesFromPhysFS(dirPath);
+    for (unsigned int i = 0; i < files.count; i++) {
+        char fileName[1024];
+        if (dirPath[0] == '\0') {
+            snprintf(fileName, sizeof(fileName), "%s", files.paths[i]);
+        } else {
+            snprintf(fileName, sizeof(fileName), "%s/%s", dirPath, files.paths[i]);
+        }
+
+        if (DirectoryExistsInPhysFS(fileName)) {
+            TranscodeDirectory(fileName, imageMap);
+        } else if (IsFileExtension(fileName, ".png;.jpg;.jpeg;.bmp;.tga")) {
+            TranscodeImage(fileName, imageMap);
+        }
+    }
+    UnloadDirectoryFilesFromPhysFS(files);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Usage: raylib-physfs-transcode <input> <output> [--qoi]\n");
+        printf("\n");
+        printf("  <input>   The directory or archive to read images from\n");
+        printf("  <output>  The existing directory to write the transcoded images to\n");
+        printf("  --qoi     Write QOI images, rather than raw .rimg images\n");
+        return 1;
+    }
+    useQoi = argc > 3 && TextIsEqual(argv[3], "--qoi");
+
+    SetTraceLogLevel(LOG_WARNING);
+    if (!InitPhysFS()) {
+        return 1;
+    }
+
+    if (!MountPhysFS(argv[1], "") || !SetPhysFSWriteDirectory(argv[2])) {
+        ClosePhysFS();
+        return 1;
+    }
+
+    PHYSFS_File* imageMap = PHYSFS_openWrite(IMAGE_MAP_FILE);
+    if (imageMap == 0) {
+        TraceLog(LOG_ERROR, "TRANSCODE: Failed to write '%s'", IMAGE_MAP_FILE);
+        ClosePhysFS();
+        return 1;
+    }
+    const char* header = "# Images mapped to their transcoded variants\n";
+    PHYSFS_writeBytes(imageMap, header, TextLength(header));
+
+    TranscodeDirectory("", imageMap);
+    PHYSFS_close(imageMap);
+    ClosePhysFS();
+
+    printf("Transcoded %i images, %i failed\n", imageCount, failedCount);
+    return failedCount > 0 ? 1 : 0;
+}